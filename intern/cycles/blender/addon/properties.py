@@ -828,6 +828,22 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use compact BVH structure (uses less ram but renders slower)",
         default=False,
     )
+    use_bvh_cache: BoolProperty(
+        name="Persistent BVH Cache",
+        description="Store the BVH of geometry on disk, and load it instead of building it again when the "
+                    "same geometry is rendered in other frames or by other render jobs sharing the cache "
+                    "directory. Only used for final renders with the BVH2 acceleration structure, as used "
+                    "by CUDA, HIP and Metal without hardware ray-tracing. All objects are rendered as "
+                    "instances then, which can make rendering slightly slower",
+        default=False,
+    )
+    bvh_cache_directory: StringProperty(
+        name="Cache Directory",
+        description="Directory to store the BVH cache in, the user cache directory is used when empty. "
+                    "Entries are never removed automatically",
+        subtype='DIR_PATH',
+        default="",
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -967,6 +983,22 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=8, max=8192,
     )
 
+    use_texture_cache: BoolProperty(
+        name="Texture Cache",
+        description="Read image textures from disk while rendering, only loading the parts and "
+                    "resolutions that are needed, instead of loading them fully before rendering. "
+                    "Mipmapped and tiled images, such as .tx files, are read most efficiently. Only "
+                    "supported for CPU rendering with SVM. Images larger than the texture limit are "
+                    "loaded fully, scaled down to the limit",
+        default=False,
+    )
+    texture_cache_size: IntProperty(
+        name="Cache Size",
+        description="Maximum memory used by the texture cache, in megabytes",
+        default=4096,
+        min=64, soft_max=65536,
+    )
+
     # Various fine-tuning debug flags
 
     def _devices_update_callback(self, context):
@@ -974,6 +1006,7 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         scene = context.scene.as_pointer()
         return _cycles.debug_flags_update(scene)
 
+    debug_use_cpu_avx512: BoolProperty(name="AVX-512", default=True)
     debug_use_cpu_avx2: BoolProperty(name="AVX2", default=True)
     debug_use_cpu_sse41: BoolProperty(name="SSE41", default=True)
     debug_use_cpu_sse2: BoolProperty(name="SSE2", default=True)
@@ -982,6 +1015,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Render batches of paths one kernel at a time instead of one path at a time",
+        default=False,
+    )
 
     debug_use_cuda_adaptive_compile: BoolProperty(name="Adaptive Compile", default=False)
 
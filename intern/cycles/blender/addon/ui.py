@@ -126,6 +126,27 @@ def use_oneapi(context):
     return (get_device_type(context) == 'ONEAPI' and cscene.device == 'GPU')
 
 
+def use_bvh2(context):
+    # The BVH layout built by Cycles itself, as opposed to the ones of ray-tracing libraries.
+    import _cycles
+
+    if use_multi_device(context):
+        return False
+    if use_cpu(context):
+        return not _cycles.with_embree
+    if use_optix(context):
+        return False
+
+    prefs = context.preferences.addons[__package__].preferences
+    if use_metal(context):
+        return not prefs.use_metalrt
+    if use_hip(context):
+        return not prefs.use_hiprt
+    if use_oneapi(context):
+        return not (prefs.use_oneapirt and _cycles.with_embree_gpu)
+    return True
+
+
 def use_multi_device(context):
     cscene = context.scene.cycles
     if cscene.device != 'GPU':
@@ -782,6 +803,13 @@ class CYCLES_RENDER_PT_performance_memory(CyclesButtonsPanel, Panel):
         sub.active = cscene.use_auto_tile
         sub.prop(cscene, "tile_size")
 
+        col = layout.column()
+        col.active = use_cpu(context)
+        col.prop(cscene, "use_texture_cache")
+        sub = col.column()
+        sub.active = cscene.use_texture_cache
+        sub.prop(cscene, "texture_cache_size")
+
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
     bl_label = "Acceleration Structure"
@@ -807,9 +835,8 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
 
         if use_cpu(context):
             col.prop(cscene, "debug_use_spatial_splits")
-            if use_embree:
-                col.prop(cscene, "debug_use_compact_bvh")
-            else:
+            col.prop(cscene, "debug_use_compact_bvh")
+            if not use_embree:
                 sub = col.column()
                 sub.active = not cscene.debug_use_spatial_splits
                 sub.prop(cscene, "debug_bvh_time_steps")
@@ -827,9 +854,15 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
 
             col.prop(cscene, "debug_use_hair_bvh")
 
-            # CPU is used in addition to a GPU
-            if use_multi_device(context) and use_embree:
-                col.prop(cscene, "debug_use_compact_bvh")
+            col.prop(cscene, "debug_use_compact_bvh")
+
+        col = layout.column()
+        # Only the BVH2 layout can be cached.
+        col.active = use_bvh2(context)
+        col.prop(cscene, "use_bvh_cache")
+        sub = col.column()
+        sub.active = cscene.use_bvh_cache
+        sub.prop(cscene, "bvh_cache_directory", text="Directory")
 
 
 class CYCLES_RENDER_PT_performance_final_render(CyclesButtonsPanel, Panel):
@@ -2206,7 +2239,9 @@ class CYCLES_RENDER_PT_debug(CyclesDebugButtonsPanel, Panel):
         row.prop(cscene, "debug_use_cpu_sse2", toggle=True)
         row.prop(cscene, "debug_use_cpu_sse41", toggle=True)
         row.prop(cscene, "debug_use_cpu_avx2", toggle=True)
+        row.prop(cscene, "debug_use_cpu_avx512", toggle=True)
         col.prop(cscene, "debug_bvh_layout", text="BVH")
+        col.prop(cscene, "debug_use_cpu_wavefront")
 
         col.separator()
 
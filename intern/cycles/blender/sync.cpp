@@ -28,6 +28,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/openimagedenoise.h"
+#include "util/path.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -785,7 +786,8 @@ void BlenderSync::free_data_after_sync(BL::Depsgraph &b_depsgraph)
 
 /* Scene Parameters */
 
-SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
+SceneParams BlenderSync::get_scene_params(BL::BlendData &b_data,
+                                          BL::Scene &b_scene,
                                           const bool background,
                                           const bool use_developer_ui)
 {
@@ -805,6 +807,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
 
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
+  params.use_bvh_quantized_nodes = params.use_bvh_compact_structure;
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
@@ -827,6 +830,20 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
     params.texture_limit = 0;
   }
 
+  if (RNA_boolean_get(&cscene, "use_texture_cache")) {
+    params.texture_cache_size = RNA_int_get(&cscene, "texture_cache_size");
+  }
+  else {
+    params.texture_cache_size = 0;
+  }
+
+  if (background && RNA_boolean_get(&cscene, "use_bvh_cache")) {
+    const string directory = get_string(cscene, "bvh_cache_directory");
+    params.bvh_cache_directory = directory.empty() ?
+                                     path_cache_get("bvh") :
+                                     blender_absolute_path(b_data, b_scene, directory);
+  }
+
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
   params.background = background;
@@ -33,8 +33,9 @@ class Stats;
  * BVH stored as it will be used for traversal on the rendering device. */
 
 struct PackedBVH {
-  /* BVH nodes storage, one node is 4x int4, and contains two bounding boxes,
-   * and child, triangle or object indexes depending on the node type */
+  /* BVH nodes storage, one node is 4x int4 (3x int4 when quantized, 7x int4 when unaligned), and
+   * contains two bounding boxes, and child, triangle or object indexes depending on the node
+   * type. The first int4 of every node holds the node type flags. */
   array<int4> nodes;
   /* BVH leaf nodes storage. */
   array<int4> leaf_nodes;
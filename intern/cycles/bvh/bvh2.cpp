@@ -23,6 +23,100 @@ CCL_NAMESPACE_BEGIN
 
 BVHStackEntry::BVHStackEntry(const BVHNode *n, int i) : node(n), idx(i) {}
 
+/* Quantized Nodes
+ *
+ * Child bounds are stored as 8 bit offsets from the lower corner of the node bounds. The step
+ * size of every axis is a power of two, stored as a biased float exponent, so the kernel decodes
+ * the bounds exactly as they are computed here. Lower bounds are rounded down and upper bounds
+ * up, the decoded boxes always contain the original ones. */
+
+static uint bvh_quantize_exponent(const float lower, const float upper)
+{
+  int exponent;
+  frexpf((upper - lower) / 255.0f, &exponent);
+  /* Rounding of the extent might leave the upper bound just out of reach. */
+  while (exponent < 127 && lower + 255.0f * ldexpf(1.0f, exponent) < upper) {
+    exponent++;
+  }
+  return clamp(exponent + 127, 1, 254);
+}
+
+static uint bvh_quantize_bound(const float value,
+                               const float origin,
+                               const float scale,
+                               const bool is_upper)
+{
+  const float offset = (value - origin) / scale;
+  int q = int(clamp(is_upper ? ceilf(offset) : floorf(offset), 0.0f, 255.0f));
+  if (is_upper) {
+    while (q < 255 && origin + float(q) * scale < value) {
+      q++;
+    }
+  }
+  else {
+    while (q > 0 && origin + float(q) * scale > value) {
+      q--;
+    }
+  }
+  return q;
+}
+
+/* Children with infinite bounds are clamped to the largest finite box, which still contains every
+ * point a ray can hit. Children without bounds, which includes NaN, are collapsed to the node
+ * origin. */
+static bool bvh_quantize_child_bounds(const BoundBox &b, BoundBox &r_bounds)
+{
+  if (!(b.min.x <= b.max.x && b.min.y <= b.max.y && b.min.z <= b.max.z)) {
+    return false;
+  }
+  r_bounds.min = clamp(b.min, make_float3(-FLT_MAX), make_float3(FLT_MAX));
+  r_bounds.max = clamp(b.max, make_float3(-FLT_MAX), make_float3(FLT_MAX));
+  return true;
+}
+
+void bvh_quantized_node_encode(const BoundBox &b0, const BoundBox &b1, int4 data[2])
+{
+  BoundBox child_bounds[2];
+  const bool has_bounds[2] = {bvh_quantize_child_bounds(b0, child_bounds[0]),
+                              bvh_quantize_child_bounds(b1, child_bounds[1])};
+
+  BoundBox bounds = BoundBox::empty;
+  for (int i = 0; i < 2; i++) {
+    if (has_bounds[i]) {
+      bounds.grow(child_bounds[i]);
+    }
+  }
+  if (!has_bounds[0] && !has_bounds[1]) {
+    bounds = BoundBox(zero_float3());
+  }
+
+  uint exponents = 0;
+  uint quantized[3];
+  for (int axis = 0; axis < 3; axis++) {
+    const float origin = bounds.min[axis];
+    const uint exponent = bvh_quantize_exponent(origin, bounds.max[axis]);
+    const float scale = __uint_as_float(exponent << 23);
+
+    /* Lower and upper bounds of both children, same order as the rows of aligned nodes. */
+    uint q[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 2; i++) {
+      if (has_bounds[i]) {
+        q[i] = bvh_quantize_bound(child_bounds[i].min[axis], origin, scale, false);
+        q[i + 2] = bvh_quantize_bound(child_bounds[i].max[axis], origin, scale, true);
+      }
+    }
+
+    exponents |= exponent << (axis * 8);
+    quantized[axis] = q[0] | (q[1] << 8) | (q[2] << 16) | (q[3] << 24);
+  }
+
+  data[0] = make_int4(__float_as_int(bounds.min.x),
+                      __float_as_int(bounds.min.y),
+                      __float_as_int(bounds.min.z),
+                      int(exponents));
+  data[1] = make_int4(int(quantized[0]), int(quantized[1]), int(quantized[2]), 0);
+}
+
 int BVHStackEntry::encodeIdx() const
 {
   return (node->is_leaf()) ? ~idx : idx;
@@ -141,6 +235,17 @@ void BVH2::pack_aligned_inner(const BVHStackEntry &e,
                               const BVHStackEntry &e0,
                               const BVHStackEntry &e1)
 {
+  if (params.use_quantized_nodes) {
+    pack_quantized_node(e.idx,
+                        e0.node->bounds,
+                        e1.node->bounds,
+                        e0.encodeIdx(),
+                        e1.encodeIdx(),
+                        e0.node->visibility,
+                        e1.node->visibility);
+    return;
+  }
+
   pack_aligned_node(e.idx,
                     e0.node->bounds,
                     e1.node->bounds,
@@ -162,9 +267,9 @@ void BVH2::pack_aligned_node(int idx,
   assert(c0 < 0 || c0 < pack.nodes.size());
   assert(c1 < 0 || c1 < pack.nodes.size());
 
+  const uint node_flags = PATH_RAY_NODE_UNALIGNED | PATH_RAY_NODE_QUANTIZED;
   int4 data[BVH_NODE_SIZE] = {
-      make_int4(
-          visibility0 & ~PATH_RAY_NODE_UNALIGNED, visibility1 & ~PATH_RAY_NODE_UNALIGNED, c0, c1),
+      make_int4(visibility0 & ~node_flags, visibility1 & ~node_flags, c0, c1),
       make_int4(__float_as_int(b0.min.x),
                 __float_as_int(b1.min.x),
                 __float_as_int(b0.max.x),
@@ -182,6 +287,28 @@ void BVH2::pack_aligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_NODE_SIZE);
 }
 
+void BVH2::pack_quantized_node(int idx,
+                               const BoundBox &b0,
+                               const BoundBox &b1,
+                               int c0,
+                               int c1,
+                               uint visibility0,
+                               uint visibility1)
+{
+  assert(idx + BVH_QUANTIZED_NODE_SIZE <= pack.nodes.size());
+  assert(c0 < 0 || c0 < pack.nodes.size());
+  assert(c1 < 0 || c1 < pack.nodes.size());
+
+  int4 data[BVH_QUANTIZED_NODE_SIZE];
+  data[0] = make_int4((visibility0 & ~PATH_RAY_NODE_UNALIGNED) | PATH_RAY_NODE_QUANTIZED,
+                      (visibility1 & ~PATH_RAY_NODE_UNALIGNED) | PATH_RAY_NODE_QUANTIZED,
+                      c0,
+                      c1);
+  bvh_quantized_node_encode(b0, b1, data + 1);
+
+  memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_QUANTIZED_NODE_SIZE);
+}
+
 void BVH2::pack_unaligned_inner(const BVHStackEntry &e,
                                 const BVHStackEntry &e0,
                                 const BVHStackEntry &e1)
@@ -229,20 +356,30 @@ void BVH2::pack_unaligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(float4) * BVH_UNALIGNED_NODE_SIZE);
 }
 
+int BVH2::inner_node_size(const BVHNode *node) const
+{
+  if (node->has_unaligned()) {
+    return BVH_UNALIGNED_NODE_SIZE;
+  }
+  return (params.use_quantized_nodes) ? BVH_QUANTIZED_NODE_SIZE : BVH_NODE_SIZE;
+}
+
 void BVH2::pack_nodes(const BVHNode *root)
 {
   const size_t num_nodes = root->getSubtreeSize(BVH_STAT_NODE_COUNT);
   const size_t num_leaf_nodes = root->getSubtreeSize(BVH_STAT_LEAF_COUNT);
   assert(num_leaf_nodes <= num_nodes);
   const size_t num_inner_nodes = num_nodes - num_leaf_nodes;
+  const size_t aligned_node_size = (params.use_quantized_nodes) ? BVH_QUANTIZED_NODE_SIZE :
+                                                                  BVH_NODE_SIZE;
   size_t node_size;
   if (params.use_unaligned_nodes) {
     const size_t num_unaligned_nodes = root->getSubtreeSize(BVH_STAT_UNALIGNED_INNER_COUNT);
     node_size = (num_unaligned_nodes * BVH_UNALIGNED_NODE_SIZE) +
-                (num_inner_nodes - num_unaligned_nodes) * BVH_NODE_SIZE;
+                (num_inner_nodes - num_unaligned_nodes) * aligned_node_size;
   }
   else {
-    node_size = num_inner_nodes * BVH_NODE_SIZE;
+    node_size = num_inner_nodes * aligned_node_size;
   }
   /* Resize arrays */
   pack.nodes.clear();
@@ -265,7 +402,7 @@ void BVH2::pack_nodes(const BVHNode *root)
   }
   else {
     stack.push_back(BVHStackEntry(root, nextNodeIdx));
-    nextNodeIdx += root->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE : BVH_NODE_SIZE;
+    nextNodeIdx += inner_node_size(root);
   }
 
   while (stack.size()) {
@@ -286,8 +423,7 @@ void BVH2::pack_nodes(const BVHNode *root)
         }
         else {
           idx[i] = nextNodeIdx;
-          nextNodeIdx += e.node->get_child(i)->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE :
-                                                                 BVH_NODE_SIZE;
+          nextNodeIdx += inner_node_size(e.node->get_child(i));
         }
       }
 
@@ -331,10 +467,11 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     memcpy(&pack.leaf_nodes[idx], leaf_data, sizeof(float4) * BVH_NODE_LEAF_SIZE);
   }
   else {
-    assert(idx + BVH_NODE_SIZE <= pack.nodes.size());
+    assert(idx + BVH_QUANTIZED_NODE_SIZE <= pack.nodes.size());
 
     const int4 *data = &pack.nodes[idx];
     const bool is_unaligned = (data[0].x & PATH_RAY_NODE_UNALIGNED) != 0;
+    const bool is_quantized = (data[0].x & PATH_RAY_NODE_QUANTIZED) != 0;
     const int c0 = data[0].z;
     const int c1 = data[0].w;
     /* refit inner node, set bbox from children */
@@ -349,6 +486,9 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
       pack_unaligned_node(
           idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
+    else if (is_quantized) {
+      pack_quantized_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+    }
     else {
       pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
@@ -616,6 +756,10 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
           nsize = BVH_UNALIGNED_NODE_SIZE;
           nsize_bbox = 0;
         }
+        else if (bvh_nodes[i].x & PATH_RAY_NODE_QUANTIZED) {
+          nsize = BVH_QUANTIZED_NODE_SIZE;
+          nsize_bbox = 0;
+        }
         else {
           nsize = BVH_NODE_SIZE;
           nsize_bbox = 0;
@@ -19,6 +19,7 @@ CCL_NAMESPACE_BEGIN
 #define BVH_NODE_SIZE 4
 #define BVH_NODE_LEAF_SIZE 1
 #define BVH_UNALIGNED_NODE_SIZE 7
+#define BVH_QUANTIZED_NODE_SIZE 3
 
 /* Pack Utility */
 struct BVHStackEntry {
@@ -29,6 +30,11 @@ struct BVHStackEntry {
   int encodeIdx() const;
 };
 
+/* Encode the bounds of the two children of an aligned inner node into the last two rows of a
+ * quantized node, decoded by the kernel with bvh_quantized_node_decode_bounds(). The decoded
+ * bounds always contain the original ones. */
+void bvh_quantized_node_encode(const BoundBox &b0, const BoundBox &b1, int4 data[2]);
+
 /* BVH2
  *
  * Typical BVH with each node having two children.
@@ -52,6 +58,7 @@ class BVH2 : public BVH {
 
   /* pack */
   void pack_nodes(const BVHNode *root);
+  int inner_node_size(const BVHNode *node) const;
 
   void pack_leaf(const BVHStackEntry &e, const LeafNode *leaf);
   void pack_inner(const BVHStackEntry &e, const BVHStackEntry &e0, const BVHStackEntry &e1);
@@ -67,6 +74,14 @@ class BVH2 : public BVH {
                          uint visibility0,
                          uint visibility1);
 
+  void pack_quantized_node(int idx,
+                           const BoundBox &b0,
+                           const BoundBox &b1,
+                           int c0,
+                           int c1,
+                           uint visibility0,
+                           uint visibility1);
+
   void pack_unaligned_inner(const BVHStackEntry &e,
                             const BVHStackEntry &e0,
                             const BVHStackEntry &e1);
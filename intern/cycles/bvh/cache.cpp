@@ -0,0 +1,264 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "bvh/cache.h"
+
+#include <atomic>
+#include <cstdio>
+
+#include "bvh/bvh.h"
+#include "bvh/params.h"
+
+#include "scene/attribute.h"
+#include "scene/hair.h"
+#include "scene/mesh.h"
+#include "scene/pointcloud.h"
+
+#include "util/log.h"
+#include "util/md5.h"
+#include "util/path.h"
+#include "util/time.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Increase whenever the packed BVH2 layout or the BVH builder changes, to not use entries which
+ * were written by older versions. */
+static const uint32_t BVH_CACHE_VERSION = 1;
+static const char BVH_CACHE_MAGIC[4] = {'C', 'B', 'V', 'H'};
+
+/* Hashing. */
+
+static void bvh_cache_hash_data(MD5Hash &md5, const void *data, const size_t size)
+{
+  /* MD5Hash only takes sizes which fit into an int. */
+  const size_t max_chunk_size = 1 << 30;
+  const uint8_t *bytes = (const uint8_t *)data;
+  for (size_t offset = 0; offset < size; offset += max_chunk_size) {
+    md5.append(bytes + offset, (int)min(size - offset, max_chunk_size));
+  }
+}
+
+template<typename T> static void bvh_cache_hash_value(MD5Hash &md5, const T value)
+{
+  bvh_cache_hash_data(md5, &value, sizeof(value));
+}
+
+template<typename T> static void bvh_cache_hash_array(MD5Hash &md5, const array<T> &a)
+{
+  bvh_cache_hash_value(md5, (uint64_t)a.size());
+  bvh_cache_hash_data(md5, a.data(), a.size() * sizeof(T));
+}
+
+static void bvh_cache_hash_float3(MD5Hash &md5, const float3 *data, const size_t size)
+{
+  /* Leave out the padding of the SIMD aligned type, it is not always initialized. */
+  const size_t chunk_size = 256;
+  float buffer[chunk_size * 3];
+
+  bvh_cache_hash_value(md5, (uint64_t)size);
+  for (size_t offset = 0; offset < size; offset += chunk_size) {
+    const size_t num = min(size - offset, chunk_size);
+    for (size_t i = 0; i < num; i++) {
+      buffer[i * 3 + 0] = data[offset + i].x;
+      buffer[i * 3 + 1] = data[offset + i].y;
+      buffer[i * 3 + 2] = data[offset + i].z;
+    }
+    bvh_cache_hash_data(md5, buffer, num * 3 * sizeof(float));
+  }
+}
+
+static void bvh_cache_hash_params(MD5Hash &md5, const BVHParams &params)
+{
+  bvh_cache_hash_value(md5, (int)params.bvh_layout);
+  bvh_cache_hash_value(md5, params.top_level);
+  bvh_cache_hash_value(md5, params.use_spatial_split);
+  bvh_cache_hash_value(md5, params.spatial_split_alpha);
+  bvh_cache_hash_value(md5, params.use_unaligned_nodes);
+  bvh_cache_hash_value(md5, params.unaligned_split_threshold);
+  bvh_cache_hash_value(md5, params.use_compact_structure);
+  bvh_cache_hash_value(md5, params.use_quantized_nodes);
+  bvh_cache_hash_value(md5, params.sah_node_cost);
+  bvh_cache_hash_value(md5, params.sah_primitive_cost);
+  bvh_cache_hash_value(md5, params.min_leaf_size);
+  bvh_cache_hash_value(md5, params.max_triangle_leaf_size);
+  bvh_cache_hash_value(md5, params.max_motion_triangle_leaf_size);
+  bvh_cache_hash_value(md5, params.max_curve_leaf_size);
+  bvh_cache_hash_value(md5, params.max_motion_curve_leaf_size);
+  bvh_cache_hash_value(md5, params.max_point_leaf_size);
+  bvh_cache_hash_value(md5, params.max_motion_point_leaf_size);
+  bvh_cache_hash_value(md5, params.num_motion_triangle_steps);
+  bvh_cache_hash_value(md5, params.num_motion_curve_steps);
+  bvh_cache_hash_value(md5, params.num_motion_point_steps);
+  bvh_cache_hash_value(md5, params.curve_subdivisions);
+}
+
+string bvh_cache_key(const BVHParams &params, const Geometry *geom)
+{
+  MD5Hash md5;
+
+  bvh_cache_hash_value(md5, BVH_CACHE_VERSION);
+  bvh_cache_hash_params(md5, params);
+
+  /* Only the data which is used by the BVH builder, shading related data does not matter. */
+  bvh_cache_hash_value(md5, (int)geom->geometry_type);
+  bvh_cache_hash_value(md5, (int)geom->primitive_type());
+  bvh_cache_hash_value(md5, geom->has_motion_blur());
+  bvh_cache_hash_value(md5, geom->get_motion_steps());
+
+  if (geom->is_mesh() || geom->is_volume()) {
+    const Mesh *mesh = static_cast<const Mesh *>(geom);
+    bvh_cache_hash_float3(md5, mesh->get_verts().data(), mesh->get_verts().size());
+    bvh_cache_hash_array(md5, mesh->get_triangles());
+  }
+  else if (geom->is_hair()) {
+    const Hair *hair = static_cast<const Hair *>(geom);
+    bvh_cache_hash_float3(md5, hair->get_curve_keys().data(), hair->get_curve_keys().size());
+    bvh_cache_hash_array(md5, hair->get_curve_radius());
+    bvh_cache_hash_array(md5, hair->get_curve_first_key());
+  }
+  else if (geom->is_pointcloud()) {
+    const PointCloud *pointcloud = static_cast<const PointCloud *>(geom);
+    bvh_cache_hash_float3(md5, pointcloud->get_points().data(), pointcloud->get_points().size());
+    bvh_cache_hash_array(md5, pointcloud->get_radius());
+  }
+
+  if (geom->has_motion_blur()) {
+    const Attribute *attr = geom->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+    if (attr) {
+      if (attr->data_sizeof() == sizeof(float3)) {
+        bvh_cache_hash_float3(md5, attr->data_float3(), attr->buffer.size() / sizeof(float3));
+      }
+      else {
+        bvh_cache_hash_value(md5, (uint64_t)attr->buffer.size());
+        bvh_cache_hash_data(md5, attr->buffer.data(), attr->buffer.size());
+      }
+    }
+  }
+
+  return md5.get_hex();
+}
+
+/* File storage. */
+
+static string bvh_cache_filepath(const string &directory, const string &key)
+{
+  return path_join(directory, key + ".bvh");
+}
+
+template<typename T> static bool bvh_cache_write_array(FILE *f, const array<T> &a)
+{
+  const uint64_t size = a.size();
+  if (fwrite(&size, sizeof(size), 1, f) != 1) {
+    return false;
+  }
+  return size == 0 || fwrite(a.data(), sizeof(T), size, f) == size;
+}
+
+template<typename T>
+static bool bvh_cache_read_array(FILE *f, const size_t file_size, array<T> &a)
+{
+  /* Check the size against the file size, to not allocate huge arrays for broken files. */
+  uint64_t size;
+  if (fread(&size, sizeof(size), 1, f) != 1 || size > file_size / sizeof(T)) {
+    return false;
+  }
+  a.resize(size);
+  return size == 0 || fread(a.data(), sizeof(T), size, f) == size;
+}
+
+bool bvh_cache_read(const string &directory, const string &key, PackedBVH &pack)
+{
+  const string filepath = bvh_cache_filepath(directory, key);
+
+  FILE *f = path_fopen(filepath, "rb");
+  if (!f) {
+    return false;
+  }
+
+  const size_t file_size = path_file_size(filepath);
+
+  char magic[sizeof(BVH_CACHE_MAGIC)];
+  uint32_t version;
+  int root_index;
+
+  bool ok = fread(magic, sizeof(magic), 1, f) == 1 &&
+            memcmp(magic, BVH_CACHE_MAGIC, sizeof(magic)) == 0 &&
+            fread(&version, sizeof(version), 1, f) == 1 && version == BVH_CACHE_VERSION &&
+            fread(&root_index, sizeof(root_index), 1, f) == 1 &&
+            bvh_cache_read_array(f, file_size, pack.nodes) &&
+            bvh_cache_read_array(f, file_size, pack.leaf_nodes) &&
+            bvh_cache_read_array(f, file_size, pack.object_node) &&
+            bvh_cache_read_array(f, file_size, pack.prim_type) &&
+            bvh_cache_read_array(f, file_size, pack.prim_visibility) &&
+            bvh_cache_read_array(f, file_size, pack.prim_index) &&
+            bvh_cache_read_array(f, file_size, pack.prim_object) &&
+            bvh_cache_read_array(f, file_size, pack.prim_time);
+
+  /* Entries are written completely before they are renamed into place, anything else is a
+   * broken file which is better rebuilt. */
+  if (ok && fgetc(f) != EOF) {
+    ok = false;
+  }
+
+  fclose(f);
+
+  if (!ok) {
+    VLOG_WARNING << "Ignoring invalid BVH cache entry " << filepath;
+    pack = PackedBVH();
+    return false;
+  }
+
+  pack.root_index = root_index;
+
+  VLOG_INFO << "Loaded BVH from cache " << filepath;
+  return true;
+}
+
+void bvh_cache_write(const string &directory, const string &key, const PackedBVH &pack)
+{
+  const string filepath = bvh_cache_filepath(directory, key);
+  path_create_directories(filepath);
+
+  /* Unique among the threads and processes which may write the same entry at the same time. */
+  static std::atomic<uint> temp_counter = 0;
+  const string temp_id = util_md5_string(
+      string_printf("%p %f %u", (const void *)&pack, time_dt(), temp_counter++));
+  const string temp_filepath = filepath + "." + temp_id + ".tmp";
+
+  FILE *f = path_fopen(temp_filepath, "wb");
+  if (!f) {
+    VLOG_WARNING << "Failed to create BVH cache entry " << temp_filepath;
+    return;
+  }
+
+  const uint32_t version = BVH_CACHE_VERSION;
+  const int root_index = pack.root_index;
+
+  bool ok = fwrite(BVH_CACHE_MAGIC, sizeof(BVH_CACHE_MAGIC), 1, f) == 1 &&
+            fwrite(&version, sizeof(version), 1, f) == 1 &&
+            fwrite(&root_index, sizeof(root_index), 1, f) == 1 &&
+            bvh_cache_write_array(f, pack.nodes) && bvh_cache_write_array(f, pack.leaf_nodes) &&
+            bvh_cache_write_array(f, pack.object_node) &&
+            bvh_cache_write_array(f, pack.prim_type) &&
+            bvh_cache_write_array(f, pack.prim_visibility) &&
+            bvh_cache_write_array(f, pack.prim_index) &&
+            bvh_cache_write_array(f, pack.prim_object) &&
+            bvh_cache_write_array(f, pack.prim_time);
+
+  ok = (fclose(f) == 0) && ok;
+
+  /* Renaming is atomic, so readers either see no entry or a complete one. When another process
+   * wrote the same entry in the meantime renaming may fail on some platforms, which is fine. */
+  if (!ok || rename(temp_filepath.c_str(), filepath.c_str()) != 0) {
+    if (!ok) {
+      VLOG_WARNING << "Failed to write BVH cache entry " << temp_filepath;
+    }
+    path_remove(temp_filepath);
+    return;
+  }
+
+  VLOG_INFO << "Stored BVH in cache " << filepath;
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,37 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#ifndef __BVH_CACHE_H__
+#define __BVH_CACHE_H__
+
+#include "util/string.h"
+
+CCL_NAMESPACE_BEGIN
+
+class BVHParams;
+class Geometry;
+struct PackedBVH;
+
+/* Persistent on-disk cache of BVH2 builds of single geometry.
+ *
+ * The BVH of a geometry only depends on its primitives and the build parameters, so cache entries
+ * are identified by a hash of those. Renders of other frames, or other render jobs sharing the
+ * cache directory, load the BVH of geometry which did not change instead of building it again.
+ *
+ * Entries are written to a temporary file which is then renamed, so that multiple processes can
+ * use the same directory concurrently. Old entries are never removed. */
+
+/* Compute the key of the BVH of the geometry built with the given parameters. */
+string bvh_cache_key(const BVHParams &params, const Geometry *geom);
+
+/* Read the packed BVH of the key from the cache directory, returns false if there is no valid
+ * entry for it. */
+bool bvh_cache_read(const string &directory, const string &key, PackedBVH &pack);
+
+/* Write the packed BVH to the cache directory. Failures are only logged, the cache is optional. */
+void bvh_cache_write(const string &directory, const string &key, const PackedBVH &pack);
+
+CCL_NAMESPACE_END
+
+#endif /* __BVH_CACHE_H__ */
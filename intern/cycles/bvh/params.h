@@ -88,9 +88,15 @@ class BVHParams {
    */
   bool use_unaligned_nodes;
 
-  /* Use compact acceleration structure (Embree)*/
+  /* Use compact acceleration structure. Only used for Embree, where it selects its compact build
+   * quality. */
   bool use_compact_structure;
 
+  /* Quantize the child bounds of aligned inner nodes to 8 bits.
+   * Only used for BVH2.
+   */
+  bool use_quantized_nodes;
+
   /* Split time range to this number of steps and create leaf node for each
    * of this time steps.
    *
@@ -134,6 +140,7 @@ class BVHParams {
     top_level = false;
     bvh_layout = BVH_LAYOUT_BVH2;
     use_compact_structure = false;
+    use_quantized_nodes = false;
     use_unaligned_nodes = false;
 
     num_motion_curve_steps = 0;
@@ -247,7 +247,10 @@ void CPUDevice::tex_alloc(device_texture &mem)
   }
 
   texture_info[slot] = mem.info;
-  texture_info[slot].data = (uint64_t)mem.host_pointer;
+  if (!mem.info.use_texture_cache) {
+    /* Images read through the texture cache point to their cache entry instead. */
+    texture_info[slot].data = (uint64_t)mem.host_pointer;
+  }
   need_texture_info = true;
 }
 
@@ -10,7 +10,8 @@ CCL_NAMESPACE_BEGIN
 
 #define KERNEL_FUNCTIONS(name) \
   KERNEL_NAME_EVAL(cpu, name), KERNEL_NAME_EVAL(cpu_sse2, name), \
-      KERNEL_NAME_EVAL(cpu_sse41, name), KERNEL_NAME_EVAL(cpu_avx2, name)
+      KERNEL_NAME_EVAL(cpu_sse41, name), KERNEL_NAME_EVAL(cpu_avx2, name), \
+      KERNEL_NAME_EVAL(cpu_avx512, name)
 
 #define REGISTER_KERNEL(name) name(KERNEL_FUNCTIONS(name))
 #define REGISTER_KERNEL_FILM_CONVERT(name) \
@@ -33,6 +34,7 @@ CPUKernels::CPUKernels()
       REGISTER_KERNEL(integrator_shade_volume),
       REGISTER_KERNEL(integrator_shade_dedicated_light),
       REGISTER_KERNEL(integrator_megakernel),
+      REGISTER_KERNEL(integrator_megakernel_step),
       /* Shader evaluation. */
       REGISTER_KERNEL(shader_eval_displace),
       REGISTER_KERNEL(shader_eval_background),
@@ -16,7 +16,9 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/algorithm.h"
 #include "util/atomic.h"
+#include "util/debug.h"
 #include "util/log.h"
 #include "util/tbb.h"
 
@@ -42,6 +44,34 @@ static inline CPUKernelThreadGlobals *kernel_thread_globals_get(
   return &kernel_thread_globals[thread_index];
 }
 
+/* Number of paths every thread keeps in flight in the wavefront mode. The CPU integrator state
+ * embeds the shadow intersection arrays, so it is much larger than a GPU path state and only a
+ * small batch fits in the caches. */
+static constexpr int wavefront_paths_num = 64;
+
+/* Number of pixels a thread renders at once in the wavefront mode. All samples of these pixels
+ * are rendered before the next chunk, so this is enough to fill the batch with a single sample. */
+static constexpr int64_t wavefront_chunk_pixels = wavefront_paths_num;
+
+/* Kernel which the next megakernel step executes for the state, zero when the path is done. */
+static inline uint32_t wavefront_state_queued_kernel(const IntegratorStateCPU *state)
+{
+  if (state->shadow.shadow_path.queued_kernel) {
+    return state->shadow.shadow_path.queued_kernel;
+  }
+  if (state->ao.shadow_path.queued_kernel) {
+    return state->ao.shadow_path.queued_kernel;
+  }
+  return state->path.queued_kernel;
+}
+
+static inline bool wavefront_kernel_uses_sorting(const uint32_t kernel)
+{
+  return (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE ||
+          kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE ||
+          kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE);
+}
+
 PathTraceWorkCPU::PathTraceWorkCPU(Device *device,
                                    Film *film,
                                    DeviceScene *device_scene,
@@ -73,32 +103,74 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  bool use_wavefront = DebugFlags().cpu.use_wavefront;
+#ifdef WITH_PATH_GUIDING
+  /* Training data is collected per path at the end of its sample, which is only supported by the
+   * megakernel loop. */
+  if (kernel_thread_globals_[0].data.integrator.train_guiding) {
+    use_wavefront = false;
+  }
+#endif
+
+  KernelWorkTile work_tile_template;
+  work_tile_template.w = 1;
+  work_tile_template.h = 1;
+  work_tile_template.start_sample = start_sample;
+  work_tile_template.sample_offset = sample_offset;
+  work_tile_template.num_samples = 1;
+  work_tile_template.offset = effective_buffer_params_.offset;
+  work_tile_template.stride = effective_buffer_params_.stride;
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
-  local_arena.execute([&]() {
-    parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
-      if (is_cancel_requested()) {
-        return;
-      }
+  if (use_wavefront) {
+    wavefront_states_.resize(kernel_thread_globals_.size());
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
+    const int64_t chunks_num = (total_pixels_num + wavefront_chunk_pixels - 1) /
+                               wavefront_chunk_pixels;
+    local_arena.execute([&]() {
+      parallel_for(int64_t(0), chunks_num, [&](int64_t chunk_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
 
-      KernelWorkTile work_tile;
-      work_tile.x = effective_buffer_params_.full_x + x;
-      work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
-      work_tile.h = 1;
-      work_tile.start_sample = start_sample;
-      work_tile.sample_offset = sample_offset;
-      work_tile.num_samples = 1;
-      work_tile.offset = effective_buffer_params_.offset;
-      work_tile.stride = effective_buffer_params_.stride;
+        const int64_t first_pixel = chunk_index * wavefront_chunk_pixels;
+        const int64_t pixels_num = std::min(wavefront_chunk_pixels,
+                                            total_pixels_num - first_pixel);
 
-      CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(
+            kernel_thread_globals_);
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+        render_samples_wavefront(kernel_globals,
+                                 wavefront_states_get(),
+                                 work_tile_template,
+                                 first_pixel,
+                                 pixels_num,
+                                 samples_num);
+      });
     });
-  });
+  }
+  else {
+    local_arena.execute([&]() {
+      parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
+
+        const int y = work_index / image_width;
+        const int x = work_index - y * image_width;
+
+        KernelWorkTile work_tile = work_tile_template;
+        work_tile.x = effective_buffer_params_.full_x + x;
+        work_tile.y = effective_buffer_params_.full_y + y;
+
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(
+            kernel_thread_globals_);
+
+        render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      });
+    });
+  }
+
   if (device_->profiler.active()) {
     for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
       kernel_globals.stop_profiling();
@@ -162,6 +234,112 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_glo
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                                IntegratorStateCPU *states,
+                                                const KernelWorkTile &work_tile,
+                                                const int64_t first_pixel,
+                                                const int64_t pixels_num,
+                                                const int samples_num)
+{
+  const bool has_bake = device_scene_->data.bake.use;
+
+  /* The shadow catcher split continues the path in the state following the one it was split
+   * from, so every path gets a pair of states then. */
+  const int state_stride = device_scene_->data.integrator.has_shadow_catcher ? 2 : 1;
+  const int states_num = wavefront_paths_num * state_stride;
+
+  for (int i = 0; i < states_num; i++) {
+    path_state_init_queues(&states[i]);
+  }
+
+  struct QueuedState {
+    uint32_t kernel;
+    uint32_t sort_key;
+    IntegratorStateCPU *state;
+  };
+  QueuedState queue[wavefront_paths_num * 2];
+
+  const int64_t image_width = effective_buffer_params_.width;
+  const int64_t work_items_num = pixels_num * samples_num;
+  int64_t next_work_item = 0;
+
+  float *render_buffer = buffers_->buffer.data();
+
+  while (!is_cancel_requested()) {
+    /* Start new paths in the slots of the finished ones. The samples are the outer loop, so that
+     * the batch is filled with paths of different pixels. */
+    for (int i = 0; i < states_num && next_work_item < work_items_num; i += state_stride) {
+      IntegratorStateCPU *state = &states[i];
+
+      while (next_work_item < work_items_num && !wavefront_state_queued_kernel(state) &&
+             (state_stride == 1 || !wavefront_state_queued_kernel(state + 1)))
+      {
+        const int64_t pixel = first_pixel + next_work_item % pixels_num;
+        const int sample = next_work_item / pixels_num;
+        ++next_work_item;
+
+        const int y = pixel / image_width;
+        const int x = pixel - y * image_width;
+
+        KernelWorkTile sample_work_tile = work_tile;
+        sample_work_tile.x = effective_buffer_params_.full_x + x;
+        sample_work_tile.y = effective_buffer_params_.full_y + y;
+        sample_work_tile.start_sample += sample;
+
+        /* Pixels which do not need this sample leave the path without queued kernels, so the
+         * next work item is tried in the same slot. */
+        if (has_bake) {
+          kernels_.integrator_init_from_bake(
+              kernel_globals, state, &sample_work_tile, render_buffer);
+        }
+        else {
+          kernels_.integrator_init_from_camera(
+              kernel_globals, state, &sample_work_tile, render_buffer);
+        }
+      }
+    }
+
+    int queue_size = 0;
+    for (int i = 0; i < states_num; i++) {
+      const uint32_t kernel = wavefront_state_queued_kernel(&states[i]);
+      if (kernel) {
+        const uint32_t sort_key = wavefront_kernel_uses_sorting(kernel) ?
+                                      states[i].path.shader_sort_key :
+                                      0;
+        queue[queue_size++] = {kernel, sort_key, &states[i]};
+      }
+    }
+
+    if (queue_size == 0) {
+      break;
+    }
+
+    std::sort(queue, queue + queue_size, [](const QueuedState &a, const QueuedState &b) {
+      return (a.kernel != b.kernel) ? a.kernel < b.kernel : a.sort_key < b.sort_key;
+    });
+
+    for (int i = 0; i < queue_size; i++) {
+      kernels_.integrator_megakernel_step(kernel_globals, queue[i].state, render_buffer);
+    }
+  }
+}
+
+IntegratorStateCPU *PathTraceWorkCPU::wavefront_states_get()
+{
+  const int thread_index = tbb::this_task_arena::current_thread_index();
+  DCHECK_GE(thread_index, 0);
+  DCHECK_LT(thread_index, wavefront_states_.size());
+
+  unique_ptr<IntegratorStateCPU[]> &states = wavefront_states_[thread_index];
+  if (!states) {
+    /* Not value-initialized on purpose: the states are large and most of the shadow
+     * intersection arrays is never touched. */
+    states.reset(new IntegratorStateCPU[wavefront_paths_num * 2]);
+  }
+
+  return states.get();
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        int num_samples)
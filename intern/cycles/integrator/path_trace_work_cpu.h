@@ -11,6 +11,7 @@
 
 #include "integrator/path_trace_work.h"
 
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
@@ -74,6 +75,20 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Path tracing routine of the wavefront mode. Renders all samples of the given range of pixels
+   * with a batch of paths in flight, executing one kernel of every path at a time. The paths are
+   * sorted by the kernel they execute next and by shader, so that consecutive kernel invocations
+   * work on the same code and scene data. */
+  void render_samples_wavefront(KernelGlobalsCPU *kernel_globals,
+                                IntegratorStateCPU *states,
+                                const KernelWorkTile &work_tile,
+                                const int64_t first_pixel,
+                                const int64_t pixels_num,
+                                const int samples_num);
+
+  /* Get the integrator states of the wavefront batch of the current thread. */
+  IntegratorStateCPU *wavefront_states_get();
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +98,9 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Integrator states of the wavefront mode, allocated on first use by each thread. */
+  vector<unique_ptr<IntegratorStateCPU[]>> wavefront_states_;
 };
 
 CCL_NAMESPACE_END
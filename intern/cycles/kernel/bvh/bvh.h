@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "kernel/bvh/quantized.h"
 #include "kernel/bvh/types.h"
 #include "kernel/bvh/util.h"
 
@@ -16,6 +16,17 @@ ccl_device_forceinline Transform bvh_unaligned_node_fetch_space(KernelGlobals kg
   return space;
 }
 
+ccl_device_forceinline void bvh_quantized_node_decode(KernelGlobals kg,
+                                                      const int node_addr,
+                                                      ccl_private float4 *node0,
+                                                      ccl_private float4 *node1,
+                                                      ccl_private float4 *node2)
+{
+  const float4 origin = kernel_data_fetch(bvh_nodes, node_addr + 1);
+  const float4 quantized = kernel_data_fetch(bvh_nodes, node_addr + 2);
+  bvh_quantized_node_decode_bounds(origin, quantized, node0, node1, node2);
+}
+
 ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals kg,
                                                       const float3 P,
                                                       const float3 idir,
@@ -27,12 +38,16 @@ ccl_device_forceinline int bvh_aligned_node_intersect(KernelGlobals kg,
 {
 
   /* fetch node data */
-#ifdef __VISIBILITY_FLAG__
   float4 cnodes = kernel_data_fetch(bvh_nodes, node_addr + 0);
-#endif
-  float4 node0 = kernel_data_fetch(bvh_nodes, node_addr + 1);
-  float4 node1 = kernel_data_fetch(bvh_nodes, node_addr + 2);
-  float4 node2 = kernel_data_fetch(bvh_nodes, node_addr + 3);
+  float4 node0, node1, node2;
+  if (__float_as_uint(cnodes.x) & PATH_RAY_NODE_QUANTIZED) {
+    bvh_quantized_node_decode(kg, node_addr, &node0, &node1, &node2);
+  }
+  else {
+    node0 = kernel_data_fetch(bvh_nodes, node_addr + 1);
+    node1 = kernel_data_fetch(bvh_nodes, node_addr + 2);
+    node2 = kernel_data_fetch(bvh_nodes, node_addr + 3);
+  }
 
   /* intersect ray against child nodes */
   float c0lox = (node0.x - P.x) * idir.x;
@@ -0,0 +1,46 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* Decode the child bounds of a quantized BVH2 node into the same layout as an aligned node, one
+ * row per axis with the lower and upper bounds of both children. The bounds are stored as 8 bit
+ * offsets from the node origin in power of two steps, so the decoded bounds are exact.
+ *
+ * Shared with the host side, which encodes the nodes. */
+ccl_device_forceinline void bvh_quantized_node_decode_bounds(const float4 origin,
+                                                             const float4 quantized,
+                                                             ccl_private float4 *node0,
+                                                             ccl_private float4 *node1,
+                                                             ccl_private float4 *node2)
+{
+  const uint exponents = __float_as_uint(origin.w);
+  const uint qx = __float_as_uint(quantized.x);
+  const uint qy = __float_as_uint(quantized.y);
+  const uint qz = __float_as_uint(quantized.z);
+
+  const float scale_x = __uint_as_float((exponents & 0xFF) << 23);
+  const float scale_y = __uint_as_float(((exponents >> 8) & 0xFF) << 23);
+  const float scale_z = __uint_as_float(((exponents >> 16) & 0xFF) << 23);
+
+  *node0 = make_float4(origin.x) + make_float4((float)(qx & 0xFF),
+                                               (float)((qx >> 8) & 0xFF),
+                                               (float)((qx >> 16) & 0xFF),
+                                               (float)(qx >> 24)) *
+                                       scale_x;
+  *node1 = make_float4(origin.y) + make_float4((float)(qy & 0xFF),
+                                               (float)((qy >> 8) & 0xFF),
+                                               (float)((qy >> 16) & 0xFF),
+                                               (float)(qy >> 24)) *
+                                       scale_y;
+  *node2 = make_float4(origin.z) + make_float4((float)(qz & 0xFF),
+                                               (float)((qz >> 8) & 0xFF),
+                                               (float)((qz >> 16) & 0xFF),
+                                               (float)(qz >> 24)) *
+                                       scale_z;
+}
+
+CCL_NAMESPACE_END
@@ -12,6 +12,17 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Images read on demand, see `kernel/device/cpu/image_cache.h`. */
+struct TextureCacheImage;
+void kernel_tex_image_cache_lookup(const TextureCacheImage *image,
+                                   float s,
+                                   float t,
+                                   float dsdx,
+                                   float dtdx,
+                                   float dsdy,
+                                   float dtdy,
+                                   float result[4]);
+
 /* Make template functions private so symbols don't conflict between kernels with different
  * instruction sets. */
 namespace {
@@ -795,6 +806,18 @@ template<typename TexT, typename OutT = float4> struct NanoVDBInterpolator {
 
 #undef SET_CUBIC_SPLINE_WEIGHTS
 
+ccl_device float4 kernel_tex_image_interp_cache(const TextureInfo &info,
+                                                float x,
+                                                float y,
+                                                const float2 dx,
+                                                const float2 dy)
+{
+  float result[4];
+  kernel_tex_image_cache_lookup(
+      (const TextureCacheImage *)info.data, x, y, dx.x, dx.y, dy.x, dy.y, result);
+  return make_float4(result[0], result[1], result[2], result[3]);
+}
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, float y)
 {
   const TextureInfo &info = kernel_data_fetch(texture_info, id);
@@ -803,6 +826,10 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
     return zero_float4();
   }
 
+  if (info.use_texture_cache) {
+    return kernel_tex_image_interp_cache(info, x, y, zero_float2(), zero_float2());
+  }
+
   switch (info.data_type) {
     case IMAGE_DATA_TYPE_HALF: {
       const float f = TextureInterpolator<half, float>::interp(info, x, y);
@@ -835,6 +862,20 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
   }
 }
 
+/* Derivatives of the coordinates are only used by images read through the texture cache, to
+ * select their mipmap level. */
+ccl_device float4
+kernel_tex_image_interp(KernelGlobals kg, int id, float x, float y, float2 dx, float2 dy)
+{
+  const TextureInfo &info = kernel_data_fetch(texture_info, id);
+
+  if (info.use_texture_cache) {
+    return kernel_tex_image_interp_cache(info, x, y, dx, dy);
+  }
+
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+
 ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals kg,
                                              int id,
                                              float3 P,
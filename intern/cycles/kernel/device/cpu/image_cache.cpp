@@ -0,0 +1,47 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "kernel/device/cpu/image_cache.h"
+
+#include "util/math.h"
+#include "util/texture.h"
+
+CCL_NAMESPACE_BEGIN
+
+void kernel_tex_image_cache_lookup(const TextureCacheImage *image,
+                                   const float s,
+                                   const float t,
+                                   const float dsdx,
+                                   const float dtdx,
+                                   const float dsdy,
+                                   const float dtdy,
+                                   float result[4])
+{
+  OIIO::TextureOpt options = image->options;
+
+  /* Images are stored bottom to top in the kernel, OpenImageIO addresses them from the top. */
+  if (!image->texture_system->texture(
+          image->handle, nullptr, options, s, 1.0f - t, dsdx, -dtdx, dsdy, -dtdy, 4, result))
+  {
+    /* Clear the error, the message would otherwise be kept for every failed lookup. */
+    image->texture_system->geterror();
+    result[0] = TEX_IMAGE_MISSING_R;
+    result[1] = TEX_IMAGE_MISSING_G;
+    result[2] = TEX_IMAGE_MISSING_B;
+    result[3] = TEX_IMAGE_MISSING_A;
+    return;
+  }
+
+  /* Same as for images loaded into memory, avoid artifacts from buggy values. */
+  if (!isfinite_safe(result[0]) || !isfinite_safe(result[1]) || !isfinite_safe(result[2]) ||
+      !isfinite_safe(result[3]))
+  {
+    result[0] = 0.0f;
+    result[1] = 0.0f;
+    result[2] = 0.0f;
+    result[3] = 0.0f;
+  }
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,38 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* Images which are not loaded into memory before rendering, but read on demand through an
+ * OpenImageIO texture system. It reads tiles of the mipmap level matching the footprint of the
+ * lookup, and keeps a bounded number of them in memory. Only supported by the CPU kernels. */
+
+#pragma once
+
+#include <OpenImageIO/texture.h>
+
+#include "util/types.h"
+
+CCL_NAMESPACE_BEGIN
+
+struct TextureCacheImage {
+  OIIO::TextureSystem *texture_system;
+  OIIO::TextureSystem::TextureHandle *handle;
+  /* Interpolation and extension of the image. */
+  OIIO::TextureOpt options;
+};
+
+/* Look up an RGBA value of the image. Derivatives of the coordinates select the mipmap level,
+ * zero derivatives select the full resolution.
+ *
+ * Not part of the kernel itself to keep OpenImageIO out of the kernels compiled for specific
+ * instruction sets, the declaration is repeated in `kernel/device/cpu/image.h`. */
+void kernel_tex_image_cache_lookup(const TextureCacheImage *image,
+                                   float s,
+                                   float t,
+                                   float dsdx,
+                                   float dtdx,
+                                   float dsdy,
+                                   float dtdy,
+                                   float result[4]);
+
+CCL_NAMESPACE_END
@@ -42,6 +42,9 @@
 #    endif
 #    define __KERNEL_AVX2__
 #  endif
+#  if defined(__AVX512F__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
+#    define __KERNEL_AVX512__
+#  endif
 #endif
 
 /* quiet unused define warnings */
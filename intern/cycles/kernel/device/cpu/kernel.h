@@ -42,4 +42,7 @@ void kernel_global_memory_copy(KernelGlobalsCPU *kg, const char *name, void *mem
 #define KERNEL_ARCH cpu_avx2
 #include "kernel/device/cpu/kernel_arch.h"
 
+#define KERNEL_ARCH cpu_avx512
+#include "kernel/device/cpu/kernel_arch.h"
+
 CCL_NAMESPACE_END
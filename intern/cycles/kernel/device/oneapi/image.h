@@ -299,6 +299,13 @@ template<typename T> struct NanoVDBInterpolator {
 };
 #endif /* WITH_NANOVDB */
 
+/* Derivatives of the coordinates are only used by the CPU texture cache. */
+ccl_device float4
+kernel_tex_image_interp(KernelGlobals kg, int id, float x, float y, float2 /*dx*/, float2 /*dy*/)
+{
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+
 ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals, int id, float3 P, int interp)
 {
   const TextureInfo &info = kernel_data_fetch(texture_info, id);
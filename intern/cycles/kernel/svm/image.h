@@ -6,14 +6,15 @@
 
 CCL_NAMESPACE_BEGIN
 
-ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y, uint flags)
+ccl_device float4 svm_image_texture(
+    KernelGlobals kg, int id, float x, float y, float2 dx, float2 dy, uint flags)
 {
   if (id == -1) {
     return make_float4(
         TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
   }
 
-  float4 r = kernel_tex_image_interp(kg, id, x, y);
+  float4 r = kernel_tex_image_interp(kg, id, x, y, dx, dy);
   const float alpha = r.w;
 
   if ((flags & NODE_IMAGE_ALPHA_UNASSOCIATE) && alpha != 1.0f && alpha != 0.0f) {
@@ -28,6 +29,37 @@ ccl_device float4 svm_image_texture(KernelGlobals kg, int id, float x, float y,
   return r;
 }
 
+/* Derivatives of the texture coordinate, used by the CPU texture cache to choose the resolution
+ * of the image. They are only known when the coordinate is the default UV map, in other cases
+ * zero derivatives choose the full resolution. */
+ccl_device_inline void svm_image_texture_derivatives(KernelGlobals kg,
+                                                     ccl_private const ShaderData *sd,
+                                                     const int id,
+                                                     const float2 tex_co,
+                                                     ccl_private float2 *dx,
+                                                     ccl_private float2 *dy)
+{
+  *dx = zero_float2();
+  *dy = zero_float2();
+#ifndef __KERNEL_GPU__
+  if (id == -1 || !kernel_data_fetch(texture_info, id).use_texture_cache) {
+    return;
+  }
+
+  const AttributeDescriptor desc = find_attribute(kg, sd, ATTR_STD_UV);
+  if (desc.offset == ATTR_STD_NOT_FOUND) {
+    return;
+  }
+
+  float2 uv_dx, uv_dy;
+  const float2 uv = primitive_surface_attribute_float2(kg, sd, desc, &uv_dx, &uv_dy);
+  if (fabsf(uv.x - tex_co.x) < 1e-6f && fabsf(uv.y - tex_co.y) < 1e-6f) {
+    *dx = uv_dx;
+    *dy = uv_dy;
+  }
+#endif
+}
+
 /* Remap coordinate from 0..1 box to -1..-1 */
 ccl_device_inline float3 texco_remap_square(float3 co)
 {
@@ -54,6 +86,7 @@ ccl_device_noinline int svm_node_tex_image(
   else {
     tex_co = make_float2(co.x, co.y);
   }
+  const float2 image_co = tex_co;
 
   /* TODO(lukas): Consider moving tile information out of the SVM node.
    * TextureInfo seems a reasonable candidate. */
@@ -98,7 +131,10 @@ ccl_device_noinline int svm_node_tex_image(
     id = -num_nodes;
   }
 
-  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags);
+  float2 tex_co_dx, tex_co_dy;
+  svm_image_texture_derivatives(kg, sd, id, image_co, &tex_co_dx, &tex_co_dy);
+
+  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, tex_co_dx, tex_co_dy, flags);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
@@ -192,15 +228,15 @@ ccl_device_noinline void svm_node_tex_image_box(KernelGlobals kg,
   /* Map so that no textures are flipped, rotation is somewhat arbitrary. */
   if (weight.x > 0.0f) {
     float2 uv = make_float2((signed_N.x < 0.0f) ? 1.0f - co.y : co.y, co.z);
-    f += weight.x * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.x * svm_image_texture(kg, id, uv.x, uv.y, zero_float2(), zero_float2(), flags);
   }
   if (weight.y > 0.0f) {
     float2 uv = make_float2((signed_N.y > 0.0f) ? 1.0f - co.x : co.x, co.z);
-    f += weight.y * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.y * svm_image_texture(kg, id, uv.x, uv.y, zero_float2(), zero_float2(), flags);
   }
   if (weight.z > 0.0f) {
     float2 uv = make_float2((signed_N.z > 0.0f) ? 1.0f - co.y : co.y, co.x);
-    f += weight.z * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.z * svm_image_texture(kg, id, uv.x, uv.y, zero_float2(), zero_float2(), flags);
   }
 
   if (stack_valid(out_offset))
@@ -230,7 +266,7 @@ ccl_device_noinline void svm_node_tex_environment(KernelGlobals kg,
   else
     uv = direction_to_mirrorball(co);
 
-  float4 f = svm_image_texture(kg, id, uv.x, uv.y, flags);
+  float4 f = svm_image_texture(kg, id, uv.x, uv.y, zero_float2(), zero_float2(), flags);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
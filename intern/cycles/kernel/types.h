@@ -244,6 +244,10 @@ enum PathRayFlag : uint32_t {
    * So this can overlap with path flags. */
   PATH_RAY_NODE_UNALIGNED = (1U << 11U),
 
+  /* Special flag to tag quantized BVH nodes, which store the bounding boxes of their children with
+   * 8 bit precision relative to the node bounds. Like the flag above, only used in BVH nodes. */
+  PATH_RAY_NODE_QUANTIZED = (1U << 12U),
+
   /* --------------------------------------------------------------------
    * Path flags.
    */
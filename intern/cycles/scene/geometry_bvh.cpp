@@ -4,6 +4,7 @@
 
 #include "bvh/bvh.h"
 #include "bvh/bvh2.h"
+#include "bvh/cache.h"
 
 #include "device/device.h"
 
@@ -81,6 +82,7 @@ void Geometry::compute_bvh(Device *device,
       BVHParams bparams;
       bparams.use_spatial_split = params->use_bvh_spatial_split;
       bparams.use_compact_structure = params->use_bvh_compact_structure;
+      bparams.use_quantized_nodes = params->use_bvh_quantized_nodes;
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
@@ -92,7 +94,27 @@ void Geometry::compute_bvh(Device *device,
 
       delete bvh;
       bvh = BVH::create(bparams, geometry, objects, device);
-      MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+
+      /* Only BVH2 can be cached, the other layouts are built by libraries which do not support
+       * serialization. */
+      const bool use_bvh_cache = !params->bvh_cache_directory.empty() &&
+                                 bvh_layout == BVH_LAYOUT_BVH2;
+      const string bvh_cache_key_str = use_bvh_cache ? bvh_cache_key(bvh->params, this) : "";
+
+      if (use_bvh_cache && bvh_cache_read(params->bvh_cache_directory,
+                                          bvh_cache_key_str,
+                                          static_cast<BVH2 *>(bvh)->pack))
+      {
+        progress->set_status(msg, "Loaded BVH from cache");
+      }
+      else {
+        MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+
+        if (use_bvh_cache && !progress->get_cancel()) {
+          bvh_cache_write(
+              params->bvh_cache_directory, bvh_cache_key_str, static_cast<BVH2 *>(bvh)->pack);
+        }
+      }
     }
   }
 
@@ -113,6 +135,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.bvh_layout = BVHParams::best_bvh_layout(
       scene->params.bvh_layout, device->get_bvh_layout_mask(dscene->data.kernel_features));
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
+  bparams.use_quantized_nodes = scene->params.use_bvh_quantized_nodes;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
@@ -326,6 +326,9 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+
+  texture_cache_supported = (info.type == DEVICE_CPU);
+  texture_cache = NULL;
 }
 
 ImageManager::~ImageManager()
@@ -485,6 +488,7 @@ size_t ImageManager::add_image_slot(ImageLoader *loader,
   img->builtin = builtin;
   img->users = 1;
   img->mem = NULL;
+  img->cache_image = NULL;
 
   images[slot] = img;
 
@@ -683,6 +687,126 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+void ImageManager::texture_cache_init(Scene *scene)
+{
+  if (texture_cache || !texture_cache_supported || scene->params.texture_cache_size <= 0) {
+    return;
+  }
+
+  /* Not shared with other renders like the OSL texture system, the memory limit is a setting of
+   * the scene. */
+  texture_cache = OIIO::TextureSystem::create(false);
+  texture_cache->attribute("automip", 1);
+  texture_cache->attribute("autotile", 64);
+  texture_cache->attribute("gray_to_rgb", 1);
+  texture_cache->attribute("max_memory_MB", scene->params.texture_cache_size);
+}
+
+void ImageManager::texture_cache_free()
+{
+  if (texture_cache == NULL) {
+    return;
+  }
+
+  VLOG_INFO << "Texture cache statistics:\n" << texture_cache->getstats();
+
+  OIIO::TextureSystem::destroy(texture_cache);
+  texture_cache = NULL;
+}
+
+/* Set up the image to be read on demand through the texture cache, instead of loading all its
+ * pixels. Returns false when the cache can't read the image the same way as loading it would,
+ * in which case it is loaded as usual. */
+bool ImageManager::texture_cache_load_image(Image *img, int texture_limit)
+{
+  if (texture_cache == NULL) {
+    return false;
+  }
+
+  /* Only 2D images read from files by OpenImageIO, without color space conversion or alpha
+   * handling which is done while loading the pixels. */
+  const ImageMetaData &metadata = img->metadata;
+  const ustring filepath = img->loader->osl_filepath();
+  if (filepath.empty() || metadata.channels == 0 || metadata.depth > 1 ||
+      !(metadata.colorspace == u_colorspace_raw || metadata.colorspace == u_colorspace_srgb) ||
+      !image_associate_alpha(img))
+  {
+    return false;
+  }
+
+  /* CMYK JPEG files are converted to RGB while loading, the cache would read the CMYK values. */
+  if (strcmp(metadata.colorspace_file_format, "jpeg") == 0 && metadata.channels == 4) {
+    return false;
+  }
+
+  /* The cache reads the full resolution, images above the texture limit are loaded scaled down
+   * instead. */
+  if (texture_limit > 0 && max(metadata.width, metadata.height) > (size_t)texture_limit) {
+    return false;
+  }
+
+  OIIO::TextureSystem::TextureHandle *handle = texture_cache->get_texture_handle(filepath);
+  if (handle == NULL || !texture_cache->good(handle)) {
+    texture_cache->geterror();
+    return false;
+  }
+
+  TextureCacheImage *cache_image = new TextureCacheImage();
+  cache_image->texture_system = texture_cache;
+  cache_image->handle = handle;
+
+  OIIO::TextureOpt &options = cache_image->options;
+  switch (img->params.interpolation) {
+    case INTERPOLATION_CLOSEST:
+      options.interpmode = OIIO::TextureOpt::InterpClosest;
+      options.mipmode = OIIO::TextureOpt::MipModeNoMIP;
+      break;
+    case INTERPOLATION_CUBIC:
+      options.interpmode = OIIO::TextureOpt::InterpBicubic;
+      options.mipmode = OIIO::TextureOpt::MipModeTrilinear;
+      break;
+    case INTERPOLATION_SMART:
+      options.interpmode = OIIO::TextureOpt::InterpSmartBicubic;
+      options.mipmode = OIIO::TextureOpt::MipModeTrilinear;
+      break;
+    default:
+      options.interpmode = OIIO::TextureOpt::InterpBilinear;
+      options.mipmode = OIIO::TextureOpt::MipModeTrilinear;
+      break;
+  }
+
+  switch (img->params.extension) {
+    case EXTENSION_EXTEND:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapClamp;
+      break;
+    case EXTENSION_CLIP:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapBlack;
+      break;
+    case EXTENSION_MIRROR:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapMirror;
+      break;
+    default:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapPeriodic;
+      break;
+  }
+
+  /* Opaque alpha for images without alpha channel. */
+  options.fill = 1.0f;
+
+  img->cache_image = cache_image;
+
+  /* A single pixel keeps the texture slot in use, the kernel reads from the cache instead. */
+  thread_scoped_lock device_lock(device_mutex);
+  void *pixels = img->mem->alloc(1, 1);
+  memset(pixels, 0, img->mem->memory_size());
+  img->mem->info.use_texture_cache = true;
+  img->mem->info.data = (uint64_t)cache_image;
+
+  VLOG_WORK << "Reading image " << img->loader->name() << " through the texture cache.";
+
+  return true;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -707,6 +831,12 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
     delete img->mem;
     img->mem = NULL;
   }
+  if (img->cache_image) {
+    /* Read the file again, it might have changed. */
+    texture_cache->invalidate(img->loader->osl_filepath());
+    delete img->cache_image;
+    img->cache_image = NULL;
+  }
 
   img->mem = new device_texture(
       device, img->mem_name.c_str(), slot, type, img->params.interpolation, img->params.extension);
@@ -714,7 +844,10 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
   /* Create new texture. */
-  if (type == IMAGE_DATA_TYPE_FLOAT4) {
+  if (texture_cache_load_image(img, texture_limit)) {
+    /* Pixels are read while rendering. */
+  }
+  else if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
@@ -837,6 +970,11 @@ void ImageManager::device_free_image(Device *, size_t slot)
 #endif
   }
 
+  if (img->cache_image) {
+    texture_cache->invalidate(img->loader->osl_filepath());
+    delete img->cache_image;
+  }
+
   if (img->mem) {
     thread_scoped_lock device_lock(device_mutex);
     delete img->mem;
@@ -859,6 +997,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  texture_cache_init(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -928,6 +1068,8 @@ void ImageManager::device_free(Device *device)
     device_free_image(device, slot);
   }
   images.clear();
+
+  texture_cache_free();
 }
 
 void ImageManager::collect_statistics(RenderStats *stats)
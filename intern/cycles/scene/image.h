@@ -7,6 +7,8 @@
 
 #include "device/memory.h"
 
+#include "kernel/device/cpu/image_cache.h"
+
 #include "scene/colorspace.h"
 
 #include "util/string.h"
@@ -207,6 +209,8 @@ class ImageManager {
 
     string mem_name;
     device_texture *mem;
+    /* Set when the pixels are read on demand by the texture cache. */
+    TextureCacheImage *cache_image;
 
     int users;
     thread_mutex mutex;
@@ -224,6 +228,10 @@ class ImageManager {
   vector<Image *> images;
   void *osl_texture_system;
 
+  /* Reads image pixels on demand while rendering, only supported by the CPU kernels. */
+  bool texture_cache_supported;
+  OIIO::TextureSystem *texture_cache;
+
   size_t add_image_slot(ImageLoader *loader, const ImageParams &params, const bool builtin);
   void add_image_user(size_t slot);
   void remove_image_user(size_t slot);
@@ -233,6 +241,10 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  void texture_cache_init(Scene *scene);
+  void texture_cache_free();
+  bool texture_cache_load_image(Image *img, int texture_limit);
+
   void device_load_image(Device *device, Scene *scene, size_t slot, Progress *progress);
   void device_free_image(Device *device, size_t slot);
 
@@ -819,9 +819,17 @@ void ObjectManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
+  /* Geometry with applied transforms is built into the scene BVH, which is not cached. Keep all
+   * geometry instanced when the BVH cache is used, so that every frame only builds the scene BVH
+   * over the instances. */
+  const BVHLayout bvh_layout = BVHParams::best_bvh_layout(
+      scene->params.bvh_layout, device->get_bvh_layout_mask(dscene->data.kernel_features));
+  const bool use_bvh_cache = !scene->params.bvh_cache_directory.empty() &&
+                             bvh_layout == BVH_LAYOUT_BVH2;
+
   /* prepare for static BVH building */
   /* todo: do before to support getting object level coords? */
-  if (scene->params.bvh_type == BVH_TYPE_STATIC) {
+  if (scene->params.bvh_type == BVH_TYPE_STATIC && !use_bvh_cache) {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
         scene->update_stats->object.times.add_entry(
@@ -321,7 +321,7 @@ void OSLShaderManager::shading_system_init()
           "shadow", /* PATH_RAY_SHADOW_TRANSPARENT */
 
           "__unused__", /* PATH_RAY_NODE_UNALIGNED */
-          "__unused__", /* PATH_RAY_MIS_SKIP */
+          "__unused__", /* PATH_RAY_NODE_QUANTIZED, PATH_RAY_MIS_SKIP */
 
           "diffuse_ancestor", /* PATH_RAY_DIFFUSE_ANCESTOR */
 
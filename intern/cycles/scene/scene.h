@@ -66,11 +66,16 @@ class SceneParams {
   BVHType bvh_type;
   bool use_bvh_spatial_split;
   bool use_bvh_compact_structure;
+  bool use_bvh_quantized_nodes;
   bool use_bvh_unaligned_nodes;
   int num_bvh_time_steps;
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Memory limit in megabytes of the texture cache, or zero to load images fully. */
+  int texture_cache_size;
+  /* Directory of the persistent BVH cache, or empty to not use it. */
+  string bvh_cache_directory;
 
   bool background;
 
@@ -81,11 +86,13 @@ class SceneParams {
     bvh_type = BVH_TYPE_DYNAMIC;
     use_bvh_spatial_split = false;
     use_bvh_compact_structure = true;
+    use_bvh_quantized_nodes = false;
     use_bvh_unaligned_nodes = true;
     num_bvh_time_steps = 0;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_cache_size = 0;
     background = true;
   }
 
@@ -95,10 +102,13 @@ class SceneParams {
              bvh_type == params.bvh_type &&
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_compact_structure == params.use_bvh_compact_structure &&
+             use_bvh_quantized_nodes == params.use_bvh_quantized_nodes &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_cache_size == params.texture_cache_size &&
+             bvh_cache_directory == params.bvh_cache_directory);
   }
 
   int curve_subdivisions()
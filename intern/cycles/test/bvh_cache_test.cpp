@@ -0,0 +1,217 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "bvh/bvh.h"
+#include "bvh/cache.h"
+#include "bvh/params.h"
+
+#include "scene/attribute.h"
+#include "scene/hair.h"
+#include "scene/mesh.h"
+
+#include "util/path.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+void fill_mesh(Mesh &mesh)
+{
+  mesh.reserve_mesh(4, 2);
+  mesh.add_vertex(make_float3(0.0f, 0.0f, 0.0f));
+  mesh.add_vertex(make_float3(1.0f, 0.0f, 0.0f));
+  mesh.add_vertex(make_float3(1.0f, 1.0f, 0.0f));
+  mesh.add_vertex(make_float3(0.0f, 1.0f, 0.0f));
+  mesh.add_triangle(0, 1, 2, 0, false);
+  mesh.add_triangle(0, 2, 3, 0, false);
+}
+
+void fill_hair(Hair &hair)
+{
+  hair.reserve_curves(1, 3);
+  hair.add_curve_key(make_float3(0.0f, 0.0f, 0.0f), 0.1f);
+  hair.add_curve_key(make_float3(0.0f, 0.0f, 1.0f), 0.1f);
+  hair.add_curve_key(make_float3(0.0f, 0.0f, 2.0f), 0.05f);
+  hair.add_curve(0, 0);
+}
+
+PackedBVH create_packed_bvh()
+{
+  PackedBVH pack;
+  pack.root_index = 3;
+  pack.nodes.resize(12);
+  for (size_t i = 0; i < pack.nodes.size(); i++) {
+    pack.nodes[i] = make_int4(int(i), -int(i), int(i) * 3, 7);
+  }
+  pack.leaf_nodes.resize(5);
+  for (size_t i = 0; i < pack.leaf_nodes.size(); i++) {
+    pack.leaf_nodes[i] = make_int4(int(i) + 100, 1, 2, 3);
+  }
+  /* The object node array is left empty, which is stored as well. */
+  pack.prim_type.resize(6);
+  pack.prim_visibility.resize(6);
+  pack.prim_index.resize(6);
+  pack.prim_object.resize(6);
+  pack.prim_time.resize(6);
+  for (int i = 0; i < 6; i++) {
+    pack.prim_type[i] = PRIMITIVE_TRIANGLE;
+    pack.prim_visibility[i] = ~0u;
+    pack.prim_index[i] = i * 2;
+    pack.prim_object[i] = 0;
+    pack.prim_time[i] = make_float2(0.0f, float(i) / 5.0f);
+  }
+  return pack;
+}
+
+template<typename T> void expect_arrays_equal(const array<T> &a, const array<T> &b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  EXPECT_EQ(memcmp(a.data(), b.data(), a.size() * sizeof(T)), 0);
+}
+
+void expect_packed_bvh_equal(const PackedBVH &a, const PackedBVH &b)
+{
+  EXPECT_EQ(a.root_index, b.root_index);
+  expect_arrays_equal(a.nodes, b.nodes);
+  expect_arrays_equal(a.leaf_nodes, b.leaf_nodes);
+  expect_arrays_equal(a.object_node, b.object_node);
+  expect_arrays_equal(a.prim_type, b.prim_type);
+  expect_arrays_equal(a.prim_visibility, b.prim_visibility);
+  expect_arrays_equal(a.prim_index, b.prim_index);
+  expect_arrays_equal(a.prim_object, b.prim_object);
+  expect_arrays_equal(a.prim_time, b.prim_time);
+}
+
+string test_cache_directory(const string &name)
+{
+  return path_join(path_join(testing::TempDir(), "cycles_bvh_cache_test"), name);
+}
+
+}  // namespace
+
+TEST(BVHCache, key_mesh)
+{
+  const BVHParams params;
+  Mesh mesh;
+  fill_mesh(mesh);
+
+  const string key = bvh_cache_key(params, &mesh);
+  EXPECT_EQ(key, bvh_cache_key(params, &mesh));
+
+  /* Vertex positions. */
+  mesh.get_verts()[2].z = 0.5f;
+  const string key_verts = bvh_cache_key(params, &mesh);
+  EXPECT_NE(key_verts, key);
+
+  /* Motion steps. */
+  mesh.set_use_motion_blur(true);
+  mesh.set_motion_steps(3);
+  Attribute *attr = mesh.attributes.add(ATTR_STD_MOTION_VERTEX_POSITION);
+  float3 *motion = attr->data_float3();
+  for (size_t i = 0; i < mesh.get_verts().size() * 2; i++) {
+    motion[i] = mesh.get_verts()[i % mesh.get_verts().size()];
+  }
+  const string key_motion = bvh_cache_key(params, &mesh);
+  EXPECT_NE(key_motion, key_verts);
+
+  /* Motion step positions. */
+  motion[5].x += 1.0f;
+  EXPECT_NE(bvh_cache_key(params, &mesh), key_motion);
+}
+
+TEST(BVHCache, key_hair)
+{
+  const BVHParams params;
+  Hair hair;
+  fill_hair(hair);
+
+  const string key = bvh_cache_key(params, &hair);
+  EXPECT_EQ(key, bvh_cache_key(params, &hair));
+
+  /* Radii. */
+  hair.get_curve_radius()[1] = 0.2f;
+  const string key_radius = bvh_cache_key(params, &hair);
+  EXPECT_NE(key_radius, key);
+
+  /* Key positions. */
+  hair.get_curve_keys()[2].x = 1.0f;
+  EXPECT_NE(bvh_cache_key(params, &hair), key_radius);
+}
+
+TEST(BVHCache, key_params)
+{
+  Mesh mesh;
+  fill_mesh(mesh);
+
+  const BVHParams params;
+  const string key = bvh_cache_key(params, &mesh);
+
+  BVHParams params_spatial_split = params;
+  params_spatial_split.use_spatial_split = true;
+  EXPECT_NE(bvh_cache_key(params_spatial_split, &mesh), key);
+
+  BVHParams params_quantized = params;
+  params_quantized.use_quantized_nodes = true;
+  EXPECT_NE(bvh_cache_key(params_quantized, &mesh), key);
+
+  BVHParams params_leaf_size = params;
+  params_leaf_size.max_triangle_leaf_size = params.max_triangle_leaf_size + 1;
+  EXPECT_NE(bvh_cache_key(params_leaf_size, &mesh), key);
+}
+
+TEST(BVHCache, read_write)
+{
+  const string directory = test_cache_directory("read_write");
+  const string key = "read_write";
+  const PackedBVH pack = create_packed_bvh();
+
+  bvh_cache_write(directory, key, pack);
+
+  PackedBVH pack_read;
+  ASSERT_TRUE(bvh_cache_read(directory, key, pack_read));
+  expect_packed_bvh_equal(pack_read, pack);
+
+  /* Missing entry. */
+  EXPECT_FALSE(bvh_cache_read(directory, "missing", pack_read));
+}
+
+TEST(BVHCache, read_truncated)
+{
+  const string directory = test_cache_directory("read_truncated");
+  const string key = "truncated";
+  const string filepath = path_join(directory, key + ".bvh");
+
+  bvh_cache_write(directory, key, create_packed_bvh());
+
+  vector<uint8_t> data;
+  ASSERT_TRUE(path_read_binary(filepath, data));
+  ASSERT_GT(data.size(), size_t(0));
+
+  /* Every truncated entry is rejected, and leaves the packed BVH empty. */
+  for (size_t size = 0; size < data.size(); size++) {
+    const vector<uint8_t> truncated(data.begin(), data.begin() + size);
+    ASSERT_TRUE(path_write_binary(filepath, truncated));
+
+    PackedBVH pack_read = create_packed_bvh();
+    EXPECT_FALSE(bvh_cache_read(directory, key, pack_read)) << "size " << size;
+    EXPECT_EQ(pack_read.nodes.size(), size_t(0));
+    EXPECT_EQ(pack_read.prim_index.size(), size_t(0));
+  }
+
+  /* Trailing data is rejected as well. */
+  vector<uint8_t> extended = data;
+  extended.push_back(0);
+  ASSERT_TRUE(path_write_binary(filepath, extended));
+  PackedBVH pack_read;
+  EXPECT_FALSE(bvh_cache_read(directory, key, pack_read));
+
+  /* The complete entry is still valid. */
+  ASSERT_TRUE(path_write_binary(filepath, data));
+  EXPECT_TRUE(bvh_cache_read(directory, key, pack_read));
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,124 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "bvh/bvh2.h"
+#include "util/math.h"
+
+#include "kernel/bvh/quantized.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Encode the child bounds like the BVH2 packing and decode them like the kernel. */
+static void quantize_child_bounds(const BoundBox &b0,
+                                  const BoundBox &b1,
+                                  BoundBox &r_b0,
+                                  BoundBox &r_b1)
+{
+  int4 data[2];
+  bvh_quantized_node_encode(b0, b1, data);
+
+  float4 node0, node1, node2;
+  bvh_quantized_node_decode_bounds(
+      __int4_as_float4(data[0]), __int4_as_float4(data[1]), &node0, &node1, &node2);
+
+  r_b0 = BoundBox(make_float3(node0.x, node1.x, node2.x), make_float3(node0.z, node1.z, node2.z));
+  r_b1 = BoundBox(make_float3(node0.y, node1.y, node2.y), make_float3(node0.w, node1.w, node2.w));
+}
+
+static void expect_contains(const BoundBox &decoded, const BoundBox &original)
+{
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_LE(decoded.min[axis], original.min[axis]);
+    EXPECT_GE(decoded.max[axis], original.max[axis]);
+  }
+}
+
+static void expect_quantized_contains(const BoundBox &b0, const BoundBox &b1)
+{
+  BoundBox q0, q1;
+  quantize_child_bounds(b0, b1, q0, q1);
+  expect_contains(q0, b0);
+  expect_contains(q1, b1);
+}
+
+TEST(BVHQuantizedNode, regular)
+{
+  expect_quantized_contains(
+      BoundBox(make_float3(0.0f, 0.0f, 0.0f), make_float3(1.0f, 2.0f, 3.0f)),
+      BoundBox(make_float3(-5.0f, 1.0f, 0.5f), make_float3(0.25f, 7.0f, 3.0f)));
+  expect_quantized_contains(
+      BoundBox(make_float3(1000.1f, -0.3f, 12.7f), make_float3(1000.2f, -0.1f, 12.8f)),
+      BoundBox(make_float3(1000.15f, -0.2f, 12.71f), make_float3(1000.3f, 0.7f, 13.0f)));
+
+  /* Offsets are in steps of at most 1/128th of the node size, so boxes stay tight. */
+  BoundBox q0, q1;
+  const BoundBox b0(make_float3(0.0f), make_float3(1.0f));
+  const BoundBox b1(make_float3(1.0f), make_float3(100.0f));
+  quantize_child_bounds(b0, b1, q0, q1);
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_LE(q0.max[axis] - q0.min[axis], 2.0f);
+    EXPECT_LE(q1.max[axis] - q1.min[axis], 100.0f);
+  }
+}
+
+TEST(BVHQuantizedNode, degenerate)
+{
+  /* Single point, flat box, and both children at the same position. */
+  expect_quantized_contains(
+      BoundBox(make_float3(1.0f, 1.0f, 1.0f)),
+      BoundBox(make_float3(0.0f, 0.0f, 5.0f), make_float3(2.0f, 3.0f, 5.0f)));
+  expect_quantized_contains(BoundBox(make_float3(-7.5f, 0.0f, 1e-30f)),
+                            BoundBox(make_float3(-7.5f, 0.0f, 1e-30f)));
+
+  /* Sizes which are too small to be represented in the step size. */
+  expect_quantized_contains(BoundBox(make_float3(0.0f), make_float3(1e-40f)),
+                            BoundBox(make_float3(1e-42f), make_float3(2e-40f)));
+}
+
+TEST(BVHQuantizedNode, huge)
+{
+  expect_quantized_contains(BoundBox(make_float3(-1e38f), make_float3(1e38f)),
+                            BoundBox(make_float3(0.0f), make_float3(1.0f)));
+  expect_quantized_contains(BoundBox(make_float3(-FLT_MAX), make_float3(FLT_MAX)),
+                            BoundBox(make_float3(FLT_MAX), make_float3(FLT_MAX)));
+
+  /* Infinite bounds contain every finite point. */
+  BoundBox q0, q1;
+  quantize_child_bounds(BoundBox(make_float3(-FLT_MAX, 0.0f, 0.0f),
+                                 make_float3(__int_as_float(0x7f800000), 1.0f, 1.0f)),
+                        BoundBox(make_float3(0.0f), make_float3(1.0f)),
+                        q0,
+                        q1);
+  expect_contains(q0,
+                  BoundBox(make_float3(-FLT_MAX, 0.0f, 0.0f), make_float3(FLT_MAX, 1.0f, 1.0f)));
+  expect_contains(q1, BoundBox(make_float3(0.0f), make_float3(1.0f)));
+}
+
+TEST(BVHQuantizedNode, invalid)
+{
+  const BoundBox b(make_float3(-1.0f, 2.0f, 3.0f), make_float3(4.0f, 5.0f, 6.0f));
+
+  /* Invalid children do not affect the bounds of their valid sibling. */
+  const BoundBox invalid[2] = {
+      BoundBox::empty,
+      BoundBox(make_float3(__int_as_float(0x7fc00000)), make_float3(1.0f)),
+  };
+  for (const BoundBox &invalid_bounds : invalid) {
+    BoundBox q0, q1;
+    quantize_child_bounds(invalid_bounds, b, q0, q1);
+    expect_contains(q1, b);
+    quantize_child_bounds(b, invalid_bounds, q0, q1);
+    expect_contains(q0, b);
+  }
+
+  /* Without any valid child the node still decodes to finite bounds. */
+  BoundBox q0, q1;
+  quantize_child_bounds(BoundBox::empty, BoundBox::empty, q0, q1);
+  EXPECT_TRUE(q0.valid());
+  EXPECT_TRUE(q1.valid());
+}
+
+CCL_NAMESPACE_END
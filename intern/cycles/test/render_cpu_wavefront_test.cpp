@@ -0,0 +1,263 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "scene/background.h"
+#include "scene/camera.h"
+#include "scene/colorspace.h"
+#include "scene/film.h"
+#include "scene/integrator.h"
+#include "scene/light.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/pass.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+#include "scene/shader_graph.h"
+#include "scene/shader_nodes.h"
+
+#include "session/buffers.h"
+#include "session/output_driver.h"
+#include "session/session.h"
+
+#include "util/debug.h"
+#include "util/map.h"
+#include "util/transform.h"
+#include "util/unique_ptr.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+const int image_width = 48;
+const int image_height = 32;
+
+const struct {
+  const char *name;
+  PassType type;
+} test_passes[] = {{"combined", PASS_COMBINED}, {"shadow_catcher", PASS_SHADOW_CATCHER}};
+
+/* Store the pixels of all passes of the rendered image. */
+class TestOutputDriver : public OutputDriver {
+ public:
+  explicit TestOutputDriver(map<string, vector<float>> &pixels) : pixels_(pixels) {}
+
+  void write_render_tile(const Tile &tile) override
+  {
+    /* The image is small enough to be rendered as a single tile. */
+    EXPECT_EQ(tile.size.x, image_width);
+    EXPECT_EQ(tile.size.y, image_height);
+    for (const auto &pass : test_passes) {
+      vector<float> &pixels = pixels_[pass.name];
+      pixels.resize(image_width * image_height * 4);
+      EXPECT_TRUE(tile.get_pass_pixels(pass.name, 4, pixels.data())) << pass.name;
+    }
+  }
+
+ protected:
+  map<string, vector<float>> &pixels_;
+};
+
+Shader *add_shader(Scene *scene, ShaderGraph *graph, ShaderNode *node, const char *output)
+{
+  graph->add(node);
+  graph->connect(node->output(output), graph->output()->input("Surface"));
+
+  Shader *shader = scene->create_node<Shader>();
+  shader->set_graph(graph);
+  shader->tag_update(scene);
+  return shader;
+}
+
+Shader *add_diffuse_shader(Scene *scene, const float3 color)
+{
+  ShaderGraph *graph = new ShaderGraph();
+  DiffuseBsdfNode *diffuse = graph->create_node<DiffuseBsdfNode>();
+  diffuse->set_color(color);
+  return add_shader(scene, graph, diffuse, "BSDF");
+}
+
+Shader *add_glossy_shader(Scene *scene, const float3 color, const float roughness)
+{
+  ShaderGraph *graph = new ShaderGraph();
+  GlossyBsdfNode *glossy = graph->create_node<GlossyBsdfNode>();
+  glossy->set_color(color);
+  glossy->set_roughness(roughness);
+  return add_shader(scene, graph, glossy, "BSDF");
+}
+
+/* Add an axis aligned box between the two corners. */
+Object *add_box(Scene *scene, Shader *shader, const float3 min, const float3 max)
+{
+  Mesh *mesh = scene->create_node<Mesh>();
+  array<Node *> used_shaders;
+  used_shaders.push_back_slow(shader);
+  mesh->set_used_shaders(used_shaders);
+
+  mesh->reserve_mesh(8, 12);
+  for (int i = 0; i < 8; i++) {
+    mesh->add_vertex(make_float3((i & 1) ? max.x : min.x,
+                                 (i & 2) ? max.y : min.y,
+                                 (i & 4) ? max.z : min.z));
+  }
+  const int quads[6][4] = {
+      {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+  for (const auto &quad : quads) {
+    mesh->add_triangle(quad[0], quad[1], quad[2], 0, false);
+    mesh->add_triangle(quad[0], quad[2], quad[3], 0, false);
+  }
+
+  Object *object = scene->create_node<Object>();
+  object->set_geometry(mesh);
+  object->set_tfm(transform_identity());
+  return object;
+}
+
+/* Two boxes with different materials on a shadow catcher ground, lit by a point light and the
+ * background. */
+void build_scene(Scene *scene)
+{
+  Camera *camera = scene->camera;
+  camera->set_matrix(transform_translate(0.0f, 1.5f, -6.0f));
+  camera->set_full_width(image_width);
+  camera->set_full_height(image_height);
+  camera->compute_auto_viewplane();
+
+  {
+    ShaderGraph *graph = new ShaderGraph();
+    BackgroundNode *background = graph->create_node<BackgroundNode>();
+    background->set_color(make_float3(0.2f, 0.3f, 0.4f));
+    background->set_strength(1.0f);
+    graph->add(background);
+    graph->connect(background->output("Background"), graph->output()->input("Surface"));
+
+    Shader *shader = scene->create_node<Shader>();
+    shader->set_graph(graph);
+    shader->tag_update(scene);
+    scene->background->set_shader(shader);
+  }
+
+  {
+    ShaderGraph *graph = new ShaderGraph();
+    EmissionNode *emission = graph->create_node<EmissionNode>();
+    emission->set_color(one_float3());
+    emission->set_strength(1.0f);
+
+    Light *light = scene->create_node<Light>();
+    light->set_light_type(LIGHT_POINT);
+    light->set_tfm(transform_translate(2.0f, 4.0f, -2.0f));
+    light->set_strength(make_float3(200.0f, 200.0f, 200.0f));
+    light->set_size(0.25f);
+    light->set_use_mis(true);
+    light->set_shader(add_shader(scene, graph, emission, "Emission"));
+  }
+
+  Object *ground = add_box(scene,
+                           add_diffuse_shader(scene, make_float3(0.8f, 0.8f, 0.8f)),
+                           make_float3(-10.0f, -0.1f, -10.0f),
+                           make_float3(10.0f, 0.0f, 10.0f));
+  ground->set_is_shadow_catcher(true);
+  add_box(scene,
+          add_diffuse_shader(scene, make_float3(0.8f, 0.2f, 0.1f)),
+          make_float3(-1.5f, 0.0f, -0.5f),
+          make_float3(-0.5f, 1.0f, 0.5f));
+  add_box(scene,
+          add_glossy_shader(scene, make_float3(0.7f, 0.8f, 0.9f), 0.3f),
+          make_float3(0.5f, 0.0f, 0.0f),
+          make_float3(1.5f, 1.5f, 1.0f));
+
+  /* Render the shadow catcher with its own path, which uses a second integrator state. */
+  scene->film->set_use_approximate_shadow_catcher(false);
+
+  Integrator *integrator = scene->integrator;
+  integrator->set_use_adaptive_sampling(true);
+  integrator->set_adaptive_threshold(0.05f);
+  integrator->set_adaptive_min_samples(8);
+
+  for (const auto &test_pass : test_passes) {
+    Pass *pass = scene->create_node<Pass>();
+    pass->set_name(ustring(test_pass.name));
+    pass->set_type(test_pass.type);
+    pass->set_mode(PassMode::NOISY);
+  }
+}
+
+}  // namespace
+
+class RenderCPUWavefront : public testing::Test {
+ protected:
+  virtual void SetUp()
+  {
+    ColorSpaceManager::init_fallback_config();
+  }
+
+  virtual void TearDown()
+  {
+    DebugFlags().cpu.reset();
+  }
+
+  map<string, vector<float>> render(const bool use_wavefront)
+  {
+    DebugFlags().cpu.use_wavefront = use_wavefront;
+
+    SessionParams session_params;
+    session_params.device = Device::available_devices(DEVICE_MASK_CPU).front();
+    session_params.background = true;
+    session_params.samples = 64;
+    SceneParams scene_params;
+
+    map<string, vector<float>> pixels;
+    unique_ptr<Session> session = make_unique<Session>(session_params, scene_params);
+    session->set_output_driver(make_unique<TestOutputDriver>(pixels));
+    build_scene(session->scene);
+
+    BufferParams buffer_params;
+    buffer_params.width = image_width;
+    buffer_params.height = image_height;
+    buffer_params.full_width = image_width;
+    buffer_params.full_height = image_height;
+
+    session->reset(session_params, buffer_params);
+    session->start();
+    session->wait();
+
+    EXPECT_FALSE(session->progress.get_error()) << session->progress.get_error_message();
+    session.reset();
+    return pixels;
+  }
+};
+
+/* The wavefront mode executes the same kernels for the same paths, only in another order. The
+ * results only differ by the order in which the samples are accumulated in the render buffer. */
+TEST_F(RenderCPUWavefront, matches_megakernel)
+{
+  map<string, vector<float>> megakernel_pixels = render(false);
+  map<string, vector<float>> wavefront_pixels = render(true);
+
+  for (const auto &pass : test_passes) {
+    const vector<float> &a = megakernel_pixels[pass.name];
+    const vector<float> &b = wavefront_pixels[pass.name];
+    ASSERT_EQ(a.size(), size_t(image_width * image_height * 4)) << pass.name;
+    ASSERT_EQ(a.size(), b.size()) << pass.name;
+
+    for (size_t i = 0; i < a.size(); i++) {
+      EXPECT_NEAR(a[i], b[i], 1e-4f * max(1.0f, fabsf(a[i])))
+          << pass.name << " pixel " << i / 4 << " channel " << i % 4;
+    }
+  }
+
+  /* The scene is not empty, and the boxes cast shadows on the shadow catcher. */
+  const vector<float> &shadow_catcher = megakernel_pixels["shadow_catcher"];
+  float min_shadow_catcher = 1.0f;
+  for (size_t i = 0; i < shadow_catcher.size(); i += 4) {
+    min_shadow_catcher = min(min_shadow_catcher, shadow_catcher[i]);
+  }
+  EXPECT_LT(min_shadow_catcher, 0.9f);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,184 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <OpenImageIO/imageio.h>
+
+#include "device/device.h"
+
+#include "kernel/device/cpu/image_cache.h"
+
+#include "scene/colorspace.h"
+#include "scene/image.h"
+#include "scene/scene.h"
+
+#include "util/half.h"
+#include "util/path.h"
+#include "util/progress.h"
+#include "util/stats.h"
+#include "util/unique_ptr.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+const int image_width = 16;
+const int image_height = 8;
+
+/* Write an image with a different value in every pixel and channel, rows from top to bottom. */
+string write_test_image(const string &filename, const TypeDesc format, const int channels)
+{
+  vector<float> pixels(image_width * image_height * channels);
+  for (int y = 0; y < image_height; y++) {
+    for (int x = 0; x < image_width; x++) {
+      for (int c = 0; c < channels; c++) {
+        float value = float((x * 7 + y * 13 + c * 29) % 32) / 31.0f;
+        if (c == 3) {
+          /* Alpha from fully transparent to opaque, to test its association. */
+          value = float(x) / float(image_width - 1);
+        }
+        pixels[(y * image_width + x) * channels + c] = value;
+      }
+    }
+  }
+
+  const string filepath = path_join(testing::TempDir(), filename);
+  unique_ptr<OIIO::ImageOutput> out = OIIO::ImageOutput::create(filepath);
+  EXPECT_TRUE(out);
+  if (!out) {
+    return filepath;
+  }
+
+  OIIO::ImageSpec spec(image_width, image_height, channels, format);
+  EXPECT_TRUE(out->open(filepath, spec));
+  EXPECT_TRUE(out->write_image(TypeDesc::FLOAT, pixels.data()));
+  out->close();
+
+  return filepath;
+}
+
+/* Value of the pixel of an image loaded into memory, like the kernel reads it with closest
+ * interpolation. Rows are stored from bottom to top. */
+float4 loaded_pixel(const device_texture *mem, const int x, const int y)
+{
+  const size_t index = y * mem->data_width + x;
+  switch (mem->info.data_type) {
+    case IMAGE_DATA_TYPE_BYTE4: {
+      const uchar4 p = ((const uchar4 *)mem->host_pointer)[index];
+      return make_float4(p.x, p.y, p.z, p.w) * (1.0f / 255.0f);
+    }
+    case IMAGE_DATA_TYPE_HALF4:
+      return half4_to_float4_image(((const half4 *)mem->host_pointer)[index]);
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return ((const float4 *)mem->host_pointer)[index];
+    default:
+      ADD_FAILURE() << "Unexpected image data type " << mem->info.data_type;
+      return zero_float4();
+  }
+}
+
+/* Value at the center of the pixel read through the texture cache. */
+float4 cached_pixel(const device_texture *mem, const int x, const int y)
+{
+  float result[4];
+  kernel_tex_image_cache_lookup((const TextureCacheImage *)mem->info.data,
+                                (x + 0.5f) / image_width,
+                                (y + 0.5f) / image_height,
+                                0.0f,
+                                0.0f,
+                                0.0f,
+                                0.0f,
+                                result);
+  return make_float4(result[0], result[1], result[2], result[3]);
+}
+
+}  // namespace
+
+class RenderImageTextureCache : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+
+  virtual void SetUp()
+  {
+    ColorSpaceManager::init_fallback_config();
+    device_cpu = Device::create(device_info, stats, profiler);
+  }
+
+  virtual void TearDown()
+  {
+    delete device_cpu;
+  }
+
+  /* Load the image once fully and once through the texture cache, and compare the values of all
+   * pixels with each interpolation which reads them exactly at the pixel centers. */
+  void compare_loaded_and_cached(const string &filepath,
+                                 const ustring colorspace,
+                                 const float tolerance)
+  {
+    SceneParams loaded_params;
+    SceneParams cached_params;
+    cached_params.texture_cache_size = 64;
+    Scene loaded_scene(loaded_params, device_cpu);
+    Scene cached_scene(cached_params, device_cpu);
+
+    for (const InterpolationType interpolation : {INTERPOLATION_CLOSEST, INTERPOLATION_LINEAR}) {
+      ImageParams params;
+      params.interpolation = interpolation;
+      params.extension = EXTENSION_EXTEND;
+      params.colorspace = colorspace;
+
+      Progress progress;
+      ImageHandle loaded = loaded_scene.image_manager->add_image(filepath, params);
+      ImageHandle cached = cached_scene.image_manager->add_image(filepath, params);
+      loaded_scene.image_manager->device_update(device_cpu, &loaded_scene, progress);
+      cached_scene.image_manager->device_update(device_cpu, &cached_scene, progress);
+
+      const device_texture *loaded_mem = loaded.image_memory();
+      const device_texture *cached_mem = cached.image_memory();
+      ASSERT_NE(loaded_mem, nullptr);
+      ASSERT_NE(cached_mem, nullptr);
+      EXPECT_FALSE(loaded_mem->info.use_texture_cache);
+      ASSERT_TRUE(cached_mem->info.use_texture_cache);
+      /* Colorspace conversion of sRGB images is done by the shader for both. */
+      EXPECT_EQ(loaded.metadata().compress_as_srgb, cached.metadata().compress_as_srgb);
+
+      for (int y = 0; y < image_height; y++) {
+        for (int x = 0; x < image_width; x++) {
+          const float4 a = loaded_pixel(loaded_mem, x, y);
+          const float4 b = cached_pixel(cached_mem, x, y);
+          EXPECT_NEAR(a.x, b.x, tolerance) << "pixel " << x << ", " << y;
+          EXPECT_NEAR(a.y, b.y, tolerance) << "pixel " << x << ", " << y;
+          EXPECT_NEAR(a.z, b.z, tolerance) << "pixel " << x << ", " << y;
+          EXPECT_NEAR(a.w, b.w, tolerance) << "pixel " << x << ", " << y;
+        }
+      }
+    }
+  }
+};
+
+TEST_F(RenderImageTextureCache, srgb_byte)
+{
+  const string filepath = write_test_image("cycles_texture_cache_srgb.png", TypeDesc::UINT8, 3);
+  compare_loaded_and_cached(filepath, u_colorspace_srgb, 1e-6f);
+}
+
+TEST_F(RenderImageTextureCache, float_rgb)
+{
+  const string filepath = write_test_image("cycles_texture_cache_float.exr", TypeDesc::FLOAT, 3);
+  compare_loaded_and_cached(filepath, u_colorspace_raw, 1e-6f);
+}
+
+TEST_F(RenderImageTextureCache, alpha)
+{
+  /* Alpha is associated in 8 bit when loading fully, which rounds differently. */
+  const string filepath = write_test_image("cycles_texture_cache_alpha.png", TypeDesc::UINT8, 4);
+  compare_loaded_and_cached(filepath, u_colorspace_srgb, 1.0f / 255.0f + 1e-6f);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,15 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#define __KERNEL_SSE__
+#define __KERNEL_AVX__
+#define __KERNEL_AVX2__
+#define __KERNEL_AVX512__
+
+#define TEST_CATEGORY_NAME util_avx512
+
+#if (defined(i386) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_X64)) && \
+    defined(__AVX512F__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
+#  include "util_float8_test.h"
+#endif
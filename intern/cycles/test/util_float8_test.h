@@ -12,7 +12,9 @@ CCL_NAMESPACE_BEGIN
 static bool validate_cpu_capabilities()
 {
 
-#if defined(__KERNEL_AVX2__)
+#if defined(__KERNEL_AVX512__)
+  return system_cpu_support_avx512();
+#elif defined(__KERNEL_AVX2__)
   return system_cpu_support_avx2();
 #elif defined(__KERNEL_AVX__)
   return system_cpu_support_avx();
@@ -103,6 +105,25 @@ TEST(TEST_CATEGORY_NAME, float8_min_max)
   compare_vector_vector(max(float8_a(), float8_b()), float8_b());
 }
 
+TEST(TEST_CATEGORY_NAME, float8_safe_divide)
+{
+  INIT_FLOAT8_TEST
+  const vfloat8 b = make_vfloat8(1.0f, 0.0f, 3.0f, 0.0f, 5.0f, -0.0f, 7.0f, 8.0f);
+  compare_vector_vector(safe_divide(float8_b(), b),
+                        make_vfloat8(1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f));
+}
+
+TEST(TEST_CATEGORY_NAME, float8_ensure_finite)
+{
+  INIT_FLOAT8_TEST
+  const vfloat8 a = make_vfloat8(
+      1.0f, FLT_MAX, INFINITY, -INFINITY, NAN, -2.0f, 0.0f, __uint_as_float(0x7f800001));
+  EXPECT_FALSE(isfinite_safe(a));
+  EXPECT_TRUE(isfinite_safe(float8_a()));
+  compare_vector_vector(ensure_finite(a),
+                        make_vfloat8(1.0f, FLT_MAX, 0.0f, 0.0f, 0.0f, -2.0f, 0.0f, 0.0f));
+}
+
 TEST(TEST_CATEGORY_NAME, float8_shuffle)
 {
   INIT_FLOAT8_TEST
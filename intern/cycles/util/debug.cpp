@@ -29,6 +29,7 @@ void DebugFlags::CPU::reset()
     } \
   } while (0)
 
+  CHECK_CPU_FLAGS(avx512, "CYCLES_CPU_NO_AVX512");
   CHECK_CPU_FLAGS(avx2, "CYCLES_CPU_NO_AVX2");
   CHECK_CPU_FLAGS(sse41, "CYCLES_CPU_NO_SSE41");
   CHECK_CPU_FLAGS(sse2, "CYCLES_CPU_NO_SSE2");
@@ -37,6 +38,10 @@ void DebugFlags::CPU::reset()
 #undef CHECK_CPU_FLAGS
 
   bvh_layout = BVH_LAYOUT_AUTO;
+
+  use_wavefront = false;
+  if (auto str = getenv("CYCLES_CPU_WAVEFRONT"))
+    use_wavefront = (atoi(str) != 0);
 }
 
 DebugFlags::CUDA::CUDA()
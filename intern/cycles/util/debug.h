@@ -25,6 +25,7 @@ class DebugFlags {
     void reset();
 
     /* Flags describing which instructions sets are allowed for use. */
+    bool avx512 = true;
     bool avx2 = true;
     bool sse41 = true;
     bool sse2 = true;
@@ -32,6 +33,10 @@ class DebugFlags {
     /* Check functions to see whether instructions up to the given one
      * are allowed for use.
      */
+    bool has_avx512()
+    {
+      return has_avx2() && avx512;
+    }
     bool has_avx2()
     {
       return has_sse41() && avx2;
@@ -51,6 +56,10 @@ class DebugFlags {
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout = BVH_LAYOUT_AUTO;
+
+    /* Render batches of paths one kernel at a time, with the paths sorted by the kernel they
+     * execute next, instead of running the megakernel for every path. */
+    bool use_wavefront = false;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
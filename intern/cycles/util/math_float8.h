@@ -171,7 +171,9 @@ ccl_device_inline const vfloat8 operator^(const vfloat8 a, const vfloat8 b)
 
 ccl_device_inline vfloat8 rcp(const vfloat8 a)
 {
-#ifdef __KERNEL_AVX__
+#if defined(__KERNEL_AVX512__)
+  return vfloat8(_mm256_rcp14_ps(a.m256));
+#elif defined(__KERNEL_AVX__)
   return vfloat8(_mm256_rcp_ps(a.m256));
 #else
   return make_vfloat8(1.0f / a.a,
@@ -368,6 +370,10 @@ ccl_device_inline vfloat8 safe_divide(const vfloat8 a, const float b)
 
 ccl_device_inline vfloat8 safe_divide(const vfloat8 a, const vfloat8 b)
 {
+#ifdef __KERNEL_AVX512__
+  const __mmask8 nonzero = _mm256_cmp_ps_mask(b.m256, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+  return vfloat8(_mm256_maskz_div_ps(nonzero, a.m256, b.m256));
+#else
   return make_vfloat8((b.a != 0.0f) ? a.a / b.a : 0.0f,
                       (b.b != 0.0f) ? a.b / b.b : 0.0f,
                       (b.c != 0.0f) ? a.c / b.c : 0.0f,
@@ -376,10 +382,23 @@ ccl_device_inline vfloat8 safe_divide(const vfloat8 a, const vfloat8 b)
                       (b.f != 0.0f) ? a.f / b.f : 0.0f,
                       (b.g != 0.0f) ? a.g / b.g : 0.0f,
                       (b.h != 0.0f) ? a.h / b.h : 0.0f);
+#endif
 }
 
+#ifdef __KERNEL_AVX512__
+/* Mask of lanes which are NaN or infinite. */
+ccl_device_forceinline __mmask8 non_finite_mask(const vfloat8 v)
+{
+  /* Quiet NaN, positive infinity, negative infinity and signaling NaN. */
+  return _mm256_fpclass_ps_mask(v.m256, 0x01 | 0x08 | 0x10 | 0x80);
+}
+#endif
+
 ccl_device_inline vfloat8 ensure_finite(vfloat8 v)
 {
+#ifdef __KERNEL_AVX512__
+  return vfloat8(_mm256_maskz_mov_ps(__mmask8(~non_finite_mask(v)), v.m256));
+#else
   v.a = ensure_finite(v.a);
   v.b = ensure_finite(v.b);
   v.c = ensure_finite(v.c);
@@ -390,12 +409,17 @@ ccl_device_inline vfloat8 ensure_finite(vfloat8 v)
   v.h = ensure_finite(v.h);
 
   return v;
+#endif
 }
 
 ccl_device_inline bool isfinite_safe(vfloat8 v)
 {
+#ifdef __KERNEL_AVX512__
+  return non_finite_mask(v) == 0;
+#else
   return isfinite_safe(v.a) && isfinite_safe(v.b) && isfinite_safe(v.c) && isfinite_safe(v.d) &&
          isfinite_safe(v.e) && isfinite_safe(v.f) && isfinite_safe(v.g) && isfinite_safe(v.h);
+#endif
 }
 
 ccl_device_inline vint8 cast(const vfloat8 a)
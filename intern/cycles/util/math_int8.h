@@ -226,7 +226,7 @@ ccl_device_forceinline const vint8 srl(const vint8 a, const int32_t b)
 
 ccl_device_inline vint8 min(vint8 a, vint8 b)
 {
-#  if defined(__KERNEL_AVX__) && defined(__KERNEL_AVX41__)
+#  ifdef __KERNEL_AVX2__
   return vint8(_mm256_min_epi32(a.m256, b.m256));
 #  else
   return make_vint8(min(a.a, b.a),
@@ -242,7 +242,7 @@ ccl_device_inline vint8 min(vint8 a, vint8 b)
 
 ccl_device_inline vint8 max(vint8 a, vint8 b)
 {
-#  if defined(__KERNEL_AVX__) && defined(__KERNEL_AVX41__)
+#  ifdef __KERNEL_AVX2__
   return vint8(_mm256_max_epi32(a.m256, b.m256));
 #  else
   return make_vint8(max(a.a, b.a),
@@ -20,6 +20,7 @@ int system_cpu_bits();
 bool system_cpu_support_sse2();
 bool system_cpu_support_sse41();
 bool system_cpu_support_avx2();
+bool system_cpu_support_avx512();
 
 size_t system_physical_ram();
 
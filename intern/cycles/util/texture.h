@@ -81,6 +81,8 @@ typedef struct TextureInfo {
   uint interpolation, extension;
   /* Dimensions. */
   uint width, height, depth;
+  /* Image is read on demand by the CPU texture cache, data points to a #TextureCacheImage. */
+  uint use_texture_cache;
   /* Transform for 3D textures. */
   uint use_transform_3d;
   Transform transform_3d;
@@ -173,6 +173,46 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Memory tags attribute memory usage to allocation names and tag scopes. This works in release
+ * builds, but only with the lock-free allocator. Only blocks allocated while the tags are enabled
+ * are counted.
+ */
+void MEM_use_memory_tags(bool enabled);
+bool MEM_memory_tags_enabled(void);
+
+/**
+ * Set the scope that following allocations of the calling thread are attributed to, e.g. an ID
+ * type name or a subsystem. The scope must be a static string. Returns the previous scope, which
+ * should be restored afterwards.
+ */
+const char *MEM_tag_scope_set(const char *scope);
+
+typedef struct MEM_TagStats {
+  const char *name;
+  /** May be null for allocations outside of any scope. */
+  const char *scope;
+  size_t mem_in_use;
+  size_t blocks_in_use;
+  /** Accumulated since the tags were enabled, to compute allocation rates. */
+  size_t alloc_num;
+  size_t alloc_bytes;
+} MEM_TagStats;
+
+/**
+ * Call the function for every combination of allocation name and scope that has been used.
+ * Different name pointers with the same text are reported separately.
+ */
+void MEM_memory_tags_foreach(void (*func)(const MEM_TagStats *stats, void *user_data),
+                             void *user_data);
+/**
+ * Length of the prefix of an allocation name that is used to group allocations, which is the
+ * first word (separated by a space, underscore, colon or parenthesis).
+ */
+size_t MEM_memory_tag_prefix_len(const char *name);
+/** Print the memory usage grouped by scope and by name prefix. */
+void MEM_memory_tags_print(void);
+
 #ifdef __cplusplus
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -110,6 +110,18 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Memory tags, see `memory_tags.cc`. The lock-free allocator stores the tag in the upper bits of
+ * the block length, which are never used by real allocations on 64 bit platforms. */
+#define MEMHEAD_TAG_SHIFT 48
+#define MEMHEAD_TAG_NUM (1 << 16)
+#define MEMHEAD_LEN_MASK ((((size_t)1) << MEMHEAD_TAG_SHIFT) - 1)
+
+extern bool memory_tags_enabled;
+/** Returns the tag to store in the block, 0 when the block is not tracked. */
+uint16_t memory_tag_block_alloc(const char *name, size_t size);
+void memory_tag_block_free(uint16_t tag, size_t size);
+const char *memory_tag_name(uint16_t tag);
+
 void memory_usage_init(void);
 void memory_usage_block_alloc(size_t size);
 void memory_usage_block_free(size_t size);
@@ -44,7 +44,47 @@ enum {
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
+
+/* Memory tags need the upper bits of the length, which are only free on 64 bit platforms. */
+#if SIZE_MAX > 0xFFFFFFFFu
+#  define USE_MEMORY_TAGS
+#endif
+
+#ifdef USE_MEMORY_TAGS
+#  define MEMHEAD_LEN(memhead) \
+    ((memhead)->len & MEMHEAD_LEN_MASK & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
+#  define MEMHEAD_TAG(memhead) ((uint16_t)((memhead)->len >> MEMHEAD_TAG_SHIFT))
+#else
+#  define MEMHEAD_LEN(memhead) ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
+#endif
+
+/** Length of a new block, with its memory tag if tags are used. */
+MEM_INLINE size_t memhead_len_with_tag(size_t len, const char *str)
+{
+#ifdef USE_MEMORY_TAGS
+  if (UNLIKELY(memory_tags_enabled) && len <= MEMHEAD_LEN_MASK) {
+    const uint16_t tag = memory_tag_block_alloc(str, len);
+    return len | ((size_t)tag << MEMHEAD_TAG_SHIFT);
+  }
+#else
+  (void)str;
+#endif
+  return len;
+}
+
+/** Name of the existing block to use for a re-allocation, so it keeps being attributed to it. */
+MEM_INLINE const char *memhead_tag_name(const MemHead *memh, const char *str)
+{
+#ifdef USE_MEMORY_TAGS
+  const uint16_t tag = MEMHEAD_TAG(memh);
+  if (tag != 0) {
+    return memory_tag_name(tag);
+  }
+#else
+  (void)memh;
+#endif
+  return str;
+}
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -92,6 +132,11 @@ void MEM_lockfree_freeN(void *vmemh)
   size_t len = MEMHEAD_LEN(memh);
 
   memory_usage_block_free(len);
+#ifdef USE_MEMORY_TAGS
+  if (UNLIKELY(MEMHEAD_TAG(memh) != 0)) {
+    memory_tag_block_free(MEMHEAD_TAG(memh), len);
+  }
+#endif
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -114,10 +159,10 @@ void *MEM_lockfree_dupallocN(const void *vmemh)
     if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
       newp = MEM_lockfree_mallocN_aligned(
-          prev_size, (size_t)memh_aligned->alignment, "dupli_malloc");
+          prev_size, (size_t)memh_aligned->alignment, memhead_tag_name(memh, "dupli_malloc"));
     }
     else {
-      newp = MEM_lockfree_mallocN(prev_size, "dupli_malloc");
+      newp = MEM_lockfree_mallocN(prev_size, memhead_tag_name(memh, "dupli_malloc"));
     }
     memcpy(newp, vmemh, prev_size);
   }
@@ -133,11 +178,12 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "realloc");
+      newp = MEM_lockfree_mallocN(len, memhead_tag_name(memh, "realloc"));
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+      newp = MEM_lockfree_mallocN_aligned(
+          len, (size_t)memh_aligned->alignment, memhead_tag_name(memh, "realloc"));
     }
 
     if (newp) {
@@ -169,11 +215,12 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
-      newp = MEM_lockfree_mallocN(len, "recalloc");
+      newp = MEM_lockfree_mallocN(len, memhead_tag_name(memh, "recalloc"));
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "recalloc");
+      newp = MEM_lockfree_mallocN_aligned(
+          len, (size_t)memh_aligned->alignment, memhead_tag_name(memh, "recalloc"));
     }
 
     if (newp) {
@@ -210,7 +257,7 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    memh->len = memhead_len_with_tag(len, str);
     memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
@@ -253,7 +300,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
+    memh->len = memhead_len_with_tag(len, str);
     memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
@@ -321,7 +368,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->len = memhead_len_with_tag(len, str) | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
     memory_usage_block_alloc(len);
 
@@ -0,0 +1,261 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory tags attribute the memory usage to allocation names and to the current tag scope of the
+ * allocating thread (see #MEM_tag_scope_set). Every combination of name and scope gets a slot in
+ * a fixed size table, the index of the slot is stored in the header of the allocated block so
+ * that it can be found again when the block is freed.
+ *
+ * Names are identified by their pointer, which is also why allocation names have to be static
+ * strings. Different pointers to equal strings are only merged when the statistics are queried.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+namespace {
+
+/**
+ * Counters of a single name and scope combination. Aligned to a cache line, because counters of
+ * different slots are updated by different threads all the time.
+ */
+struct alignas(64) TagSlot {
+  /** 0: unused, 1: key is being written, 2: key is valid. */
+  std::atomic<int> state = 0;
+  const char *name = nullptr;
+  const char *scope = nullptr;
+
+  /** Can be temporarily negative when blocks are freed on another thread than allocated. */
+  std::atomic<int64_t> mem_in_use = 0;
+  std::atomic<int64_t> blocks_in_use = 0;
+  /** Accumulated since the tags were enabled, used to compute allocation rates. */
+  std::atomic<int64_t> alloc_num = 0;
+  std::atomic<int64_t> alloc_bytes = 0;
+};
+
+/** Slot 0 is never used, it marks blocks that are not tracked. */
+constexpr int64_t slots_num = MEMHEAD_TAG_NUM;
+/** Limit linear probing, when the table is that full further allocations are not tracked. */
+constexpr int64_t max_probes = 64;
+
+/** Small per-thread cache to avoid probing the table for the names used most often. */
+struct LocalCacheItem {
+  const char *name = nullptr;
+  const char *scope = nullptr;
+  uint16_t tag = 0;
+};
+constexpr uintptr_t local_cache_size = 64;
+
+}  // namespace
+
+bool memory_tags_enabled = false;
+
+/** Allocated when the tags are enabled for the first time, never freed. */
+static std::atomic<TagSlot *> tag_slots = nullptr;
+
+static thread_local const char *current_scope = nullptr;
+static thread_local LocalCacheItem local_cache[local_cache_size];
+
+static uint64_t tag_key_hash(const char *name, const char *scope)
+{
+  /* Pointers to static strings, the lower bits are not very random. */
+  const uint64_t a = uint64_t(uintptr_t(name)) * 0x9E3779B97F4A7C15ull;
+  const uint64_t b = uint64_t(uintptr_t(scope)) * 0xC2B2AE3D27D4EB4Full;
+  return (a ^ (b >> 7)) >> 17;
+}
+
+static uint16_t tag_slot_ensure(TagSlot *slots, const char *name, const char *scope)
+{
+  const uint64_t hash = tag_key_hash(name, scope);
+  for (int64_t probe = 0; probe < max_probes; probe++) {
+    const int64_t index = int64_t((hash + uint64_t(probe)) % uint64_t(slots_num - 1)) + 1;
+    TagSlot &slot = slots[index];
+    int state = slot.state.load(std::memory_order_acquire);
+    if (state == 0) {
+      int expected = 0;
+      if (slot.state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+        slot.name = name;
+        slot.scope = scope;
+        slot.state.store(2, std::memory_order_release);
+        return uint16_t(index);
+      }
+      state = expected;
+    }
+    /* Another thread is writing the key, it only takes a moment. */
+    while (state == 1) {
+      state = slot.state.load(std::memory_order_acquire);
+    }
+    if (slot.name == name && slot.scope == scope) {
+      return uint16_t(index);
+    }
+  }
+  return 0;
+}
+
+uint16_t memory_tag_block_alloc(const char *name, const size_t size)
+{
+  TagSlot *slots = tag_slots.load(std::memory_order_acquire);
+  if (slots == nullptr) {
+    return 0;
+  }
+  const char *scope = current_scope;
+  LocalCacheItem &cache_item =
+      local_cache[((uintptr_t(name) >> 4) ^ (uintptr_t(scope) >> 6)) % local_cache_size];
+  uint16_t tag;
+  if (cache_item.tag != 0 && cache_item.name == name && cache_item.scope == scope) {
+    tag = cache_item.tag;
+  }
+  else {
+    tag = tag_slot_ensure(slots, name, scope);
+    if (tag == 0) {
+      return 0;
+    }
+    cache_item = {name, scope, tag};
+  }
+  TagSlot &slot = slots[tag];
+  slot.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+  slot.blocks_in_use.fetch_add(1, std::memory_order_relaxed);
+  slot.alloc_num.fetch_add(1, std::memory_order_relaxed);
+  slot.alloc_bytes.fetch_add(int64_t(size), std::memory_order_relaxed);
+  return tag;
+}
+
+void memory_tag_block_free(const uint16_t tag, const size_t size)
+{
+  TagSlot &slot = tag_slots.load(std::memory_order_relaxed)[tag];
+  slot.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
+  slot.blocks_in_use.fetch_sub(1, std::memory_order_relaxed);
+}
+
+const char *memory_tag_name(const uint16_t tag)
+{
+  return tag_slots.load(std::memory_order_relaxed)[tag].name;
+}
+
+void MEM_use_memory_tags(const bool enabled)
+{
+  if (enabled && tag_slots.load() == nullptr) {
+    /* Uses the system allocator, the table must not be tracked by itself. */
+    TagSlot *slots = new TagSlot[slots_num];
+    TagSlot *expected = nullptr;
+    if (!tag_slots.compare_exchange_strong(expected, slots)) {
+      delete[] slots;
+    }
+  }
+  memory_tags_enabled = enabled;
+}
+
+bool MEM_memory_tags_enabled(void)
+{
+  return memory_tags_enabled;
+}
+
+const char *MEM_tag_scope_set(const char *scope)
+{
+  const char *old_scope = current_scope;
+  current_scope = scope;
+  return old_scope;
+}
+
+void MEM_memory_tags_foreach(void (*func)(const MEM_TagStats *stats, void *user_data),
+                             void *user_data)
+{
+  TagSlot *slots = tag_slots.load(std::memory_order_acquire);
+  if (slots == nullptr) {
+    return;
+  }
+  for (int64_t i = 1; i < slots_num; i++) {
+    const TagSlot &slot = slots[i];
+    if (slot.state.load(std::memory_order_acquire) != 2) {
+      continue;
+    }
+    MEM_TagStats stats;
+    stats.name = slot.name;
+    stats.scope = slot.scope;
+    stats.mem_in_use = size_t(
+        std::max<int64_t>(slot.mem_in_use.load(std::memory_order_relaxed), 0));
+    stats.blocks_in_use = size_t(
+        std::max<int64_t>(slot.blocks_in_use.load(std::memory_order_relaxed), 0));
+    stats.alloc_num = size_t(slot.alloc_num.load(std::memory_order_relaxed));
+    stats.alloc_bytes = size_t(slot.alloc_bytes.load(std::memory_order_relaxed));
+    func(&stats, user_data);
+  }
+}
+
+size_t MEM_memory_tag_prefix_len(const char *name)
+{
+  size_t len = 0;
+  while (name[len] != '\0' && !strchr(" _:(", name[len])) {
+    len++;
+  }
+  /* Names that start with a separator are used as a whole. */
+  return len == 0 ? strlen(name) : len;
+}
+
+namespace {
+struct PrintStats {
+  int64_t mem_in_use = 0;
+  int64_t blocks_in_use = 0;
+  int64_t alloc_num = 0;
+};
+struct PrintTables {
+  std::map<std::string, PrintStats> by_scope;
+  std::map<std::string, PrintStats> by_prefix;
+};
+}  // namespace
+
+static void print_stats_table(const char *title, const std::map<std::string, PrintStats> &stats)
+{
+  std::vector<std::pair<std::string, PrintStats>> sorted(stats.begin(), stats.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    return a.second.mem_in_use > b.second.mem_in_use;
+  });
+  printf("%s:\n", title);
+  printf("  %12s %10s %12s  %s\n", "MB in use", "blocks", "allocations", "name");
+  for (const auto &[key, item] : sorted) {
+    if (item.mem_in_use == 0 && item.blocks_in_use == 0) {
+      continue;
+    }
+    printf("  %12.3f %10lld %12lld  %s\n",
+           double(item.mem_in_use) / (1024.0 * 1024.0),
+           (long long)item.blocks_in_use,
+           (long long)item.alloc_num,
+           key.c_str());
+  }
+}
+
+void MEM_memory_tags_print(void)
+{
+  PrintTables tables;
+  MEM_memory_tags_foreach(
+      [](const MEM_TagStats *stats, void *user_data) {
+        PrintTables &result = *static_cast<PrintTables *>(user_data);
+        const std::string scope = stats->scope ? stats->scope : "<none>";
+        const std::string prefix(stats->name, MEM_memory_tag_prefix_len(stats->name));
+        for (PrintStats *item : {&result.by_scope[scope], &result.by_prefix[prefix]}) {
+          item->mem_in_use += int64_t(stats->mem_in_use);
+          item->blocks_in_use += int64_t(stats->blocks_in_use);
+          item->alloc_num += int64_t(stats->alloc_num);
+        }
+      },
+      &tables);
+
+  printf("Memory usage by tag (total %.3f MB):\n",
+         double(memory_usage_current()) / (1024.0 * 1024.0));
+  print_stats_table("By scope", tables.by_scope);
+  print_stats_table("By name prefix", tables.by_prefix);
+}
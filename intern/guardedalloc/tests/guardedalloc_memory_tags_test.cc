@@ -0,0 +1,81 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+struct TagQuery {
+  const char *name;
+  const char *scope;
+  MEM_TagStats stats;
+};
+
+MEM_TagStats find_tag_stats(const char *name, const char *scope)
+{
+  TagQuery query = {name, scope, {}};
+  MEM_memory_tags_foreach(
+      [](const MEM_TagStats *stats, void *user_data) {
+        TagQuery &query = *static_cast<TagQuery *>(user_data);
+        if (stats->name == query.name && stats->scope == query.scope) {
+          query.stats = *stats;
+        }
+      },
+      &query);
+  return query.stats;
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_memory_tags)
+{
+  if (sizeof(size_t) < 8) {
+    GTEST_SKIP();
+  }
+  static const char *name = "memory_tags_test";
+  static const char *scope = "MemoryTagsTest";
+
+  MEM_use_memory_tags(true);
+  const char *old_scope = MEM_tag_scope_set(scope);
+  void *a = MEM_mallocN(100, name);
+  void *b = MEM_callocN(52, name);
+  void *c = MEM_mallocN_aligned(64, 32, name);
+  MEM_tag_scope_set(old_scope);
+
+  MEM_TagStats stats = find_tag_stats(name, scope);
+  EXPECT_EQ(stats.mem_in_use, 216);
+  EXPECT_EQ(stats.blocks_in_use, 3);
+  EXPECT_EQ(stats.alloc_num, 3);
+  EXPECT_EQ(MEM_allocN_len(a), 100);
+  EXPECT_EQ(MEM_allocN_len(c), 64);
+
+  /* Re-allocations keep the name of the original block. */
+  a = MEM_reallocN(a, 200);
+  stats = find_tag_stats(name, nullptr);
+  EXPECT_EQ(stats.mem_in_use, 200);
+
+  MEM_freeN(a);
+  MEM_freeN(b);
+  MEM_freeN(c);
+  stats = find_tag_stats(name, scope);
+  EXPECT_EQ(stats.mem_in_use, 0);
+  EXPECT_EQ(stats.blocks_in_use, 0);
+  EXPECT_EQ(stats.alloc_bytes, 216);
+
+  MEM_use_memory_tags(false);
+}
+
+TEST(guardedalloc, MEM_memory_tag_prefix_len)
+{
+  EXPECT_EQ(MEM_memory_tag_prefix_len("Mesh vertices"), 4);
+  EXPECT_EQ(MEM_memory_tag_prefix_len("CDMVert_data"), 7);
+  EXPECT_EQ(MEM_memory_tag_prefix_len("read_struct"), 4);
+  EXPECT_EQ(MEM_memory_tag_prefix_len("name"), 4);
+  EXPECT_EQ(MEM_memory_tag_prefix_len("_leading"), 8);
+}
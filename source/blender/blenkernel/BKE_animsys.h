@@ -273,6 +273,11 @@ void BKE_animsys_nla_remap_keyframe_values(struct NlaKeyframingContext *context,
  */
 void BKE_animsys_free_nla_keyframing_context_cache(struct ListBase *cache);
 
+/**
+ * Free the NLA evaluation channels which are kept in the animation data between evaluations.
+ */
+void BKE_animsys_free_nla_eval_cache(struct AnimData *adt);
+
 /* ************************************* */
 /* Evaluation API */
 
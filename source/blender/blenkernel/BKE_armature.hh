@@ -13,7 +13,9 @@
 #include "BKE_armature.h"
 
 #include "BLI_function_ref.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_set.hh"
+#include "BLI_vector.hh"
 
 namespace blender::bke {
 
@@ -33,4 +35,40 @@ using BoneNameSet = blender::Set<std::string>;
  */
 BoneNameSet BKE_armature_find_selected_bone_names(const bArmature *armature);
 
+/**
+ * Order in which the bones of a pose without constraints are evaluated by
+ * #pose_eval_bones_batched. Bones are referenced by their index in the list of pose channels.
+ */
+struct PoseEvalBatch {
+  /** Bones evaluated first, one after another. Parents come before their children. */
+  Vector<int> serial_bones;
+  /**
+   * Groups of whole sub-trees which don't depend on each other, evaluated in parallel once all
+   * serial bones are done. Within a group parents come before their children.
+   */
+  Vector<int> group_bones;
+  Vector<int> group_offsets;
+
+  OffsetIndices<int> groups() const
+  {
+    return group_offsets.as_span();
+  }
+};
+
+/**
+ * Split the bone hierarchy of the pose into sub-trees which can be evaluated independently.
+ * Large sub-trees are split further by moving their root bones to the serial part.
+ */
+PoseEvalBatch pose_eval_batch_build(const bPose &pose);
+
+/**
+ * Evaluate the pose space transforms of all bones, with the same result as evaluating
+ * #BKE_pose_eval_bone followed by #BKE_pose_bone_done for every bone. Only valid for poses
+ * without constraints, and therefore without IK or Spline IK chains.
+ */
+void pose_eval_bones_batched(Depsgraph *depsgraph,
+                             Scene *scene,
+                             Object *object,
+                             const PoseEvalBatch &batch);
+
 };  // namespace blender::bke
@@ -119,6 +119,11 @@ typedef struct bCallbackFuncStore {
   void (*func)(struct Main *, struct PointerRNA **, int num_pointers, void *arg);
   void *arg;
   short alloc;
+  /**
+   * Optional, returns false when calling `func` would have no effect. Allows callers to skip work
+   * that is only needed to run the callbacks. The callback is considered used when this is null.
+   */
+  bool (*poll)(void *arg);
 } bCallbackFuncStore;
 
 void BKE_callback_exec(struct Main *bmain,
@@ -132,6 +137,10 @@ void BKE_callback_exec_id_depsgraph(struct Main *bmain,
                                     struct Depsgraph *depsgraph,
                                     eCbEvent evt);
 void BKE_callback_exec_string(struct Main *bmain, eCbEvent evt, const char *str);
+/**
+ * Check whether executing the callbacks of the event would have any effect.
+ */
+bool BKE_callback_is_used(eCbEvent evt);
 void BKE_callback_add(bCallbackFuncStore *funcstore, eCbEvent evt);
 void BKE_callback_remove(bCallbackFuncStore *funcstore, eCbEvent evt);
 
@@ -807,8 +807,9 @@ size_t CustomData_get_elem_size(const struct CustomDataLayer *layer);
 
 #ifndef NDEBUG
 struct DynStr;
-/** Use to inspect mesh data when debugging. */
+/** Use to inspect mesh data when debugging, \a totelem is the number of elements of the layers. */
 void CustomData_debug_info_from_layers(const struct CustomData *data,
+                                       int totelem,
                                        const char *indent,
                                        struct DynStr *dynstr);
 #endif /* NDEBUG */
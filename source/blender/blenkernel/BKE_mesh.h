@@ -719,16 +719,11 @@ BLI_INLINE const MDeformVert *BKE_mesh_deform_verts(const Mesh *mesh)
 {
   return (const MDeformVert *)CustomData_get_layer(&mesh->vert_data, CD_MDEFORMVERT);
 }
-BLI_INLINE MDeformVert *BKE_mesh_deform_verts_for_write(Mesh *mesh)
-{
-  MDeformVert *dvert = (MDeformVert *)CustomData_get_layer_for_write(
-      &mesh->vert_data, CD_MDEFORMVERT, mesh->totvert);
-  if (dvert) {
-    return dvert;
-  }
-  return (MDeformVert *)CustomData_add_layer(
-      &mesh->vert_data, CD_MDEFORMVERT, CD_SET_DEFAULT, mesh->totvert);
-}
+/**
+ * Get the vertex group weights for writing, adding the layer if it does not exist yet. This also
+ * tags the caches which depend on the weights dirty.
+ */
+MDeformVert *BKE_mesh_deform_verts_for_write(Mesh *mesh);
 
 #ifdef __cplusplus
 }
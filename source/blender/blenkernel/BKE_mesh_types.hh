@@ -65,6 +65,49 @@ struct LooseEdgeCache : public LooseGeomCache {
 struct LooseVertCache : public LooseGeomCache {
 };
 
+/**
+ * The vertex group weights of all vertices in contiguous arrays, so that they can be read
+ * without following the pointer of every #MDeformVert. Used to deform meshes by armatures.
+ */
+struct VertexGroupWeightsCache : NonCopyable, NonMovable {
+  /**
+   * Weak reference to the implicit sharing info of the deform vertex layer the arrays were
+   * created from, and its version at that time. Writing to the layer either creates a new layer
+   * with a new sharing info or increases the version, so this detects outdated weights even when
+   * the cache was not tagged dirty. The weak user keeps the address from being reused.
+   */
+  const ImplicitSharingInfo *dverts_sharing_info = nullptr;
+  int64_t dverts_version = 0;
+  /** Start of the weights of every vertex in #groups and #weights, with the total at the end. */
+  Array<int> offsets;
+  Array<int> groups;
+  Array<float> weights;
+
+  VertexGroupWeightsCache() = default;
+  ~VertexGroupWeightsCache()
+  {
+    this->set_source(nullptr);
+  }
+
+  void set_source(const ImplicitSharingInfo *sharing_info)
+  {
+    if (dverts_sharing_info) {
+      dverts_sharing_info->remove_weak_user_and_delete_if_last();
+    }
+    dverts_sharing_info = sharing_info;
+    dverts_version = sharing_info ? sharing_info->version() : 0;
+    if (sharing_info) {
+      sharing_info->add_weak_user();
+    }
+  }
+
+  bool is_built_from(const ImplicitSharingInfo *sharing_info) const
+  {
+    return sharing_info != nullptr && sharing_info == dverts_sharing_info &&
+           sharing_info->version() == dverts_version;
+  }
+};
+
 struct MeshRuntime {
   /* Evaluated mesh for objects which do not have effective modifiers.
    * This mesh is used as a result of modifier stack evaluation.
@@ -157,6 +200,8 @@ struct MeshRuntime {
   SharedCache<LooseVertCache> loose_verts_cache;
   /** Cache of data about vertices not used by faces. See #Mesh::verts_no_face(). */
   SharedCache<LooseVertCache> verts_no_face_cache;
+  /** Cache of the vertex group weights, see #VertexGroupWeightsCache. */
+  SharedCache<VertexGroupWeightsCache> vertex_group_weights_cache;
 
   /**
    * A bit vector the size of the number of vertices, set to true for the center vertices of
@@ -0,0 +1,51 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Evaluation of a scene over a range of frames, for operations like baking and exporting which
+ * need the evaluated state of every frame but not in a specific order.
+ */
+
+#include "BLI_function_ref.hh"
+#include "BLI_index_range.hh"
+
+struct Depsgraph;
+
+namespace blender::bke {
+
+/**
+ * Check whether the evaluated state of the depsgraph at a frame only depends on the original data
+ * and the frame itself. This is not the case when there are simulations which step from the state
+ * of the previous frame (point caches, rigid bodies and simulation zones), or when frame change
+ * handlers may modify the original data.
+ */
+bool scene_graph_frames_are_independent(const Depsgraph *depsgraph);
+
+/**
+ * Evaluate the scene of the depsgraph at every frame of the range, and call \a frame_fn with a
+ * depsgraph evaluated at that frame.
+ *
+ * When the frames are independent (see #scene_graph_frames_are_independent), the range is split
+ * into chunks which are evaluated concurrently, each on its own depsgraph created by \a build_fn.
+ * These depsgraphs share the original data, only their evaluated copies are independent.
+ * \a build_fn should build the same graph as \a depsgraph without evaluating it, and is always
+ * called from the calling thread. \a frame_fn is then called from multiple threads at once, but
+ * the frames of a chunk are passed in order. Frame change handlers are not executed.
+ *
+ * Otherwise the frames are evaluated one after another on \a depsgraph itself, like
+ * #BKE_scene_graph_update_for_newframe does.
+ *
+ * The current frame of the scene is left unchanged, but \a depsgraph might be evaluated at
+ * another frame afterwards.
+ */
+void scene_graph_evaluate_frames(Depsgraph *depsgraph,
+                                 IndexRange frames,
+                                 FunctionRef<Depsgraph *()> build_fn,
+                                 FunctionRef<void(Depsgraph *depsgraph, int frame)> frame_fn);
+
+}  // namespace blender::bke
@@ -256,6 +256,9 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
       /* free driver array cache */
       MEM_SAFE_FREE(adt->driver_array);
 
+      /* free NLA evaluation cache */
+      BKE_animsys_free_nla_eval_cache(adt);
+
       /* free overrides */
       /* TODO... */
 
@@ -347,6 +350,7 @@ AnimData *BKE_animdata_copy(Main *bmain, AnimData *adt, const int flag)
   /* duplicate drivers (F-Curves) */
   BKE_fcurves_copy(&dadt->drivers, &adt->drivers);
   dadt->driver_array = nullptr;
+  dadt->nla_eval_cache = nullptr;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1482,6 +1486,7 @@ void BKE_animdata_blend_read_data(BlendDataReader *reader, ID *id)
   BLO_read_list(reader, &adt->drivers);
   BKE_fcurve_blend_read_data(reader, &adt->drivers);
   adt->driver_array = nullptr;
+  adt->nla_eval_cache = nullptr;
 
   /* link overrides */
   /* TODO... */
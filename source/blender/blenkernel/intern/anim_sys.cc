@@ -552,6 +552,47 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/**
+ * Result of resolving the RNA path of the previous F-Curve. F-Curves of the same property (e.g.
+ * `location[0]` to `location[2]`) are usually stored next to each other, and only differ in the
+ * array index, so they can share the expensive part of resolving the path.
+ */
+struct AnimsysPathResolveCache {
+  const char *rna_path = nullptr;
+  bool is_resolved = false;
+  PathResolvedRNA resolved;
+};
+
+/* Same as #BKE_animsys_rna_path_resolve, re-using the result for the same path if possible. */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            AnimsysPathResolveCache &cache,
+                                            PathResolvedRNA *r_result)
+{
+  if (rna_path == nullptr) {
+    return false;
+  }
+
+  if (cache.rna_path == nullptr || !STREQ(cache.rna_path, rna_path)) {
+    cache.rna_path = rna_path;
+    /* Index zero never fails the array index check. */
+    cache.is_resolved = BKE_animsys_rna_path_resolve(ptr, rna_path, 0, &cache.resolved);
+  }
+  if (!cache.is_resolved) {
+    return false;
+  }
+
+  *r_result = cache.resolved;
+  const int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  if (array_len && array_index >= array_len) {
+    /* Let the regular function report the invalid index. */
+    return BKE_animsys_rna_path_resolve(ptr, rna_path, array_index, r_result);
+  }
+  r_result->prop_index = array_len ? array_index : -1;
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -562,6 +603,12 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  PointerRNA ptr_orig;
+  const bool has_orig = flush_to_original && animsys_construct_orig_pointer_rna(ptr, &ptr_orig);
+
+  AnimsysPathResolveCache path_cache;
+  AnimsysPathResolveCache orig_path_cache;
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -570,11 +617,20 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, fcu->rna_path, fcu->array_index, path_cache, &anim_rna))
+    {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+
+      PathResolvedRNA orig_anim_rna;
+      if (has_orig && animsys_rna_path_resolve_cached(&ptr_orig,
+                                                      fcu->rna_path,
+                                                      fcu->array_index,
+                                                      orig_path_cache,
+                                                      &orig_anim_rna))
+      {
+        BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
       }
     }
   }
@@ -3531,26 +3587,117 @@ static void animsys_evaluate_nla_for_keyframing(PointerRNA *ptr,
   BLI_freelistN(&lower_estrips);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name NLA Evaluation Cache
+ *
+ * The evaluation channels of an NLA stack and their domain only depend on the structure of the
+ * stack and the F-Curves of its actions, but resolving the RNA paths of all F-Curves is a large
+ * part of the evaluation cost. The depsgraph keeps evaluated copies of the animated data around
+ * between frames, so for evaluated objects the channels are kept in #AnimData.nla_eval_cache.
+ * Changes to the NLA stack itself tag the copy-on-write component of the object, which frees the
+ * animation data along with the cache.
+ * \{ */
+
+static bool nla_strips_use_changed_action(const ListBase *strips)
+{
+  LISTBASE_FOREACH (const NlaStrip *, strip, strips) {
+    if (strip->act != nullptr && strip->act->id.recalc != 0) {
+      return true;
+    }
+    if (nla_strips_use_changed_action(&strip->strips)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* The channels point to the paths of F-Curves in the evaluated actions, which are re-copied when
+ * any of the actions is tagged for an update. */
+static bool nla_eval_cache_is_valid(const AnimData *adt)
+{
+  for (const bAction *action : {adt->action, adt->tmpact}) {
+    if (action != nullptr && action->id.recalc != 0) {
+      return false;
+    }
+  }
+  LISTBASE_FOREACH (const NlaTrack *, nlt, &adt->nla_tracks) {
+    if (nla_strips_use_changed_action(&nlt->strips)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Channels can only be kept when all the data they point to is owned by the evaluated object,
+ * otherwise it might be freed or re-allocated without invalidating the cache. */
+static bool nla_eval_cache_can_keep(const NlaEvalData *echannels, const ID *id)
+{
+  if (GS(id->name) != ID_OB) {
+    return false;
+  }
+  LISTBASE_FOREACH (const NlaEvalChannel *, nec, &echannels->channels) {
+    if (nec->key.ptr.owner_id != id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BKE_animsys_free_nla_eval_cache(AnimData *adt)
+{
+  if (adt->nla_eval_cache == nullptr) {
+    return;
+  }
+  nlaeval_free(adt->nla_eval_cache);
+  MEM_freeN(adt->nla_eval_cache);
+  adt->nla_eval_cache = nullptr;
+}
+
+/** \} */
+
 /* NLA Evaluation function (mostly for use through do_animdata)
  * - All channels that will be affected are not cleared anymore. Instead, we just evaluate into
  *   some temp channels, where values can be accumulated in one go.
+ * - When `use_cache` is set, the channels are re-used from and kept in the animation data.
  */
 static void animsys_calculate_nla(PointerRNA *ptr,
                                   AnimData *adt,
                                   const AnimationEvalContext *anim_eval_context,
-                                  const bool flush_to_original)
+                                  const bool flush_to_original,
+                                  const bool use_cache)
 {
-  NlaEvalData echannels;
+  NlaEvalData local_echannels;
+  NlaEvalData *echannels = &local_echannels;
+  bool is_cached = false;
 
-  nlaeval_init(&echannels);
+  if (use_cache) {
+    if (adt->nla_eval_cache != nullptr && !nla_eval_cache_is_valid(adt)) {
+      BKE_animsys_free_nla_eval_cache(adt);
+    }
+    if (adt->nla_eval_cache == nullptr) {
+      adt->nla_eval_cache = static_cast<NlaEvalData *>(
+          MEM_mallocN(sizeof(NlaEvalData), "AnimData::nla_eval_cache"));
+      nlaeval_init(adt->nla_eval_cache);
+    }
+    else {
+      is_cached = true;
+    }
+    echannels = adt->nla_eval_cache;
+  }
+  else {
+    nlaeval_init(echannels);
+  }
 
   /* evaluate the NLA stack, obtaining a set of values to flush */
-  if (animsys_evaluate_nla_for_flush(&echannels, ptr, adt, anim_eval_context, flush_to_original)) {
-    /* reset any channels touched by currently inactive actions to default value */
-    animsys_evaluate_nla_domain(ptr, &echannels, adt);
+  if (animsys_evaluate_nla_for_flush(echannels, ptr, adt, anim_eval_context, flush_to_original)) {
+    /* reset any channels touched by currently inactive actions to default value,
+     * the domain of cached channels is already known */
+    if (!is_cached) {
+      animsys_evaluate_nla_domain(ptr, echannels, adt);
+    }
 
     /* flush effects of accumulating channels in NLA to the actual data they affect */
-    nladata_flush_channels(ptr, &echannels, &echannels.eval_snapshot, flush_to_original);
+    nladata_flush_channels(ptr, echannels, &echannels->eval_snapshot, flush_to_original);
   }
   else {
     /* special case - evaluate as if there isn't any NLA data */
@@ -3560,10 +3707,25 @@ static void animsys_calculate_nla(PointerRNA *ptr,
     }
 
     animsys_evaluate_action(ptr, adt->action, anim_eval_context, flush_to_original);
+
+    /* the domain has not been evaluated, so the channels are incomplete */
+    if (use_cache) {
+      BKE_animsys_free_nla_eval_cache(adt);
+      return;
+    }
+  }
+
+  if (use_cache) {
+    /* only the blended values are specific to this frame */
+    nlaeval_snapshot_free_data(&echannels->eval_snapshot);
+    if (!is_cached && !nla_eval_cache_can_keep(echannels, ptr->owner_id)) {
+      BKE_animsys_free_nla_eval_cache(adt);
+    }
+    return;
   }
 
   /* free temp data */
-  nlaeval_free(&echannels);
+  nlaeval_free(echannels);
 }
 
 /* ---------------------- */
@@ -3897,11 +4059,12 @@ static void animsys_evaluate_overrides(PointerRNA *ptr, AnimData *adt)
  *   However, the code for this is relatively harmless, so is left in the code for now.
  */
 
-void BKE_animsys_evaluate_animdata(ID *id,
-                                   AnimData *adt,
-                                   const AnimationEvalContext *anim_eval_context,
-                                   eAnimData_Recalc recalc,
-                                   const bool flush_to_original)
+static void animsys_evaluate_animdata(ID *id,
+                                      AnimData *adt,
+                                      const AnimationEvalContext *anim_eval_context,
+                                      eAnimData_Recalc recalc,
+                                      const bool flush_to_original,
+                                      const bool use_nla_cache)
 {
 
   /* sanity checks */
@@ -3923,7 +4086,7 @@ void BKE_animsys_evaluate_animdata(ID *id,
       /* evaluate NLA-stack
        * - active action is evaluated as part of the NLA stack as the last item
        */
-      animsys_calculate_nla(&id_ptr, adt, anim_eval_context, flush_to_original);
+      animsys_calculate_nla(&id_ptr, adt, anim_eval_context, flush_to_original, use_nla_cache);
     }
     /* evaluate Active Action only */
     else if (adt->action) {
@@ -3949,6 +4112,15 @@ void BKE_animsys_evaluate_animdata(ID *id,
   animsys_evaluate_overrides(&id_ptr, adt);
 }
 
+void BKE_animsys_evaluate_animdata(ID *id,
+                                   AnimData *adt,
+                                   const AnimationEvalContext *anim_eval_context,
+                                   eAnimData_Recalc recalc,
+                                   const bool flush_to_original)
+{
+  animsys_evaluate_animdata(id, adt, anim_eval_context, recalc, flush_to_original, false);
+}
+
 void BKE_animsys_evaluate_all_animation(Main *main, Depsgraph *depsgraph, float ctime)
 {
   ID *id;
@@ -4108,7 +4280,8 @@ void BKE_animsys_eval_animdata(Depsgraph *depsgraph, ID *id)
 
   const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(depsgraph,
                                                                                     ctime);
-  BKE_animsys_evaluate_animdata(id, adt, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original);
+  /* The evaluated copy of the ID persists between frames, allowing to keep NLA channels. */
+  animsys_evaluate_animdata(id, adt, &anim_eval_context, ADT_RECALC_ANIM, flush_to_original, true);
 }
 
 void BKE_animsys_update_driver_array(ID *id)
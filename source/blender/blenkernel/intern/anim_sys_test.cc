@@ -0,0 +1,177 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "tests/scene_test_base.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_index_range.hh"
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+
+#include "DNA_anim_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_action.h"
+#include "BKE_anim_data.h"
+#include "BKE_animsys.h"
+#include "BKE_fcurve.h"
+#include "BKE_nla.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+#include "DEG_depsgraph_query.h"
+
+namespace blender::bke::tests {
+
+class NlaEvalCacheTest : public SceneTestBase {
+ protected:
+  Object *object = nullptr;
+
+  void SetUp() override
+  {
+    SceneTestBase::SetUp();
+    object = add_object(OB_EMPTY, "Object");
+    BKE_animdata_ensure_id(&object->id);
+  }
+
+  /* An action changing a transform channel of the object linearly from zero at frame 1 to the
+   * given value at frame 11. */
+  bAction *add_action(const char *rna_path, const int array_index, const float value)
+  {
+    bAction *action = BKE_action_add(bmain, "Action");
+    add_fcurve(action, rna_path, array_index, value);
+    return action;
+  }
+
+  void add_fcurve(bAction *action, const char *rna_path, const int array_index, const float value)
+  {
+    FCurve *fcu = BKE_fcurve_create();
+    fcu->rna_path = BLI_strdup(rna_path);
+    fcu->array_index = array_index;
+    fcu->totvert = 2;
+    fcu->bezt = static_cast<BezTriple *>(MEM_callocN(sizeof(BezTriple) * 2, "BezTriples"));
+    fcu->bezt[0].vec[1][0] = 1.0f;
+    fcu->bezt[1].vec[1][0] = 11.0f;
+    fcu->bezt[1].vec[1][1] = value;
+    for (const int i : IndexRange(fcu->totvert)) {
+      fcu->bezt[i].ipo = BEZT_IPO_LIN;
+      fcu->bezt[i].h1 = fcu->bezt[i].h2 = HD_AUTO_ANIM;
+    }
+    BKE_fcurve_handles_recalc(fcu);
+    BLI_addtail(&action->curves, fcu);
+  }
+
+  NlaStrip *add_strip(NlaTrack *track, bAction *action, const float start)
+  {
+    NlaStrip *strip = BKE_nlastrip_new(action);
+    strip->end += start - strip->start;
+    strip->start = start;
+    EXPECT_TRUE(BKE_nlatrack_add_strip(track, strip, false));
+    return strip;
+  }
+
+  AnimData *adt_eval()
+  {
+    return DEG_get_evaluated_object(depsgraph, object)->adt;
+  }
+
+  /* Evaluate the depsgraph at the frame, which keeps the NLA channels of the evaluated object,
+   * and compare the result with evaluating the original object without the cache. */
+  void expect_cached_evaluation_matches(const float frame)
+  {
+    DEG_graph_relations_update(depsgraph);
+    DEG_evaluate_on_framechange(depsgraph, frame);
+    const Object *object_eval = DEG_get_evaluated_object(depsgraph, object);
+    EXPECT_NE(object_eval->adt->nla_eval_cache, nullptr);
+
+    const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(depsgraph,
+                                                                                      frame);
+    BKE_animsys_evaluate_animdata(
+        &object->id, object->adt, &anim_eval_context, ADT_RECALC_ANIM, false);
+    EXPECT_EQ(object->adt->nla_eval_cache, nullptr);
+
+    for (const int i : IndexRange(3)) {
+      EXPECT_FLOAT_EQ(object_eval->loc[i], object->loc[i]) << "frame " << frame;
+      EXPECT_FLOAT_EQ(object_eval->rot[i], object->rot[i]) << "frame " << frame;
+      EXPECT_FLOAT_EQ(object_eval->scale[i], object->scale[i]) << "frame " << frame;
+    }
+  }
+};
+
+TEST_F(NlaEvalCacheTest, matches_uncached)
+{
+  AnimData *adt = object->adt;
+  NlaTrack *track = BKE_nlatrack_new_tail(&adt->nla_tracks, false);
+  add_strip(track, add_action("location", 0, 4.0f), 1.0f);
+  NlaTrack *track_add = BKE_nlatrack_new_tail(&adt->nla_tracks, false);
+  NlaStrip *strip_add = add_strip(track_add, add_action("location", 0, 2.0f), 5.0f);
+  strip_add->blendmode = NLASTRIP_MODE_ADD;
+  strip_add->influence = 0.5f;
+  strip_add->flag |= NLASTRIP_FLAG_USR_INFLUENCE;
+  /* The active action is evaluated on top of the stack. */
+  adt->action = add_action("rotation_euler", 2, 1.5f);
+
+  depsgraph = scene_depsgraph_build();
+  expect_cached_evaluation_matches(1.0f);
+  const NlaEvalData *cache = adt_eval()->nla_eval_cache;
+  for (const float frame : {3.0f, 7.5f, 12.0f, 16.0f}) {
+    expect_cached_evaluation_matches(frame);
+    /* Only changing the frame keeps the channels. */
+    EXPECT_EQ(adt_eval()->nla_eval_cache, cache);
+  }
+}
+
+TEST_F(NlaEvalCacheTest, invalidated_by_edits)
+{
+  AnimData *adt = object->adt;
+  NlaTrack *track = BKE_nlatrack_new_tail(&adt->nla_tracks, false);
+  add_strip(track, add_action("location", 0, 4.0f), 1.0f);
+  depsgraph = scene_depsgraph_build();
+  expect_cached_evaluation_matches(5.0f);
+
+  /* A strip animating a channel which is not in the cache yet. */
+  bAction *action_scale = add_action("scale", 1, 3.0f);
+  add_strip(track, action_scale, 20.0f);
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_ANIMATION);
+  DEG_relations_tag_update(bmain);
+  expect_cached_evaluation_matches(25.0f);
+  expect_cached_evaluation_matches(5.0f);
+
+  /* A new track, and muting an existing one. */
+  NlaTrack *track_rotation = BKE_nlatrack_new_tail(&adt->nla_tracks, false);
+  add_strip(track_rotation, add_action("rotation_euler", 0, 1.0f), 1.0f);
+  track->flag |= NLATRACK_MUTED;
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_ANIMATION);
+  DEG_relations_tag_update(bmain);
+  expect_cached_evaluation_matches(8.0f);
+  expect_cached_evaluation_matches(25.0f);
+
+  /* An F-Curve added to an action used by a strip, only the action is tagged. */
+  track->flag &= ~NLATRACK_MUTED;
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_ANIMATION);
+  expect_cached_evaluation_matches(25.0f);
+  add_fcurve(action_scale, "location", 2, -2.0f);
+  DEG_id_tag_update_ex(bmain, &action_scale->id, ID_RECALC_ANIMATION);
+  expect_cached_evaluation_matches(26.0f);
+}
+
+TEST_F(NlaEvalCacheTest, free_cache)
+{
+  AnimData *adt = object->adt;
+  NlaTrack *track = BKE_nlatrack_new_tail(&adt->nla_tracks, false);
+  add_strip(track, add_action("location", 1, 2.0f), 1.0f);
+  depsgraph = scene_depsgraph_build();
+  expect_cached_evaluation_matches(4.0f);
+
+  BKE_animsys_free_nla_eval_cache(adt_eval());
+  EXPECT_EQ(adt_eval()->nla_eval_cache, nullptr);
+  /* Freeing twice is fine. */
+  BKE_animsys_free_nla_eval_cache(adt_eval());
+
+  /* The channels are created again on the next evaluation. */
+  expect_cached_evaluation_matches(6.0f);
+}
+
+}  // namespace blender::bke::tests
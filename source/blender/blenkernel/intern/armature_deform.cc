@@ -19,9 +19,13 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_scratch_allocator.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -263,6 +267,64 @@ struct ArmatureUserdata {
   } bmesh;
 };
 
+/**
+ * Apply the accumulated effect of the bones to \a co, which is in armature space. Either \a vec
+ * (linear blending) or \a dq (dual quaternion blending) contains the accumulated deformation.
+ * \a summat is the accumulated rotation and scale for linear blending, and receives the one of
+ * the blended dual quaternion otherwise. It is only used when deform matrices are computed.
+ */
+static void armature_vert_apply_deform(const ArmatureUserdata *data,
+                                       const int i,
+                                       float co[3],
+                                       const float armature_weight,
+                                       const float contrib,
+                                       float vec[3],
+                                       DualQuat *dq,
+                                       float summat[3][3])
+{
+  float(*const vert_deform_mats)[3][3] = data->vert_deform_mats;
+  const bool full_deform = vert_deform_mats != nullptr;
+
+  /* actually should be EPSILON? weight values and contrib can be like 10e-39 small */
+  if (contrib <= 0.0001f) {
+    return;
+  }
+
+  if (dq) {
+    normalize_dq(dq, contrib);
+
+    if (armature_weight != 1.0f) {
+      float dco[3];
+      copy_v3_v3(dco, co);
+      mul_v3m3_dq(dco, full_deform ? summat : nullptr, dq);
+      sub_v3_v3(dco, co);
+      mul_v3_fl(dco, armature_weight);
+      add_v3_v3(co, dco);
+    }
+    else {
+      mul_v3m3_dq(co, full_deform ? summat : nullptr, dq);
+    }
+  }
+  else {
+    mul_v3_fl(vec, armature_weight / contrib);
+    add_v3_v3v3(co, vec, co);
+  }
+
+  if (full_deform) {
+    float pre[3][3], post[3][3], tmpmat[3][3];
+
+    copy_m3_m4(pre, data->premat);
+    copy_m3_m4(post, data->postmat);
+    copy_m3_m3(tmpmat, vert_deform_mats[i]);
+
+    if (!dq) { /* quaternion already is scale corrected */
+      mul_m3_fl(summat, armature_weight / contrib);
+    }
+
+    mul_m3_series(vert_deform_mats[i], post, summat, pre, tmpmat);
+  }
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -277,7 +339,7 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
   DualQuat sumdq, *dq = nullptr;
   const bPoseChannel *pchan;
-  float *co, dco[3];
+  float *co;
   float sumvec[3], summat[3][3];
   float *vec = nullptr, (*smat)[3] = nullptr;
   float contrib = 0.0f;
@@ -378,43 +440,7 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     }
   }
 
-  /* actually should be EPSILON? weight values and contrib can be like 10e-39 small */
-  if (contrib > 0.0001f) {
-    if (use_quaternion) {
-      normalize_dq(dq, contrib);
-
-      if (armature_weight != 1.0f) {
-        copy_v3_v3(dco, co);
-        mul_v3m3_dq(dco, full_deform ? summat : nullptr, dq);
-        sub_v3_v3(dco, co);
-        mul_v3_fl(dco, armature_weight);
-        add_v3_v3(co, dco);
-      }
-      else {
-        mul_v3m3_dq(co, full_deform ? summat : nullptr, dq);
-      }
-
-      smat = summat;
-    }
-    else {
-      mul_v3_fl(vec, armature_weight / contrib);
-      add_v3_v3v3(co, vec, co);
-    }
-
-    if (full_deform) {
-      float pre[3][3], post[3][3], tmpmat[3][3];
-
-      copy_m3_m4(pre, data->premat);
-      copy_m3_m4(post, data->postmat);
-      copy_m3_m3(tmpmat, vert_deform_mats[i]);
-
-      if (!use_quaternion) { /* quaternion already is scale corrected */
-        mul_m3_fl(smat, armature_weight / contrib);
-      }
-
-      mul_m3_series(vert_deform_mats[i], post, smat, pre, tmpmat);
-    }
-  }
+  armature_vert_apply_deform(data, i, co, armature_weight, contrib, vec, dq, summat);
 
   /* always, check above code */
   mul_m4_v3(data->postmat, co);
@@ -478,6 +504,160 @@ static void armature_vert_task_editmesh_no_dvert(void *__restrict userdata,
   armature_vert_task_with_dvert(data, BM_elem_index_get(v), nullptr);
 }
 
+static void vertex_group_weights_build(const blender::Span<MDeformVert> dverts,
+                                       const blender::ImplicitSharingInfo *sharing_info,
+                                       blender::bke::VertexGroupWeightsCache &r_weights)
+{
+  using namespace blender;
+  r_weights.set_source(sharing_info);
+  r_weights.offsets.reinitialize(dverts.size() + 1);
+  for (const int i : dverts.index_range()) {
+    r_weights.offsets[i] = dverts[i].totweight;
+  }
+  const OffsetIndices offsets = offset_indices::accumulate_counts_to_offsets(r_weights.offsets);
+  r_weights.groups.reinitialize(offsets.total_size());
+  r_weights.weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MDeformVert &dvert = dverts[i];
+      const int start = offsets[i].start();
+      for (const int j : IndexRange(dvert.totweight)) {
+        r_weights.groups[start + j] = dvert.dw[j].def_nr;
+        r_weights.weights[start + j] = dvert.dw[j].weight;
+      }
+    }
+  });
+}
+
+/**
+ * Get the vertex group weights of the mesh, which are cached since they usually stay the same
+ * while the pose changes. \a r_uncached is only used when the cache is outdated.
+ */
+static const blender::bke::VertexGroupWeightsCache &mesh_vertex_group_weights(
+    const Mesh &mesh, blender::bke::VertexGroupWeightsCache &r_uncached)
+{
+  using namespace blender;
+  const Span<MDeformVert> dverts = mesh.deform_verts();
+  const int layer_index = CustomData_get_layer_index(&mesh.vert_data, CD_MDEFORMVERT);
+  const ImplicitSharingInfo *sharing_info = mesh.vert_data.layers[layer_index].sharing_info;
+  if (sharing_info == nullptr) {
+    /* Without sharing info, changes to the layer can't be detected. */
+    vertex_group_weights_build(dverts, nullptr, r_uncached);
+    return r_uncached;
+  }
+  mesh.runtime->vertex_group_weights_cache.ensure([&](bke::VertexGroupWeightsCache &r_data) {
+    vertex_group_weights_build(dverts, sharing_info, r_data);
+  });
+  const bke::VertexGroupWeightsCache &weights = mesh.runtime->vertex_group_weights_cache.data();
+  if (weights.is_built_from(sharing_info)) {
+    return weights;
+  }
+  /* The layer was written without tagging the cache, e.g. directly through #CustomData. The
+   * cache may be used by other threads, so don't replace it. */
+  vertex_group_weights_build(dverts, nullptr, r_uncached);
+  return r_uncached;
+}
+
+/**
+ * Same as #armature_vert_task_with_dvert for meshes with vertex groups, but reading the weights
+ * from #VertexGroupWeightsCache. Bones without B-Bone segments are blended by accumulating their
+ * weighted matrices, so that the coordinate is only transformed once.
+ */
+static void armature_vert_task_weights(const ArmatureUserdata *data,
+                                       const blender::bke::VertexGroupWeightsCache &weights,
+                                       const blender::OffsetIndices<int> offsets,
+                                       const int i)
+{
+  using namespace blender;
+  BLI_assert(data->vert_coords_prev == nullptr);
+  const IndexRange range = offsets[i];
+  const Span<int> groups = weights.groups.as_span().slice(range);
+  const Span<float> group_weights = weights.weights.as_span().slice(range);
+
+  auto group_pchan = [&](const int group) -> const bPoseChannel * {
+    return uint(group) < uint(data->defbase_len) ? data->pchan_from_defbase[group] : nullptr;
+  };
+
+  /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
+  if (data->use_envelope &&
+      std::none_of(groups.begin(), groups.end(), [&](const int group) {
+        return group_pchan(group) != nullptr;
+      }))
+  {
+    armature_vert_task_with_dvert(data, i, data->dverts + i);
+    return;
+  }
+
+  float armature_weight = 1.0f;
+  if (data->armature_def_nr != -1) {
+    const int64_t index = groups.first_index_try(data->armature_def_nr);
+    armature_weight = index == -1 ? 0.0f : group_weights[index];
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+    if (armature_weight == 0.0f) {
+      return;
+    }
+  }
+
+  const bool full_deform = data->vert_deform_mats != nullptr;
+  DualQuat sumdq, *dq = nullptr;
+  float sumvec[3], summat[3][3];
+  zero_v3(sumvec);
+  zero_m3(summat);
+  if (data->use_quaternion) {
+    memset(&sumdq, 0, sizeof(DualQuat));
+    dq = &sumdq;
+  }
+
+  float *co = data->vert_coords[i];
+  mul_m4_v3(data->premat, co);
+
+  float4x4 blend_mat = float4x4::zero();
+  float blend_weight = 0.0f;
+  float contrib = 0.0f;
+  for (const int j : groups.index_range()) {
+    const bPoseChannel *pchan = group_pchan(groups[j]);
+    if (pchan == nullptr) {
+      continue;
+    }
+    const Bone *bone = pchan->bone;
+    float weight = group_weights[j];
+    if (bone->flag & BONE_MULT_VG_ENV) {
+      weight *= distfactor_to_bone(
+          co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+    }
+    if (weight == 0.0f) {
+      continue;
+    }
+    contrib += weight;
+    if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+      b_bone_deform(pchan, co, weight, dq ? nullptr : sumvec, dq, summat, full_deform);
+    }
+    else if (dq) {
+      add_weighted_dq_dq_pivot(dq, &pchan->runtime.deform_dual_quat, co, weight, full_deform);
+    }
+    else {
+      blend_mat += float4x4(pchan->chan_mat) * weight;
+      blend_weight += weight;
+    }
+  }
+
+  if (blend_weight != 0.0f) {
+    /* The sum of the weighted offsets `weight * (chan_mat * co - co)` of every bone. */
+    const float3 offset = math::transform_point(blend_mat, float3(co)) -
+                          float3(co) * blend_weight;
+    add_v3_v3(sumvec, offset);
+    if (full_deform) {
+      add_m3_m3m3(summat, summat, float3x3(blend_mat).ptr());
+    }
+  }
+
+  armature_vert_apply_deform(data, i, co, armature_weight, contrib, sumvec, dq, summat);
+
+  mul_m4_v3(data->postmat, co);
+}
+
 static void armature_deform_coords_impl(const Object *ob_arm,
                                         const Object *ob_target,
                                         float (*vert_coords)[3],
@@ -491,6 +671,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
+  blender::ScratchArray<bPoseChannel *, 0> pchan_from_defbase_buffer;
   bPoseChannel **pchan_from_defbase = nullptr;
   const MDeformVert *dverts = nullptr;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -562,8 +743,9 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = static_cast<bPoseChannel **>(
-            MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone"));
+        /* Evaluated on every frame, avoid the allocation overhead during playback. */
+        pchan_from_defbase_buffer.reinitialize(defbase_len);
+        pchan_from_defbase = pchan_from_defbase_buffer.data();
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
@@ -622,16 +804,31 @@ static void armature_deform_coords_impl(const Object *ob_arm,
           em_target->bm->vpool, &data, armature_vert_task_editmesh_no_dvert, &settings);
     }
   }
+  else if (use_dverts && me_target != nullptr && vert_coords_prev == nullptr) {
+    using namespace blender;
+    bke::VertexGroupWeightsCache uncached_weights;
+    const bke::VertexGroupWeightsCache &weights = mesh_vertex_group_weights(*me_target,
+                                                                            uncached_weights);
+    const OffsetIndices<int> offsets = weights.offsets.as_span();
+    threading::parallel_for(IndexRange(vert_coords_len), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        /* Like #armature_vert_task, coordinates without weights are only deformed by the
+         * envelopes, the arrays don't always match the mesh. */
+        if (i < data.dverts_len) {
+          armature_vert_task_weights(&data, weights, offsets, i);
+        }
+        else {
+          armature_vert_task_with_dvert(&data, i, nullptr);
+        }
+      }
+    });
+  }
   else {
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
     settings.min_iter_per_thread = 32;
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
-
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
-  }
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
@@ -0,0 +1,249 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "CLG_log.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_matrix_types.hh"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_string.h"
+
+#include "DNA_action_types.h"
+#include "DNA_armature_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_armature.h"
+#include "BKE_deform.h"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+#include "BKE_mesh.hh"
+#include "BKE_object.h"
+
+namespace blender::bke::tests {
+
+class ArmatureDeformTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+ protected:
+  Main *bmain = nullptr;
+  Object *ob_arm = nullptr;
+  Object *ob_mesh = nullptr;
+  Mesh *mesh = nullptr;
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+    if (mesh) {
+      BKE_id_free(nullptr, mesh);
+    }
+  }
+
+  /* Three bones in a row along the Y axis, each posed differently. */
+  void build_armature(const int bbone_segments)
+  {
+    bArmature *arm = BKE_armature_add(bmain, "Armature");
+    ob_arm = BKE_object_add_only_object(bmain, OB_ARMATURE, "Armature");
+    ob_arm->data = arm;
+    for (const int i : IndexRange(3)) {
+      Bone *bone = MEM_cnew<Bone>(__func__);
+      SNPRINTF(bone->name, "Bone%d", i);
+      copy_v3_fl3(bone->head, 0.0f, float(i), 0.0f);
+      copy_v3_fl3(bone->tail, 0.0f, float(i + 1), 0.0f);
+      bone->xwidth = bone->zwidth = 0.1f;
+      bone->segments = bbone_segments;
+      bone->ease1 = bone->ease2 = 1.0f;
+      copy_v3_fl(bone->scale_in, 1.0f);
+      copy_v3_fl(bone->scale_out, 1.0f);
+      BLI_addtail(&arm->bonebase, bone);
+    }
+    BKE_armature_where_is(arm);
+    BKE_pose_rebuild(nullptr, ob_arm, arm, false);
+
+    int i = 0;
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      const float euler[3] = {0.3f * i, -0.2f, 0.5f - 0.4f * i};
+      eul_to_quat(pchan->quat, euler);
+      copy_v3_fl3(pchan->loc, 0.1f * i, 0.0f, -0.2f);
+      pchan->curve_in_x = 0.2f;
+      pchan->curve_out_z = -0.3f;
+      pchan->roll1 = 0.4f;
+      i++;
+    }
+
+    /* Evaluate the pose like the depsgraph does, see #BKE_pose_bone_done and
+     * #BKE_pose_eval_bbone_segments. */
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      BKE_pose_where_is_bone(nullptr, nullptr, ob_arm, pchan, 0.0f, true);
+      float imat[4][4];
+      invert_m4_m4(imat, pchan->bone->arm_mat);
+      mul_m4_m4m4(pchan->chan_mat, pchan->pose_mat, imat);
+      mat4_to_dquat(&pchan->runtime.deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
+      if (pchan->bone->segments > 1) {
+        BKE_pchan_bbone_segments_cache_compute(pchan);
+      }
+    }
+  }
+
+  /* Vertices around the bones with random weights in up to four groups, one of which has no
+   * bone. Some vertices are not in any group. */
+  void build_mesh(const int verts_num)
+  {
+    mesh = BKE_mesh_new_nomain(verts_num, 0, 0, 0);
+    ob_mesh = BKE_object_add_only_object(bmain, OB_MESH, "Mesh");
+    ob_mesh->data = mesh;
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      BKE_object_defgroup_new(ob_mesh, pchan->name);
+    }
+    BKE_object_defgroup_new(ob_mesh, "NoBone");
+
+    RandomNumberGenerator rng(0);
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+    for (const int i : positions.index_range()) {
+      positions[i] = float3(
+          rng.get_float() - 0.5f, rng.get_float() * 3.0f, rng.get_float() - 0.5f);
+      const int groups_num = rng.get_int32(5);
+      for (const int group : IndexRange(groups_num)) {
+        BKE_defvert_add_index_notest(&dverts[i], group, rng.get_float());
+      }
+    }
+  }
+
+  /* Deform the mesh positions, either with the vertex group weights cache of the mesh or by
+   * reading the weights of every vertex, which is done when no evaluated mesh is given. */
+  Array<float3> deform(const int deformflag,
+                       const bool use_cache,
+                       Array<float3x3> &r_deform_mats)
+  {
+    Array<float3> positions(mesh->vert_positions());
+    r_deform_mats.reinitialize(positions.size());
+    r_deform_mats.fill(float3x3::identity());
+    BKE_armature_deform_coords_with_mesh(ob_arm,
+                                         ob_mesh,
+                                         reinterpret_cast<float(*)[3]>(positions.data()),
+                                         reinterpret_cast<float(*)[3][3]>(r_deform_mats.data()),
+                                         positions.size(),
+                                         deformflag,
+                                         nullptr,
+                                         nullptr,
+                                         use_cache ? mesh : nullptr);
+    return positions;
+  }
+
+  /* Check that the cached weights give the same result as reading the weights directly, and
+   * return the deformed positions. */
+  Array<float3> expect_cached_deform_matches(const int deformflag)
+  {
+    Array<float3x3> mats_cached;
+    Array<float3x3> mats_reference;
+    const Array<float3> cached = deform(deformflag, true, mats_cached);
+    EXPECT_TRUE(mesh->runtime->vertex_group_weights_cache.is_cached());
+    const Array<float3> reference = deform(deformflag, false, mats_reference);
+
+    const Span<float3> positions = mesh->vert_positions();
+    bool any_deformed = false;
+    for (const int i : positions.index_range()) {
+      for (const int j : IndexRange(3)) {
+        EXPECT_NEAR(cached[i][j], reference[i][j], 1e-5f) << "vertex " << i;
+        for (const int k : IndexRange(3)) {
+          EXPECT_NEAR(mats_cached[i][j][k], mats_reference[i][j][k], 1e-5f) << "vertex " << i;
+        }
+      }
+      if (math::distance(reference[i], positions[i]) > 1e-3f) {
+        any_deformed = true;
+      }
+    }
+    EXPECT_TRUE(any_deformed);
+    return cached;
+  }
+
+  /* Change the weights in place, like RNA does, which has to tag the cache dirty. */
+  void edit_weights_in_place()
+  {
+    MDeformVert *dverts = const_cast<MDeformVert *>(mesh->deform_verts().data());
+    for (const int i : IndexRange(mesh->totvert)) {
+      if (dverts[i].totweight > 0) {
+        dverts[i].dw[0].weight = 1.0f - dverts[i].dw[0].weight;
+      }
+    }
+    mesh->runtime->vertex_group_weights_cache.tag_dirty();
+  }
+
+  /* Change the weights with the write accessor, which invalidates the cache itself. */
+  void edit_weights_for_write()
+  {
+    MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+    for (const int i : dverts.index_range()) {
+      if (dverts[i].totweight > 1) {
+        std::swap(dverts[i].dw[0].weight, dverts[i].dw[1].weight);
+      }
+    }
+  }
+
+  void test_deform(const int deformflag)
+  {
+    const Array<float3> initial = expect_cached_deform_matches(deformflag);
+
+    edit_weights_in_place();
+    EXPECT_FALSE(mesh->runtime->vertex_group_weights_cache.is_cached());
+    const Array<float3> edited = expect_cached_deform_matches(deformflag);
+    EXPECT_NE(initial.as_span(), edited.as_span());
+
+    edit_weights_for_write();
+    EXPECT_FALSE(mesh->runtime->vertex_group_weights_cache.is_cached());
+    const Array<float3> edited_for_write = expect_cached_deform_matches(deformflag);
+    EXPECT_NE(edited.as_span(), edited_for_write.as_span());
+  }
+};
+
+TEST_F(ArmatureDeformTest, linear)
+{
+  build_armature(1);
+  build_mesh(500);
+  test_deform(ARM_DEF_VGROUP);
+}
+
+TEST_F(ArmatureDeformTest, dual_quaternion)
+{
+  build_armature(1);
+  build_mesh(500);
+  test_deform(ARM_DEF_VGROUP | ARM_DEF_QUATERNION);
+}
+
+TEST_F(ArmatureDeformTest, bbone)
+{
+  build_armature(4);
+  build_mesh(500);
+  test_deform(ARM_DEF_VGROUP);
+  test_deform(ARM_DEF_VGROUP | ARM_DEF_QUATERNION);
+}
+
+}  // namespace blender::bke::tests
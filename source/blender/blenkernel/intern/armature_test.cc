@@ -4,12 +4,15 @@
 
 #include "BKE_armature.hh"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
 
+#include "DNA_action_types.h"
 #include "DNA_armature_types.h"
 
 #include "ANIM_bone_collections.h"
@@ -426,4 +429,96 @@ TEST_F(BKE_armature_find_selected_bones_test, all_bones_selected)
   EXPECT_FALSE(result.no_bones_selected);
 }
 
+class BKE_pose_eval_batch_test : public testing::Test {
+ protected:
+  bPose pose;
+  bPoseChannel *pchans = nullptr;
+
+  void SetUp() override
+  {
+    memset(&pose, 0, sizeof(pose));
+  }
+
+  void TearDown() override
+  {
+    MEM_SAFE_FREE(pchans);
+  }
+
+  /* Create bones with the given parent indices, -1 for root bones. */
+  void build_pose(const Span<int> parents)
+  {
+    pchans = MEM_cnew_array<bPoseChannel>(parents.size(), __func__);
+    for (const int i : parents.index_range()) {
+      pchans[i].parent = parents[i] == -1 ? nullptr : &pchans[parents[i]];
+      BLI_addtail(&pose.chanbase, &pchans[i]);
+    }
+  }
+
+  /* Check that every bone is evaluated once, and never before its parent. */
+  void expect_valid_order(const Span<int> parents, const PoseEvalBatch &batch)
+  {
+    Vector<int> order = batch.serial_bones;
+    order.extend(batch.group_bones);
+    ASSERT_EQ(order.size(), parents.size());
+    Array<int> positions(parents.size(), -1);
+    for (const int i : order.index_range()) {
+      EXPECT_EQ(positions[order[i]], -1);
+      positions[order[i]] = i;
+    }
+    for (const int i : parents.index_range()) {
+      if (parents[i] != -1) {
+        EXPECT_LT(positions[parents[i]], positions[i]);
+      }
+    }
+    /* Bones in different groups must not depend on each other. */
+    const OffsetIndices<int> groups = batch.groups();
+    Array<int> bone_groups(parents.size(), -1);
+    for (const int group : groups.index_range()) {
+      bone_groups.as_mutable_span().fill_indices(
+          batch.group_bones.as_span().slice(groups[group]), group);
+    }
+    for (const int i : parents.index_range()) {
+      if (parents[i] != -1 && bone_groups[parents[i]] != -1) {
+        EXPECT_EQ(bone_groups[parents[i]], bone_groups[i]);
+      }
+    }
+  }
+};
+
+TEST_F(BKE_pose_eval_batch_test, small_pose)
+{
+  const Array<int> parents = {-1, 0, 1, -1};
+  build_pose(parents);
+  const PoseEvalBatch batch = pose_eval_batch_build(pose);
+  EXPECT_TRUE(batch.serial_bones.is_empty());
+  EXPECT_EQ(batch.groups().size(), 1);
+  expect_valid_order(parents, batch);
+}
+
+TEST_F(BKE_pose_eval_batch_test, wide_pose)
+{
+  /* A root bone with many leaf bones, the leaves can be evaluated in parallel. */
+  Array<int> parents(200, 0);
+  parents[0] = -1;
+  build_pose(parents);
+  const PoseEvalBatch batch = pose_eval_batch_build(pose);
+  EXPECT_EQ(batch.serial_bones.as_span(), Span<int>({0}));
+  EXPECT_GT(batch.groups().size(), 1);
+  expect_valid_order(parents, batch);
+}
+
+TEST_F(BKE_pose_eval_batch_test, chains)
+{
+  /* Two long chains from a common root bone, listed in an order which is not depth-first. */
+  Array<int> parents(301);
+  parents[0] = -1;
+  for (int i = 1; i < 301; i++) {
+    parents[i] = i < 3 ? 0 : i - 2;
+  }
+  build_pose(parents);
+  const PoseEvalBatch batch = pose_eval_batch_build(pose);
+  EXPECT_FALSE(batch.serial_bones.is_empty());
+  expect_valid_order(parents, batch);
+}
+
 }  // namespace blender::bke::tests
@@ -8,10 +8,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -21,7 +24,7 @@
 
 #include "BKE_action.h"
 #include "BKE_anim_path.h"
-#include "BKE_armature.h"
+#include "BKE_armature.hh"
 #include "BKE_curve.h"
 #include "BKE_displist.h"
 #include "BKE_fcurve.h"
@@ -1028,6 +1031,120 @@ void BKE_pose_splineik_evaluate(Depsgraph *depsgraph,
   BKE_splineik_execute_tree(depsgraph, scene, object, rootchan, ctime);
 }
 
+namespace blender::bke {
+
+/* Sub-trees with more bones than this are split, smaller ones are combined into groups of about
+ * this size. Below this size the overhead of a parallel task outweighs evaluating the bones. */
+static constexpr int pose_batch_group_size = 64;
+
+PoseEvalBatch pose_eval_batch_build(const bPose &pose)
+{
+  const int bones_num = BLI_listbase_count(&pose.chanbase);
+  Map<const bPoseChannel *, int> indices;
+  indices.reserve(bones_num);
+  LISTBASE_FOREACH (const bPoseChannel *, pchan, &pose.chanbase) {
+    indices.add_new(pchan, indices.size());
+  }
+
+  Array<int> parents(bones_num);
+  Array<Vector<int>> children(bones_num);
+  Vector<int> roots;
+  LISTBASE_FOREACH (const bPoseChannel *, pchan, &pose.chanbase) {
+    const int index = indices.lookup(pchan);
+    if (pchan->parent == nullptr) {
+      parents[index] = -1;
+      roots.append(index);
+    }
+    else {
+      parents[index] = indices.lookup(pchan->parent);
+      children[parents[index]].append(index);
+    }
+  }
+
+  /* Appends the bones of the sub-tree in depth-first order, so parents come first. */
+  Vector<int> stack;
+  auto append_subtree = [&](const int root, Vector<int> &r_bones) {
+    stack.append(root);
+    while (!stack.is_empty()) {
+      const int bone = stack.pop_last();
+      r_bones.append(bone);
+      stack.extend(children[bone]);
+    }
+  };
+
+  Vector<int> order;
+  order.reserve(bones_num);
+  for (const int root : roots) {
+    append_subtree(root, order);
+  }
+  Array<int> subtree_sizes(bones_num, 1);
+  for (int i = order.size() - 1; i >= 0; i--) {
+    const int bone = order[i];
+    if (parents[bone] != -1) {
+      subtree_sizes[parents[bone]] += subtree_sizes[bone];
+    }
+  }
+
+  PoseEvalBatch batch;
+  /* Peel off the roots of large sub-trees, they are evaluated before their children. */
+  Vector<int> subtree_roots;
+  Vector<int> pending = roots;
+  while (!pending.is_empty()) {
+    const int bone = pending.pop_last();
+    if (subtree_sizes[bone] > pose_batch_group_size) {
+      batch.serial_bones.append(bone);
+      pending.extend(children[bone]);
+    }
+    else {
+      subtree_roots.append(bone);
+    }
+  }
+
+  batch.group_offsets.append(0);
+  for (const int root : subtree_roots) {
+    append_subtree(root, batch.group_bones);
+    if (batch.group_bones.size() - batch.group_offsets.last() >= pose_batch_group_size) {
+      batch.group_offsets.append(batch.group_bones.size());
+    }
+  }
+  if (batch.group_bones.size() > batch.group_offsets.last()) {
+    batch.group_offsets.append(batch.group_bones.size());
+  }
+  return batch;
+}
+
+void pose_eval_bones_batched(Depsgraph *depsgraph,
+                             Scene *scene,
+                             Object *object,
+                             const PoseEvalBatch &batch)
+{
+  DEG_debug_print_eval(depsgraph, __func__, object->id.name, object);
+  BLI_assert(object->type == OB_ARMATURE);
+  const bArmature *armature = (bArmature *)object->data;
+  if (armature->edbo != nullptr) {
+    return;
+  }
+  /* Reuse the per-bone evaluation so that the result is exactly the same as when the bones are
+   * evaluated by separate operations. A bone only reads the result of its parent. */
+  auto eval_bone = [&](const int pchan_index) {
+    BKE_pose_eval_bone(depsgraph, scene, object, pchan_index);
+    BKE_pose_bone_done(depsgraph, object, pchan_index);
+  };
+  for (const int pchan_index : batch.serial_bones) {
+    eval_bone(pchan_index);
+  }
+  const OffsetIndices<int> groups = batch.groups();
+  threading::parallel_for(groups.index_range(), 1, [&](const IndexRange range) {
+    for (const int group : range) {
+      for (const int pchan_index : batch.group_bones.as_span().slice(groups[group])) {
+        eval_bone(pchan_index);
+      }
+    }
+  });
+}
+
+}  // namespace blender::bke
+
 static void pose_eval_cleanup_common(Object *object)
 {
   bPose *pose = object->pose;
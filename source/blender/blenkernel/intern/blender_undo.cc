@@ -30,6 +30,8 @@
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "BKE_appdir.h"
 #include "BKE_blender_undo.h" /* own include */
 #include "BKE_blendfile.h"
@@ -44,6 +46,10 @@
 
 #include "DEG_depsgraph.h"
 
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"bke.blender_undo"};
+
 /* -------------------------------------------------------------------- */
 /** \name Global Undo
  * \{ */
@@ -127,12 +133,18 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
     STRNCPY(mfu->filepath, filepath);
   }
   else {
+    const double time_start = PIL_check_seconds_timer();
     MemFile *prevfile = (mfu_prev) ? &(mfu_prev->memfile) : nullptr;
     if (prevfile) {
       BLO_memfile_clear_future(prevfile);
     }
     /* success = */ /* UNUSED */ BLO_write_file_mem(bmain, prevfile, &mfu->memfile, fileflags);
     mfu->undo_size = mfu->memfile.size;
+    CLOG_INFO(&LOG,
+              1,
+              "Memfile undo step encoded in %.3f ms, %zu bytes of new data",
+              (PIL_check_seconds_timer() - time_start) * 1000.0,
+              mfu->undo_size);
   }
 
   bmain->is_memfile_undo_written = true;
@@ -73,6 +73,19 @@ void BKE_callback_exec_string(Main *bmain, eCbEvent evt, const char *str)
   BKE_callback_exec(bmain, pointers, 1, evt);
 }
 
+bool BKE_callback_is_used(eCbEvent evt)
+{
+  ASSERT_CALLBACKS_INITIALIZED();
+
+  ListBase *lb = &callback_slots[evt];
+  LISTBASE_FOREACH (bCallbackFuncStore *, funcstore, lb) {
+    if (funcstore->poll == nullptr || funcstore->poll(funcstore->arg)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void BKE_callback_add(bCallbackFuncStore *funcstore, eCbEvent evt)
 {
   ASSERT_CALLBACKS_INITIALIZED();
@@ -2191,12 +2191,16 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 static void *copy_layer_data(const eCustomDataType type, const void *data, const int totelem)
 {
   const LayerTypeInfo &type_info = *layerType_getInfo(type);
+  void *new_data = MEM_malloc_arrayN(size_t(totelem), type_info.size, __func__);
   if (type_info.copy) {
-    void *new_data = MEM_malloc_arrayN(size_t(totelem), type_info.size, __func__);
     type_info.copy(data, new_data, totelem);
-    return new_data;
   }
-  return MEM_dupallocN(data);
+  else {
+    /* Don't use #MEM_dupallocN, the data may not be allocated with the guarded allocator when it
+     * references a memory-mapped file. */
+    memcpy(new_data, data, size_t(totelem) * size_t(type_info.size));
+  }
+  return new_data;
 }
 
 static void free_layer_data(const eCustomDataType type, const void *data, const int totelem)
@@ -4508,7 +4512,9 @@ bool CustomData_layer_validate(CustomDataLayer *layer, const uint totitems, cons
   }
 
   BLI_assert((totitems == 0) || layer->data);
-  BLI_assert(MEM_allocN_len(layer->data) >= totitems * typeInfo->size);
+  /* Read-only data may reference a memory-mapped file. */
+  BLI_assert((layer->sharing_info && !layer->sharing_info->is_mutable()) ||
+             MEM_allocN_len(layer->data) >= totitems * typeInfo->size);
 
   if (typeInfo->validate != nullptr) {
     return typeInfo->validate(layer->data, totitems, do_fixes);
@@ -5122,6 +5128,45 @@ static void write_grid_paint_mask(BlendWriter *writer,
   }
 }
 
+static void blend_write_layer_data(BlendWriter *writer,
+                                   const CustomDataLayer &layer,
+                                   const int count)
+{
+  switch (layer.type) {
+    case CD_MDEFORMVERT:
+      BKE_defvert_blend_write(writer, count, static_cast<const MDeformVert *>(layer.data));
+      break;
+    case CD_MDISPS:
+      write_mdisps(
+          writer, count, static_cast<const MDisps *>(layer.data), layer.flag & CD_FLAG_EXTERNAL);
+      break;
+    case CD_PAINT_MASK:
+      BLO_write_raw(writer, sizeof(float) * count, static_cast<const float *>(layer.data));
+      break;
+    case CD_GRID_PAINT_MASK:
+      write_grid_paint_mask(writer, count, static_cast<const GridPaintMask *>(layer.data));
+      break;
+    case CD_PROP_BOOL:
+      BLO_write_raw(writer, sizeof(bool) * count, static_cast<const bool *>(layer.data));
+      break;
+    default: {
+      const char *structname;
+      int structnum;
+      CustomData_file_write_info(eCustomDataType(layer.type), &structname, &structnum);
+      if (structnum) {
+        int datasize = structnum * count;
+        BLO_write_struct_array_by_name(writer, structname, datasize, layer.data);
+      }
+      else if (!BLO_write_is_undo(writer)) { /* Do not warn on undo. */
+        printf("%s error: layer '%s':%d - can't be written to file\n",
+               __func__,
+               structname,
+               layer.type);
+      }
+    }
+  }
+}
+
 void CustomData_blend_write(BlendWriter *writer,
                             CustomData *data,
                             Span<CustomDataLayer> layers_to_write,
@@ -5138,39 +5183,11 @@ void CustomData_blend_write(BlendWriter *writer,
       writer, CustomDataLayer, data->totlayer, data->layers, layers_to_write.data());
 
   for (const CustomDataLayer &layer : layers_to_write) {
-    switch (layer.type) {
-      case CD_MDEFORMVERT:
-        BKE_defvert_blend_write(writer, count, static_cast<const MDeformVert *>(layer.data));
-        break;
-      case CD_MDISPS:
-        write_mdisps(
-            writer, count, static_cast<const MDisps *>(layer.data), layer.flag & CD_FLAG_EXTERNAL);
-        break;
-      case CD_PAINT_MASK:
-        BLO_write_raw(writer, sizeof(float) * count, static_cast<const float *>(layer.data));
-        break;
-      case CD_GRID_PAINT_MASK:
-        write_grid_paint_mask(writer, count, static_cast<const GridPaintMask *>(layer.data));
-        break;
-      case CD_PROP_BOOL:
-        BLO_write_raw(writer, sizeof(bool) * count, static_cast<const bool *>(layer.data));
-        break;
-      default: {
-        const char *structname;
-        int structnum;
-        CustomData_file_write_info(eCustomDataType(layer.type), &structname, &structnum);
-        if (structnum) {
-          int datasize = structnum * count;
-          BLO_write_struct_array_by_name(writer, structname, datasize, layer.data);
-        }
-        else if (!BLO_write_is_undo(writer)) { /* Do not warn on undo. */
-          printf("%s error: layer '%s':%d - can't be written to file\n",
-                 __func__,
-                 structname,
-                 layer.type);
-        }
-      }
-    }
+    const size_t size_in_bytes = size_t(CustomData_sizeof(eCustomDataType(layer.type))) *
+                                 size_t(count);
+    BLO_write_shared(writer, layer.data, size_in_bytes, layer.sharing_info, [&]() {
+      blend_write_layer_data(writer, layer, count);
+    });
   }
 
   if (data->external) {
@@ -5223,6 +5240,26 @@ static void blend_read_paint_mask(BlendDataReader *reader,
   }
 }
 
+static void blend_read_layer_data(BlendDataReader *reader,
+                                  CustomDataLayer &layer,
+                                  const int count)
+{
+  BLO_read_data_address(reader, &layer.data);
+  if (layer.data == nullptr) {
+    return;
+  }
+  if (layer.type == CD_MDISPS) {
+    blend_read_mdisps(
+        reader, count, static_cast<MDisps *>(layer.data), layer.flag & CD_FLAG_EXTERNAL);
+  }
+  else if (layer.type == CD_GRID_PAINT_MASK) {
+    blend_read_paint_mask(reader, count, static_cast<GridPaintMask *>(layer.data));
+  }
+  else if (layer.type == CD_MDEFORMVERT) {
+    BKE_defvert_blend_read(reader, count, static_cast<MDeformVert *>(layer.data));
+  }
+}
+
 void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int count)
 {
   BLO_read_data_address(reader, &data->layers);
@@ -5246,11 +5283,25 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
-      BLO_read_data_address(reader, &layer->data);
-      if (layer->data != nullptr) {
+      const auto read_layer_fn = [&]() -> const ImplicitSharingInfo * {
+        blend_read_layer_data(reader, *layer, count);
+        if (layer->data == nullptr) {
+          return nullptr;
+        }
         /* Make layer data shareable. */
-        layer->sharing_info = make_implicit_sharing_info_for_layer(
+        return make_implicit_sharing_info_for_layer(
             eCustomDataType(layer->type), layer->data, count);
+      };
+      const LayerTypeInfo &type_info = *layerType_getInfo(eCustomDataType(layer->type));
+      if (type_info.copy == nullptr && type_info.free == nullptr) {
+        /* Plain arrays like positions or UV maps can reference memory-mapped files directly.
+         * The values of all such layer types are at most 4 byte aligned. */
+        const int64_t alignment = std::min(type_info.size & -type_info.size, 4);
+        layer->sharing_info = BLO_read_shared_array(
+            reader, &layer->data, int64_t(count) * type_info.size, alignment, read_layer_fn);
+      }
+      else {
+        layer->sharing_info = BLO_read_shared(reader, &layer->data, read_layer_fn);
       }
       if (CustomData_layer_ensure_data_exists(layer, count)) {
         /* Under normal operations, this shouldn't happen, but...
@@ -5260,17 +5311,6 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
                   "Allocated custom data layer that was not saved correctly for layer->type = %d.",
                   layer->type);
       }
-
-      if (layer->type == CD_MDISPS) {
-        blend_read_mdisps(
-            reader, count, static_cast<MDisps *>(layer->data), layer->flag & CD_FLAG_EXTERNAL);
-      }
-      else if (layer->type == CD_GRID_PAINT_MASK) {
-        blend_read_paint_mask(reader, count, static_cast<GridPaintMask *>(layer->data));
-      }
-      else if (layer->type == CD_MDEFORMVERT) {
-        BKE_defvert_blend_read(reader, count, static_cast<MDeformVert *>(layer->data));
-      }
       i++;
     }
   }
@@ -5291,7 +5331,10 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
 
 #ifndef NDEBUG
 
-void CustomData_debug_info_from_layers(const CustomData *data, const char *indent, DynStr *dynstr)
+void CustomData_debug_info_from_layers(const CustomData *data,
+                                       const int totelem,
+                                       const char *indent,
+                                       DynStr *dynstr)
 {
   for (eCustomDataType type = eCustomDataType(0); type < CD_NUMTYPES;
        type = eCustomDataType(type + 1))
@@ -5301,7 +5344,9 @@ void CustomData_debug_info_from_layers(const CustomData *data, const char *inden
       const char *name = CustomData_layertype_name(type);
       const int size = CustomData_sizeof(type);
       const void *pt = CustomData_get_layer(data, type);
-      const int pt_size = pt ? int(MEM_allocN_len(pt) / size) : 0;
+      /* The data is not necessarily a guarded allocation (it may be memory-mapped from a file),
+       * so the length is not taken from the allocation. */
+      const int pt_size = pt ? totelem : 0;
       const char *structname;
       int structnum;
       CustomData_file_write_info(type, &structname, &structnum);
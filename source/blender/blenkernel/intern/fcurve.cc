@@ -41,6 +41,8 @@
 #include "RNA_access.hh"
 #include "RNA_path.hh"
 
+#include "atomic_ops.h"
+
 #include "CLG_log.h"
 
 #define SMALL -1.0e-10
@@ -1968,7 +1970,56 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
-static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
+/**
+ * Same as #BKE_fcurve_bezt_binarysearch_index_ex for an evaluation time between the first and the
+ * last keyframe, but first looks in the segment found by the previous evaluation and the one after
+ * it. During playback that avoids the binary search for almost every frame, which matters for
+ * dense curves like baked or motion captured animation.
+ */
+static int fcurve_bezt_find_index_hinted(FCurve *fcu,
+                                         const BezTriple *bezts,
+                                         const float evaltime,
+                                         const float threshold,
+                                         bool *r_exact)
+{
+  const int totvert = int(fcu->totvert);
+  const int hint = atomic_load_int32(&fcu->segment_hint);
+
+  /* Keys are compared with #IS_EQT and strict comparisons otherwise, like the binary search. */
+  for (int start = max_ii(hint, 0); start <= hint + 1 && start + 1 < totvert; start++) {
+    const float prev_frame = bezts[start].vec[1][0];
+    const float next_frame = bezts[start + 1].vec[1][0];
+    if (evaltime < prev_frame || IS_EQT(evaltime, prev_frame, threshold)) {
+      break;
+    }
+    if (evaltime < next_frame && !IS_EQT(evaltime, next_frame, threshold)) {
+      if (start != hint) {
+        atomic_store_int32(&fcu->segment_hint, start);
+      }
+      *r_exact = false;
+      return start + 1;
+    }
+    /* On the next keyframe, only if it is the only one within the threshold, otherwise the binary
+     * search might choose another one. */
+    if (IS_EQT(evaltime, next_frame, threshold) &&
+        (start + 2 >= totvert || (evaltime < bezts[start + 2].vec[1][0] &&
+                                  !IS_EQT(evaltime, bezts[start + 2].vec[1][0], threshold))))
+    {
+      if (start != hint) {
+        atomic_store_int32(&fcu->segment_hint, start);
+      }
+      *r_exact = true;
+      return start + 1;
+    }
+  }
+
+  const int index = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, totvert, threshold, r_exact);
+  atomic_store_int32(&fcu->segment_hint, index - 1);
+  return index;
+}
+
+static float fcurve_eval_keyframes_interpolate(FCurve *fcu,
                                                const BezTriple *bezts,
                                                float evaltime)
 {
@@ -1988,7 +2039,7 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_bezt_find_index_hinted(fcu, bezts, evaltime, 0.0001f, &exact);
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2509,7 +2560,13 @@ void BKE_fmodifiers_blend_read_data(BlendDataReader *reader, ListBase *fmodifier
 
 void BKE_fcurve_blend_write(BlendWriter *writer, ListBase *fcurves)
 {
-  BLO_write_struct_list(writer, FCurve, fcurves);
+  LISTBASE_FOREACH (FCurve *, fcu, fcurves) {
+    /* Clear runtime data on a copy, it would make undo detect changes in curves that were only
+     * evaluated. The original is not modified, evaluation may use the hint at the same time. */
+    FCurve fcu_copy = *fcu;
+    fcu_copy.segment_hint = 0;
+    BLO_write_struct_at_address(writer, FCurve, fcu, &fcu_copy);
+  }
   LISTBASE_FOREACH (FCurve *, fcu, fcurves) {
     /* curve data */
     if (fcu->bezt) {
@@ -2565,6 +2622,8 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, ListBase *fcurves)
      */
     fcu->flag &= ~FCURVE_DISABLED;
 
+    fcu->segment_hint = 0;
+
     /* driver */
     BLO_read_data_address(reader, &fcu->driver);
     if (fcu->driver) {
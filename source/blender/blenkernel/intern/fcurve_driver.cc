@@ -1061,7 +1061,11 @@ static ExprPyLike_Parsed *driver_compile_simple_expr_impl(ChannelDriver *driver)
     names[i++] = dvar->name;
   }
 
-  return BLI_expr_pylike_parse(driver->expression, names, names_len + VAR_INDEX_CUSTOM);
+  /* References to the data of `self` are evaluated as additional parameters. */
+  const char *ref_root = (driver->flag & DRIVER_FLAG_USE_SELF) ? "self" : nullptr;
+
+  return BLI_expr_pylike_parse_ex(
+      driver->expression, names, names_len + VAR_INDEX_CUSTOM, ref_root);
 }
 
 static bool driver_check_simple_expr_depends_on_time(ExprPyLike_Parsed *expr)
@@ -1070,7 +1074,43 @@ static bool driver_check_simple_expr_depends_on_time(ExprPyLike_Parsed *expr)
   return BLI_expr_pylike_is_using_param(expr, VAR_INDEX_FRAME);
 }
 
+/* Get the value of a `self.path` reference in a driver expression. Fails when the path does not
+ * resolve to a single number, Python has to deal with such expressions. */
+static bool driver_get_self_reference_value(const PathResolvedRNA *anim_rna,
+                                            const char *path,
+                                            double *r_value)
+{
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int index;
+
+  if (!RNA_path_resolve_property_full(&anim_rna->ptr, path, &ptr, &prop, &index)) {
+    return false;
+  }
+  if (RNA_property_array_check(prop) != (index != -1)) {
+    return false;
+  }
+
+  switch (RNA_property_type(prop)) {
+    case PROP_BOOLEAN:
+      *r_value = (index != -1) ? RNA_property_boolean_get_index(&ptr, prop, index) :
+                                 RNA_property_boolean_get(&ptr, prop);
+      return true;
+    case PROP_INT:
+      *r_value = (index != -1) ? RNA_property_int_get_index(&ptr, prop, index) :
+                                 RNA_property_int_get(&ptr, prop);
+      return true;
+    case PROP_FLOAT:
+      *r_value = (index != -1) ? RNA_property_float_get_index(&ptr, prop, index) :
+                                 RNA_property_float_get(&ptr, prop);
+      return true;
+    default:
+      return false;
+  }
+}
+
 static bool driver_evaluate_simple_expr(const AnimationEvalContext *anim_eval_context,
+                                        PathResolvedRNA *anim_rna,
                                         ChannelDriver *driver,
                                         ExprPyLike_Parsed *expr,
                                         float *result,
@@ -1078,7 +1118,9 @@ static bool driver_evaluate_simple_expr(const AnimationEvalContext *anim_eval_co
 {
   /* Prepare parameter values. */
   int vars_len = BLI_listbase_count(&driver->variables);
-  double *vars = static_cast<double *>(BLI_array_alloca(vars, vars_len + VAR_INDEX_CUSTOM));
+  int refs_len = BLI_expr_pylike_refs_count(expr);
+  double *vars = static_cast<double *>(
+      BLI_array_alloca(vars, vars_len + refs_len + VAR_INDEX_CUSTOM));
   int i = VAR_INDEX_CUSTOM;
 
   vars[VAR_INDEX_FRAME] = time;
@@ -1087,10 +1129,18 @@ static bool driver_evaluate_simple_expr(const AnimationEvalContext *anim_eval_co
     vars[i++] = driver_get_variable_value(anim_eval_context, driver, dvar);
   }
 
+  for (int ref_index = 0; ref_index < refs_len; ref_index++) {
+    const char *path = BLI_expr_pylike_ref_path(expr, ref_index);
+    if (anim_rna == nullptr || !driver_get_self_reference_value(anim_rna, path, &vars[i++])) {
+      /* Not an error, the expression is evaluated with Python instead. */
+      return false;
+    }
+  }
+
   /* Evaluate expression. */
   double result_val;
   eExprPyLike_EvalStatus status = BLI_expr_pylike_eval(
-      expr, vars, vars_len + VAR_INDEX_CUSTOM, &result_val);
+      expr, vars, vars_len + refs_len + VAR_INDEX_CUSTOM, &result_val);
   const char *message;
 
   switch (status) {
@@ -1142,6 +1192,7 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
 /* Try using the simple expression evaluator to compute the result of the driver.
  * On success, stores the result and returns true; on failure result is set to 0. */
 static bool driver_try_evaluate_simple_expr(const AnimationEvalContext *anim_eval_context,
+                                            PathResolvedRNA *anim_rna,
                                             ChannelDriver *driver,
                                             ChannelDriver *driver_orig,
                                             float *result,
@@ -1152,7 +1203,7 @@ static bool driver_try_evaluate_simple_expr(const AnimationEvalContext *anim_eva
   return driver_compile_simple_expr(driver_orig) &&
          BLI_expr_pylike_is_valid(driver_orig->expr_simple) &&
          driver_evaluate_simple_expr(
-             anim_eval_context, driver, driver_orig->expr_simple, result, time);
+             anim_eval_context, anim_rna, driver, driver_orig->expr_simple, result, time);
 }
 
 bool BKE_driver_has_simple_expression(ChannelDriver *driver)
@@ -1326,6 +1377,7 @@ static void evaluate_driver_python(PathResolvedRNA *anim_rna,
     driver->curval = 0.0f;
   }
   else if (!driver_try_evaluate_simple_expr(anim_eval_context,
+                                            anim_rna,
                                             driver,
                                             driver_orig,
                                             &driver->curval,
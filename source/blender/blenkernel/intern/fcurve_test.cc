@@ -81,6 +81,41 @@ TEST(evaluate_fcurve, InterpolationLinear)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SequentialEvaluation)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 100; i++) {
+    insert_vert_fcurve(fcu, float(i), float(i * 2), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i].ipo = BEZT_IPO_LIN;
+  }
+
+  /* The search for the segment starts where the previous evaluation ended, the result must not
+   * depend on the order of the evaluations. */
+  for (float time = 0.0f; time <= 99.0f; time += 0.25f) {
+    EXPECT_NEAR(evaluate_fcurve(fcu, time), time * 2.0f, 1e-5f);
+  }
+  for (float time = 99.0f; time >= 0.0f; time -= 0.5f) {
+    EXPECT_NEAR(evaluate_fcurve(fcu, time), time * 2.0f, 1e-5f);
+  }
+  /* Times close to a key evaluate to the key itself. */
+  const float2 jumps[] = {
+      {50.5f, 101.0f}, {3.0f, 6.0f}, {3.00008f, 6.0f}, {97.25f, 194.5f}, {4.99992f, 10.0f}};
+  for (const float2 &jump : jumps) {
+    EXPECT_NEAR(evaluate_fcurve(fcu, jump.x), jump.y, 1e-5f);
+  }
+
+  /* The hint follows the evaluation into the next segment. */
+  EXPECT_NEAR(evaluate_fcurve(fcu, 10.5f), 21.0f, 1e-5f);
+  EXPECT_EQ(fcu->segment_hint, 10);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 11.5f), 23.0f, 1e-5f);
+  EXPECT_EQ(fcu->segment_hint, 11);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 12.0f), 24.0f, 1e-5f);
+  EXPECT_EQ(fcu->segment_hint, 11);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationBezier)
 {
   FCurve *fcu = BKE_fcurve_create();
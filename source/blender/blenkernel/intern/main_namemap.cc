@@ -14,6 +14,8 @@
 #include "BLI_assert.h"
 #include "BLI_bitmap.h"
 #include "BLI_ghash.h"
+#include "BLI_group_probing_map.hh"
+#include "BLI_group_probing_set.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_math_base.hh"
@@ -159,11 +161,12 @@ struct UniqueName_Value {
 
 /* Tracking of names for a single ID type. */
 struct UniqueName_TypeMap {
-  /* Set of full names that are in use. */
-  Set<UniqueName_Key> full_names;
+  /* Set of full names that are in use. Group probing avoids most string comparisons in files with
+   * many IDs. */
+  GroupProbingSet<UniqueName_Key> full_names;
   /* For each base name (i.e. without numeric suffix), track the
    * numeric suffixes that are in use. */
-  Map<UniqueName_Key, UniqueName_Value> base_name_to_num_suffix;
+  GroupProbingMap<UniqueName_Key, UniqueName_Value> base_name_to_num_suffix;
 };
 
 struct UniqueName_Map {
@@ -143,6 +143,7 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->vertex_group_weights_cache = mesh_src->runtime->vertex_group_weights_cache;
 
   /* Only do tessface if we have no faces. */
   const bool do_tessface = ((mesh_src->totface_legacy != 0) && (mesh_src->faces_num == 0));
@@ -303,7 +304,14 @@ static void mesh_blend_write(BlendWriter *writer, ID *id, const void *id_address
       writer, &mesh->face_data, face_layers, mesh->faces_num, CD_MASK_MESH.pmask, &mesh->id);
 
   if (mesh->face_offset_indices) {
-    BLO_write_int32_array(writer, mesh->faces_num + 1, mesh->face_offset_indices);
+    BLO_write_shared(writer,
+                     mesh->face_offset_indices,
+                     sizeof(int) * (mesh->faces_num + 1),
+                     mesh->runtime->face_offsets_sharing_info,
+                     [&]() {
+                       BLO_write_int32_array(
+                           writer, mesh->faces_num + 1, mesh->face_offset_indices);
+                     });
   }
 }
 
@@ -349,9 +357,11 @@ static void mesh_blend_read_data(BlendDataReader *reader, ID *id)
   mesh->runtime = new blender::bke::MeshRuntime();
 
   if (mesh->face_offset_indices) {
-    BLO_read_int32_array(reader, mesh->faces_num + 1, &mesh->face_offset_indices);
-    mesh->runtime->face_offsets_sharing_info = blender::implicit_sharing::info_for_mem_free(
-        mesh->face_offset_indices);
+    mesh->runtime->face_offsets_sharing_info = BLO_read_shared(
+        reader, reinterpret_cast<void **>(&mesh->face_offset_indices), [&]() {
+          BLO_read_int32_array(reader, mesh->faces_num + 1, &mesh->face_offset_indices);
+          return blender::implicit_sharing::info_for_mem_free(mesh->face_offset_indices);
+        });
   }
 
   if (mesh->mselect == nullptr) {
@@ -769,6 +779,18 @@ const char *BKE_mesh_cmp(Mesh *me1, Mesh *me2, float thresh)
   return nullptr;
 }
 
+MDeformVert *BKE_mesh_deform_verts_for_write(Mesh *mesh)
+{
+  mesh->runtime->vertex_group_weights_cache.tag_dirty();
+  MDeformVert *dvert = (MDeformVert *)CustomData_get_layer_for_write(
+      &mesh->vert_data, CD_MDEFORMVERT, mesh->totvert);
+  if (dvert) {
+    return dvert;
+  }
+  return (MDeformVert *)CustomData_add_layer(
+      &mesh->vert_data, CD_MDEFORMVERT, CD_SET_DEFAULT, mesh->totvert);
+}
+
 bool BKE_mesh_attribute_required(const char *name)
 {
   return ELEM(StringRef(name), "position", ".corner_vert", ".corner_edge", ".edge_verts");
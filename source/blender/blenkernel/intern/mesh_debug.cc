@@ -48,23 +48,23 @@ char *BKE_mesh_debug_info(const Mesh *me)
       dynstr, "    'runtime->is_original_bmesh': %d,\n", me->runtime->is_original_bmesh);
 
   BLI_dynstr_append(dynstr, "    'vert_layers': (\n");
-  CustomData_debug_info_from_layers(&me->vert_data, indent8, dynstr);
+  CustomData_debug_info_from_layers(&me->vert_data, me->totvert, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'edge_layers': (\n");
-  CustomData_debug_info_from_layers(&me->edge_data, indent8, dynstr);
+  CustomData_debug_info_from_layers(&me->edge_data, me->totedge, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'loop_layers': (\n");
-  CustomData_debug_info_from_layers(&me->loop_data, indent8, dynstr);
+  CustomData_debug_info_from_layers(&me->loop_data, me->totloop, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'poly_layers': (\n");
-  CustomData_debug_info_from_layers(&me->face_data, indent8, dynstr);
+  CustomData_debug_info_from_layers(&me->face_data, me->faces_num, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'tessface_layers': (\n");
-  CustomData_debug_info_from_layers(&me->fdata_legacy, indent8, dynstr);
+  CustomData_debug_info_from_layers(&me->fdata_legacy, me->totface_legacy, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "}\n");
@@ -26,6 +26,7 @@
 #include "DNA_volume_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_image.h"
@@ -149,7 +150,7 @@ void BKE_packedfile_free(PackedFile *pf)
   if (pf) {
     BLI_assert(pf->data != nullptr);
 
-    MEM_SAFE_FREE(pf->data);
+    blender::implicit_sharing::free_shared_data(&pf->data, &pf->sharing_info);
     MEM_freeN(pf);
   }
   else {
@@ -165,7 +166,9 @@ PackedFile *BKE_packedfile_duplicate(const PackedFile *pf_src)
   PackedFile *pf_dst;
 
   pf_dst = static_cast<PackedFile *>(MEM_dupallocN(pf_src));
-  pf_dst->data = MEM_dupallocN(pf_src->data);
+  /* The data is never modified, so it can always be shared instead of copied. */
+  blender::implicit_sharing::copy_shared_pointer(
+      pf_src->data, pf_src->sharing_info, &pf_dst->data, &pf_dst->sharing_info);
 
   return pf_dst;
 }
@@ -177,6 +180,7 @@ PackedFile *BKE_packedfile_new_from_memory(void *mem, int memlen)
   PackedFile *pf = static_cast<PackedFile *>(MEM_callocN(sizeof(*pf), "PackedFile"));
   pf->data = mem;
   pf->size = memlen;
+  pf->sharing_info = blender::implicit_sharing::info_for_mem_free(mem);
 
   return pf;
 }
@@ -885,7 +889,9 @@ void BKE_packedfile_blend_write(BlendWriter *writer, PackedFile *pf)
     return;
   }
   BLO_write_struct(writer, PackedFile, pf);
-  BLO_write_raw(writer, pf->size, pf->data);
+  BLO_write_shared(writer, pf->data, size_t(pf->size), pf->sharing_info, [&]() {
+    BLO_write_raw(writer, pf->size, pf->data);
+  });
 }
 
 void BKE_packedfile_blend_read(BlendDataReader *reader, PackedFile **pf_p)
@@ -896,7 +902,16 @@ void BKE_packedfile_blend_read(BlendDataReader *reader, PackedFile **pf_p)
     return;
   }
 
-  BLO_read_packed_address(reader, &pf->data);
+  /* The contents are raw bytes, they can reference a memory-mapped file directly. */
+  const auto read_fn = [&]() -> const blender::ImplicitSharingInfo * {
+    BLO_read_packed_address(reader, &pf->data);
+    if (pf->data == nullptr) {
+      return nullptr;
+    }
+    return blender::implicit_sharing::info_for_mem_free(const_cast<void *>(pf->data));
+  };
+  pf->sharing_info = BLO_read_shared_array(
+      reader, const_cast<void **>(&pf->data), pf->size, 1, read_fn);
   if (pf->data == nullptr) {
     /* We cannot allow a PackedFile with a nullptr data field,
      * the whole code assumes this is not possible. See #70315. */
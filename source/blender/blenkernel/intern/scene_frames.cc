@@ -0,0 +1,139 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "BLI_array.hh"
+#include "BLI_task.h"
+#include "BLI_task.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_callbacks.h"
+#include "BKE_node_runtime.hh"
+#include "BKE_pointcache.h"
+#include "BKE_scene.h"
+#include "BKE_scene_frames.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+namespace blender::bke {
+
+/* Evaluating a depsgraph from scratch is much more expensive than evaluating another frame, so
+ * every depsgraph evaluates at least this many frames. */
+static constexpr int64_t min_frames_per_graph = 4;
+
+struct FramesIndependentData {
+  Scene *scene;
+  bool is_independent;
+};
+
+static void frames_independent_check_id(ID *id, void *user_data)
+{
+  FramesIndependentData &data = *static_cast<FramesIndependentData *>(user_data);
+  switch (GS(id->name)) {
+    case ID_SCE: {
+      const Scene *scene = reinterpret_cast<const Scene *>(id);
+      if (scene->rigidbody_world != nullptr) {
+        data.is_independent = false;
+      }
+      break;
+    }
+    case ID_OB: {
+      Object *object = reinterpret_cast<Object *>(id);
+      if (object->rigidbody_object != nullptr || BKE_ptcache_object_has(data.scene, object, 0)) {
+        data.is_independent = false;
+      }
+      break;
+    }
+    case ID_NT: {
+      const bNodeTree *ntree = reinterpret_cast<const bNodeTree *>(id);
+      if (ntree->runtime->runtime_flag & NTREE_RUNTIME_FLAG_HAS_SIMULATION_ZONE) {
+        data.is_independent = false;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+bool scene_graph_frames_are_independent(const Depsgraph *depsgraph)
+{
+  if (BKE_callback_is_used(BKE_CB_EVT_FRAME_CHANGE_PRE) ||
+      BKE_callback_is_used(BKE_CB_EVT_FRAME_CHANGE_POST))
+  {
+    return false;
+  }
+  FramesIndependentData data;
+  data.scene = DEG_get_input_scene(depsgraph);
+  data.is_independent = true;
+  DEG_foreach_ID(depsgraph, frames_independent_check_id, &data);
+  return data.is_independent;
+}
+
+static void evaluate_frames_sequential(Depsgraph *depsgraph,
+                                       const IndexRange frames,
+                                       const FunctionRef<void(Depsgraph *, int)> frame_fn)
+{
+  Scene *scene = DEG_get_input_scene(depsgraph);
+  const int cfra = scene->r.cfra;
+  for (const int64_t frame : frames) {
+    scene->r.cfra = int(frame);
+    BKE_scene_graph_update_for_newframe(depsgraph);
+    frame_fn(depsgraph, int(frame));
+  }
+  scene->r.cfra = cfra;
+}
+
+void scene_graph_evaluate_frames(Depsgraph *depsgraph,
+                                 const IndexRange frames,
+                                 const FunctionRef<Depsgraph *()> build_fn,
+                                 const FunctionRef<void(Depsgraph *depsgraph, int frame)> frame_fn)
+{
+  const int64_t graphs_num = std::min<int64_t>(BLI_task_scheduler_num_threads(),
+                                               frames.size() / min_frames_per_graph);
+  if (graphs_num <= 1 || !scene_graph_frames_are_independent(depsgraph)) {
+    evaluate_frames_sequential(depsgraph, frames, frame_fn);
+    return;
+  }
+
+  /* Building is not done in parallel, it may access data which is only safe to use from the
+   * calling thread. */
+  Array<Depsgraph *> graphs(graphs_num);
+  for (const int64_t i : graphs.index_range()) {
+    graphs[i] = build_fn();
+  }
+
+  threading::parallel_for(graphs.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      Depsgraph *graph = graphs[i];
+      /* Split the frames evenly, every depsgraph steps through consecutive frames so that only
+       * the time dependent part of the graph is evaluated after the first one. */
+      const int64_t chunk_start = frames.size() * i / graphs_num;
+      const int64_t chunk_end = frames.size() * (i + 1) / graphs_num;
+      const IndexRange chunk = frames.slice(chunk_start, chunk_end - chunk_start);
+      /* The evaluation waits for its own tasks, don't let it pick up tasks of the other
+       * depsgraphs in the meantime. */
+      threading::isolate_task([&]() {
+        for (const int64_t frame : chunk) {
+          DEG_evaluate_on_framechange(graph, float(frame));
+          frame_fn(graph, int(frame));
+          DEG_ids_clear_recalc(graph, false);
+        }
+      });
+    }
+  });
+
+  for (Depsgraph *graph : graphs) {
+    DEG_graph_free(graph);
+  }
+}
+
+}  // namespace blender::bke
@@ -18,12 +18,18 @@ namespace blender::array_utils {
  */
 void copy(const GVArray &src, GMutableSpan dst, int64_t grain_size = 4096);
 template<typename T>
-inline void copy(const VArray<T> &src, MutableSpan<T> dst, const int64_t grain_size = 4096)
+inline void copy(
+    const VArray<T> &src,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(src.size() == dst.size());
-  threading::parallel_for(src.index_range(), grain_size, [&](const IndexRange range) {
-    src.materialize_to_uninitialized(range, dst);
-  });
+  threading::parallel_for(
+      src.index_range(),
+      grain_size,
+      [&](const IndexRange range) { src.materialize_to_uninitialized(range, dst); },
+      call_site);
 }
 
 /**
@@ -31,12 +37,18 @@ inline void copy(const VArray<T> &src, MutableSpan<T> dst, const int64_t grain_s
  * grain-size.
  */
 template<typename T>
-inline void copy(const Span<T> src, MutableSpan<T> dst, const int64_t grain_size = 4096)
+inline void copy(
+    const Span<T> src,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(src.size() == dst.size());
-  threading::parallel_for(src.index_range(), grain_size, [&](const IndexRange range) {
-    dst.slice(range).copy_from(src.slice(range));
-  });
+  threading::parallel_for(
+      src.index_range(),
+      grain_size,
+      [&](const IndexRange range) { dst.slice(range).copy_from(src.slice(range)); },
+      call_site);
 }
 
 /**
@@ -53,14 +65,16 @@ void copy(const GVArray &src,
  * grain-size.
  */
 template<typename T>
-inline void copy(const Span<T> src,
-                 const IndexMask &selection,
-                 MutableSpan<T> dst,
-                 const int64_t grain_size = 4096)
+inline void copy(
+    const Span<T> src,
+    const IndexMask &selection,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(src.size() == dst.size());
-  selection.foreach_index_optimized<int64_t>(GrainSize(grain_size),
-                                             [&](const int64_t i) { dst[i] = src[i]; });
+  selection.foreach_index_optimized<int64_t>(
+      GrainSize(grain_size), [&](const int64_t i) { dst[i] = src[i]; }, call_site);
 }
 
 /**
@@ -80,68 +94,90 @@ void gather(GSpan src, const IndexMask &indices, GMutableSpan dst, int64_t grain
  * Fill the destination span by gathering indexed values from the `src` array.
  */
 template<typename T>
-inline void gather(const VArray<T> &src,
-                   const IndexMask &indices,
-                   MutableSpan<T> dst,
-                   const int64_t grain_size = 4096)
+inline void gather(
+    const VArray<T> &src,
+    const IndexMask &indices,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(indices.size() == dst.size());
-  threading::parallel_for(indices.index_range(), grain_size, [&](const IndexRange range) {
-    src.materialize_compressed_to_uninitialized(indices.slice(range), dst.slice(range));
-  });
+  threading::parallel_for(
+      indices.index_range(),
+      grain_size,
+      [&](const IndexRange range) {
+        src.materialize_compressed_to_uninitialized(indices.slice(range), dst.slice(range));
+      },
+      call_site);
 }
 
 /**
  * Fill the destination span by gathering indexed values from the `src` array.
  */
 template<typename T, typename IndexT>
-inline void gather(const Span<T> src,
-                   const IndexMask &indices,
-                   MutableSpan<T> dst,
-                   const int64_t grain_size = 4096)
+inline void gather(
+    const Span<T> src,
+    const IndexMask &indices,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(indices.size() == dst.size());
-  indices.foreach_segment(GrainSize(grain_size),
-                          [&](const IndexMaskSegment segment, const int64_t segment_pos) {
-                            for (const int64_t i : segment.index_range()) {
-                              dst[segment_pos + i] = src[segment[i]];
-                            }
-                          });
+  indices.foreach_segment(
+      GrainSize(grain_size),
+      [&](const IndexMaskSegment segment, const int64_t segment_pos) {
+        for (const int64_t i : segment.index_range()) {
+          dst[segment_pos + i] = src[segment[i]];
+        }
+      },
+      call_site);
 }
 
 /**
  * Fill the destination span by gathering indexed values from the `src` array.
  */
 template<typename T, typename IndexT>
-inline void gather(const Span<T> src,
-                   const Span<IndexT> indices,
-                   MutableSpan<T> dst,
-                   const int64_t grain_size = 4096)
+inline void gather(
+    const Span<T> src,
+    const Span<IndexT> indices,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(indices.size() == dst.size());
-  threading::parallel_for(indices.index_range(), grain_size, [&](const IndexRange range) {
-    for (const int64_t i : range) {
-      dst[i] = src[indices[i]];
-    }
-  });
+  threading::parallel_for(
+      indices.index_range(),
+      grain_size,
+      [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          dst[i] = src[indices[i]];
+        }
+      },
+      call_site);
 }
 
 /**
  * Fill the destination span by gathering indexed values from the `src` array.
  */
 template<typename T, typename IndexT>
-inline void gather(const VArray<T> &src,
-                   const Span<IndexT> indices,
-                   MutableSpan<T> dst,
-                   const int64_t grain_size = 4096)
+inline void gather(
+    const VArray<T> &src,
+    const Span<IndexT> indices,
+    MutableSpan<T> dst,
+    const int64_t grain_size = 4096,
+    const threading::detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   BLI_assert(indices.size() == dst.size());
   devirtualize_varray(src, [&](const auto &src) {
-    threading::parallel_for(indices.index_range(), grain_size, [&](const IndexRange range) {
-      for (const int64_t i : range) {
-        dst[i] = src[indices[i]];
-      }
-    });
+    threading::parallel_for(
+        indices.index_range(),
+        grain_size,
+        [&](const IndexRange range) {
+          for (const int64_t i : range) {
+            dst[i] = src[indices[i]];
+          }
+        },
+        call_site);
   });
 }
 
@@ -42,6 +42,14 @@ bool BLI_expr_pylike_is_constant(struct ExprPyLike_Parsed *expr);
  * Check if the parsed expression uses the parameter with the given index.
  */
 bool BLI_expr_pylike_is_using_param(struct ExprPyLike_Parsed *expr, int index);
+/**
+ * Get the number of distinct references used by the expression, see #BLI_expr_pylike_parse_ex.
+ */
+int BLI_expr_pylike_refs_count(struct ExprPyLike_Parsed *expr);
+/**
+ * Get the path of a reference relative to its root, e.g. `location[0]` for `self.location[0]`.
+ */
+const char *BLI_expr_pylike_ref_path(struct ExprPyLike_Parsed *expr, int index);
 /**
  * Compile the expression and return the result.
  *
@@ -51,6 +59,15 @@ bool BLI_expr_pylike_is_using_param(struct ExprPyLike_Parsed *expr, int index);
 ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
                                          const char **param_names,
                                          int param_names_len);
+/**
+ * Same as #BLI_expr_pylike_parse, but also accepts references like `root.attr[index]`, where the
+ * root name is given by `ref_root` (may be NULL). Every distinct reference is evaluated as an
+ * additional parameter after the named ones, its value has to be provided by the caller.
+ */
+ExprPyLike_Parsed *BLI_expr_pylike_parse_ex(const char *expression,
+                                            const char **param_names,
+                                            int param_names_len,
+                                            const char *ref_root);
 /**
  * Evaluate the expression with the given parameters.
  * The order and number of parameters must match the names given to parse.
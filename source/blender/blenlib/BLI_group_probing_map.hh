@@ -0,0 +1,1236 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::GroupProbingMap<Key, Value>` is a hash map with the same interface as
+ * `blender::Map`, but a different memory layout that is faster for large maps with many lookups.
+ *
+ * The map stores one control byte per slot in a separate array, in front of the slots. A control
+ * byte is either empty, removed or contains 7 bits of the hash of the key in the slot. The slots
+ * are split into groups of #group_probing::GROUP_SIZE (16) slots, and instead of probing slot by
+ * slot, a whole group of control bytes is compared with the hash bits in a few SIMD instructions.
+ * Only slots whose control byte matches have to be compared with the key, so even long probing
+ * sequences rarely have to touch the slots themselves. This is the layout known as "Swiss table".
+ *
+ * Compared to #Map:
+ * - Lookups that fail and lookups in tables that don't fit in the cache are significantly faster,
+ *   because most of the time only the control bytes of a single group are read.
+ * - The max load factor is 7/8 instead of 1/2, so less memory is used per element.
+ * - There is no inline buffer, an empty map does not allocate.
+ * - The hash is remixed, so weak hash functions (like the identity hash used for integers and
+ *   pointers) still result in a good distribution.
+ *
+ * For small maps with cheap keys #Map is still the better default. Switching a map to this type
+ * only requires changing its type, because the method names and semantics are the same as in
+ * #Map. See #GroupProbingSet for the equivalent of #Set.
+ */
+
+#include <optional>
+
+#include "BLI_allocator.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_map.hh"
+#include "BLI_math_bits.h"
+#include "BLI_memory_utils.hh"
+#include "BLI_simd.h"
+#include "BLI_utildefines.h"
+
+namespace blender {
+
+namespace group_probing {
+
+/** Number of slots whose control bytes are compared at once. */
+constexpr int64_t GROUP_SIZE = 16;
+
+/** Control byte of a slot that never contained a key. */
+constexpr uint8_t CTRL_EMPTY = 0x80;
+/** Control byte of a slot whose key has been removed. */
+constexpr uint8_t CTRL_REMOVED = 0xFE;
+/** Occupied slots store the lower 7 bits of the hash in their control byte, the high bit is 0. */
+constexpr uint8_t CTRL_HASH_MASK = 0x7F;
+
+/** The max load factor is 7/8. */
+constexpr int64_t LOAD_FACTOR_NUMERATOR = 7;
+constexpr int64_t LOAD_FACTOR_DENOMINATOR = 8;
+
+inline bool ctrl_is_occupied(const uint8_t ctrl)
+{
+  return (ctrl & 0x80) == 0;
+}
+
+/**
+ * Mix the bits of the hash, because the lower bits are used for the control byte and the higher
+ * bits for the group index. The default hash of many types is the identity, which would otherwise
+ * put all small integers into the same group.
+ */
+inline uint64_t mix_hash(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdLLU;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+inline uint8_t hash_to_ctrl(const uint64_t mixed_hash)
+{
+  return uint8_t(mixed_hash & CTRL_HASH_MASK);
+}
+
+inline uint64_t hash_to_group(const uint64_t mixed_hash)
+{
+  return mixed_hash >> 7;
+}
+
+/**
+ * Bits of matching slots in a group. The lowest bit corresponds to the first slot in the group.
+ */
+class BitMask {
+ private:
+  uint32_t mask_;
+
+ public:
+  explicit BitMask(const uint32_t mask) : mask_(mask) {}
+
+  bool has_any() const
+  {
+    return mask_ != 0;
+  }
+
+  /** Index of the first matching slot in the group. */
+  int64_t first() const
+  {
+    BLI_assert(this->has_any());
+    return int64_t(bitscan_forward_uint(mask_));
+  }
+
+  /** Iterate over the indices of all matching slots in the group. */
+  template<typename Fn> void foreach_index(const Fn &fn) const
+  {
+    for (uint32_t mask = mask_; mask != 0; mask &= mask - 1) {
+      fn(int64_t(bitscan_forward_uint(mask)));
+    }
+  }
+};
+
+/** The control bytes of one group, loaded so that they can be compared with SIMD instructions. */
+class Group {
+ private:
+#if BLI_HAVE_SSE2
+  __m128i ctrl_;
+#else
+  const uint8_t *ctrl_;
+#endif
+
+ public:
+  explicit Group(const uint8_t *ctrl)
+  {
+    BLI_assert(uintptr_t(ctrl) % GROUP_SIZE == 0);
+#if BLI_HAVE_SSE2
+    ctrl_ = _mm_load_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    ctrl_ = ctrl;
+#endif
+  }
+
+  /** Slots with the given control byte. */
+  BitMask match(const uint8_t ctrl) const
+  {
+#if BLI_HAVE_SSE2
+    return BitMask(
+        uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(char(ctrl))))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; i++) {
+      mask |= uint32_t(ctrl_[i] == ctrl) << i;
+    }
+    return BitMask(mask);
+#endif
+  }
+
+  BitMask match_empty() const
+  {
+    return this->match(CTRL_EMPTY);
+  }
+
+  /** Slots that are empty or removed, i.e. that can be used for a new key. */
+  BitMask match_free() const
+  {
+#if BLI_HAVE_SSE2
+    return BitMask(uint32_t(_mm_movemask_epi8(ctrl_)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; i++) {
+      mask |= uint32_t(!ctrl_is_occupied(ctrl_[i])) << i;
+    }
+    return BitMask(mask);
+#endif
+  }
+};
+
+/**
+ * Iterates over groups with triangular numbers as offsets. Since the number of groups is a power
+ * of two, every group is visited exactly once within the first `groups_num` steps.
+ */
+class GroupProbing {
+ private:
+  uint64_t group_;
+  uint64_t step_ = 0;
+  uint64_t group_mask_;
+
+ public:
+  GroupProbing(const uint64_t mixed_hash, const uint64_t group_mask)
+      : group_(hash_to_group(mixed_hash) & group_mask), group_mask_(group_mask)
+  {
+  }
+
+  /** Index of the first slot in the current group. */
+  int64_t offset() const
+  {
+    return int64_t(group_ * GROUP_SIZE);
+  }
+
+  void next()
+  {
+    step_++;
+    group_ = (group_ + step_) & group_mask_;
+  }
+};
+
+/** Value type used by #GroupProbingSet, which does not need any space in the slot. */
+struct EmptyValue {
+};
+
+template<typename Key, typename Value> struct Slot {
+  Key key;
+  BLI_NO_UNIQUE_ADDRESS Value value;
+};
+
+}  // namespace group_probing
+
+template<
+    /**
+     * Type of the keys stored in the map. Keys have to be movable. Furthermore, the hash and
+     * is-equal functions have to support it.
+     */
+    typename Key,
+    /**
+     * Type of the value that is stored per key. It has to be movable as well.
+     */
+    typename Value,
+    /**
+     * The hash function used to hash the keys. There is a default for many types. See BLI_hash.hh
+     * for examples on how to define a custom hash function.
+     */
+    typename Hash = DefaultHash<Key>,
+    /**
+     * The equality operator used to compare keys. By default it will simply compare keys using the
+     * `==` operator.
+     */
+    typename IsEqual = DefaultEquality<Key>,
+    /**
+     * The allocator used by this map. Should rarely be changed, except when you don't want that
+     * MEM_* is used internally.
+     */
+    typename Allocator = GuardedAllocator>
+class GroupProbingMap {
+ public:
+  using size_type = int64_t;
+  using Item = MapItem<Key, Value>;
+  using MutableItem = MutableMapItem<Key, Value>;
+
+ private:
+  using Slot = group_probing::Slot<Key, Value>;
+  using Group = group_probing::Group;
+  using GroupProbing = group_probing::GroupProbing;
+
+  /**
+   * One control byte per slot, followed by the slots. Both are in the same allocation. This is
+   * null when the map never contained any key.
+   */
+  uint8_t *ctrl_ = nullptr;
+  Slot *slots_ = nullptr;
+
+  /** Number of slots, zero or a power of two that is at least #group_probing::GROUP_SIZE. */
+  int64_t capacity_ = 0;
+  int64_t occupied_slots_ = 0;
+  int64_t removed_slots_ = 0;
+  /** Number of slots that can be occupied or removed before the map has to grow. */
+  int64_t usable_slots_ = 0;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+  BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
+
+  /**
+   * Iterate over all occupied slots whose control byte matches the hash, until the key is found
+   * (the loop body returns) or a group with an empty slot proves that the key is not in the map.
+   */
+#define GROUP_PROBING_BEGIN(MIXED_HASH, R_PROBING) \
+  for (GroupProbing R_PROBING(MIXED_HASH, this->group_mask());; R_PROBING.next()) { \
+    const Group group(ctrl_ + R_PROBING.offset());
+#define GROUP_PROBING_END() \
+  if (group.match_empty().has_any()) { \
+    break; \
+  } \
+  }
+
+ public:
+  GroupProbingMap(Allocator allocator = {}) noexcept : allocator_(allocator) {}
+
+  GroupProbingMap(NoExceptConstructor, Allocator allocator = {}) noexcept
+      : GroupProbingMap(allocator)
+  {
+  }
+
+  GroupProbingMap(const GroupProbingMap &other)
+      : hash_(other.hash_), is_equal_(other.is_equal_), allocator_(other.allocator_)
+  {
+    if (other.capacity_ == 0) {
+      return;
+    }
+    this->allocate(other.capacity_);
+    memcpy(ctrl_, other.ctrl_, size_t(capacity_));
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (group_probing::ctrl_is_occupied(ctrl_[i])) {
+        try {
+          new (&slots_[i]) Slot(other.slots_[i]);
+        }
+        catch (...) {
+          /* Only destruct the slots that have been copied already. */
+          memset(ctrl_ + i, group_probing::CTRL_EMPTY, size_t(capacity_ - i));
+          this->noexcept_reset();
+          throw;
+        }
+      }
+    }
+    occupied_slots_ = other.occupied_slots_;
+    removed_slots_ = other.removed_slots_;
+    usable_slots_ = other.usable_slots_;
+  }
+
+  GroupProbingMap(GroupProbingMap &&other) noexcept
+      : ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        occupied_slots_(other.occupied_slots_),
+        removed_slots_(other.removed_slots_),
+        usable_slots_(other.usable_slots_),
+        hash_(std::move(other.hash_)),
+        is_equal_(std::move(other.is_equal_)),
+        allocator_(other.allocator_)
+  {
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.capacity_ = 0;
+    other.occupied_slots_ = 0;
+    other.removed_slots_ = 0;
+    other.usable_slots_ = 0;
+  }
+
+  ~GroupProbingMap()
+  {
+    this->destruct_slots();
+    if (ctrl_ != nullptr) {
+      allocator_.deallocate(ctrl_);
+    }
+  }
+
+  GroupProbingMap &operator=(const GroupProbingMap &other)
+  {
+    return copy_assign_container(*this, other);
+  }
+
+  GroupProbingMap &operator=(GroupProbingMap &&other)
+  {
+    return move_assign_container(*this, std::move(other));
+  }
+
+  /**
+   * Insert a new key-value-pair into the map. This invokes undefined behavior when the key is in
+   * the map already.
+   */
+  void add_new(const Key &key, const Value &value)
+  {
+    this->add_new_as(key, value);
+  }
+  void add_new(const Key &key, Value &&value)
+  {
+    this->add_new_as(key, std::move(value));
+  }
+  void add_new(Key &&key, const Value &value)
+  {
+    this->add_new_as(std::move(key), value);
+  }
+  void add_new(Key &&key, Value &&value)
+  {
+    this->add_new_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  void add_new_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    BLI_assert(!this->contains_as(key));
+    this->ensure_can_add();
+    const uint64_t mixed_hash = this->mixed_hash(key);
+    const int64_t index = this->find_free_slot(mixed_hash);
+    this->occupy(index, mixed_hash, std::forward<ForwardKey>(key), [&](Value *ptr) {
+      new (ptr) Value(std::forward<ForwardValue>(value)...);
+    });
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(const Key &key, Value &&value)
+  {
+    return this->add_as(key, std::move(value));
+  }
+  bool add(Key &&key, const Value &value)
+  {
+    return this->add_as(std::move(key), value);
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    bool added = false;
+    this->lookup_or_add_cb__impl(std::forward<ForwardKey>(key), [&](Value *ptr) {
+      new (ptr) Value(std::forward<ForwardValue>(value)...);
+      added = true;
+    });
+    return added;
+  }
+
+  /**
+   * Adds a key-value-pair to the map. If the map contained the key already, the corresponding
+   * value will be replaced. Returns true when the key has been newly added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    return this->add_overwrite_as(key, value);
+  }
+  bool add_overwrite(const Key &key, Value &&value)
+  {
+    return this->add_overwrite_as(key, std::move(value));
+  }
+  bool add_overwrite(Key &&key, const Value &value)
+  {
+    return this->add_overwrite_as(std::move(key), value);
+  }
+  bool add_overwrite(Key &&key, Value &&value)
+  {
+    return this->add_overwrite_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_overwrite_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    bool added = false;
+    Value &stored_value = this->lookup_or_add_cb__impl(
+        std::forward<ForwardKey>(key), [&](Value *ptr) {
+          new (ptr) Value(std::forward<ForwardValue>(value)...);
+          added = true;
+        });
+    if (!added) {
+      stored_value = Value(std::forward<ForwardValue>(value)...);
+    }
+    return added;
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->find_slot(key) != -1;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. Returns true when the key was contained and is
+   * now removed, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key);
+    if (index == -1) {
+      return false;
+    }
+    this->remove_slot(index);
+    return true;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. This invokes undefined behavior when the key is
+   * not in the map.
+   */
+  void remove_contained(const Key &key)
+  {
+    this->remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key);
+    BLI_assert(index != -1);
+    this->remove_slot(index);
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. This invokes
+   * undefined behavior when the key is not in the map.
+   */
+  Value pop(const Key &key)
+  {
+    return this->pop_as(key);
+  }
+  template<typename ForwardKey> Value pop_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key);
+    BLI_assert(index != -1);
+    Value value = std::move(slots_[index].value);
+    this->remove_slot(index);
+    return value;
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. If the key is not
+   * in the map, a value-less optional is returned.
+   */
+  std::optional<Value> pop_try(const Key &key)
+  {
+    return this->pop_try_as(key);
+  }
+  template<typename ForwardKey> std::optional<Value> pop_try_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key);
+    if (index == -1) {
+      return {};
+    }
+    std::optional<Value> value = std::move(slots_[index].value);
+    this->remove_slot(index);
+    return value;
+  }
+
+  /**
+   * Returns a pointer to the value that corresponds to the given key. If the key is not in the
+   * map, nullptr is returned.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  Value *lookup_ptr(const Key &key)
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key);
+    return index == -1 ? nullptr : &slots_[index].value;
+  }
+  template<typename ForwardKey> Value *lookup_ptr_as(const ForwardKey &key)
+  {
+    return const_cast<Value *>(const_cast<const GroupProbingMap *>(this)->lookup_ptr_as(key));
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. This invokes undefined
+   * behavior when the key is not in the map.
+   */
+  const Value &lookup(const Key &key) const
+  {
+    return this->lookup_as(key);
+  }
+  Value &lookup(const Key &key)
+  {
+    return this->lookup_as(key);
+  }
+  template<typename ForwardKey> const Value &lookup_as(const ForwardKey &key) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+  template<typename ForwardKey> Value &lookup_as(const ForwardKey &key)
+  {
+    Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the
+   * map, the provided default_value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    return this->lookup_default_as(key, default_value);
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value lookup_default_as(const ForwardKey &key, ForwardValue &&...default_value) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    if (ptr != nullptr) {
+      return *ptr;
+    }
+    return Value(std::forward<ForwardValue>(default_value)...);
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added with the given value.
+   */
+  Value &lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_as(key, value);
+  }
+  Value &lookup_or_add(Key &&key, Value &&value)
+  {
+    return this->lookup_or_add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value &lookup_or_add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    return this->lookup_or_add_cb__impl(std::forward<ForwardKey>(key), [&](Value *ptr) {
+      new (ptr) Value(std::forward<ForwardValue>(value)...);
+    });
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added. The value is created by the given callback, which is only
+   * called when the key is not in the map yet.
+   */
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(key, create_value);
+  }
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(Key &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(std::move(key), create_value);
+  }
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb_as(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb__impl(std::forward<ForwardKey>(key),
+                                        [&](Value *ptr) { new (ptr) Value(create_value()); });
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added with a default constructed value.
+   */
+  Value &lookup_or_add_default(const Key &key)
+  {
+    return this->lookup_or_add_default_as(key);
+  }
+  Value &lookup_or_add_default(Key &&key)
+  {
+    return this->lookup_or_add_default_as(std::move(key));
+  }
+  template<typename ForwardKey> Value &lookup_or_add_default_as(ForwardKey &&key)
+  {
+    return this->lookup_or_add_cb__impl(std::forward<ForwardKey>(key),
+                                        [&](Value *ptr) { new (ptr) Value(); });
+  }
+
+  /**
+   * Returns a pointer to the key that is stored in the map that compares equal to the given key.
+   * If the key is not in the map, nullptr is returned.
+   */
+  const Key *lookup_key_ptr(const Key &key) const
+  {
+    return this->lookup_key_ptr_as(key);
+  }
+  template<typename ForwardKey> const Key *lookup_key_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key);
+    return index == -1 ? nullptr : &slots_[index].key;
+  }
+
+  /**
+   * Calls the provided callback for every key-value-pair in the map. The callback is expected
+   * to take a `const Key &` as first and a `const Value &` as second parameter.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func) const
+  {
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (group_probing::ctrl_is_occupied(ctrl_[i])) {
+        func(slots_[i].key, slots_[i].value);
+      }
+    }
+  }
+
+  /* Common base class for all iterators below. */
+  struct BaseIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+
+   protected:
+    const uint8_t *ctrl_;
+    Slot *slots_;
+    int64_t total_slots_;
+    int64_t current_slot_;
+
+    friend GroupProbingMap;
+
+   public:
+    BaseIterator(const uint8_t *ctrl,
+                 const Slot *slots,
+                 const int64_t total_slots,
+                 const int64_t current_slot)
+        : ctrl_(ctrl),
+          slots_(const_cast<Slot *>(slots)),
+          total_slots_(total_slots),
+          current_slot_(current_slot)
+    {
+    }
+
+    BaseIterator &operator++()
+    {
+      while (++current_slot_ < total_slots_) {
+        if (group_probing::ctrl_is_occupied(ctrl_[current_slot_])) {
+          break;
+        }
+      }
+      return *this;
+    }
+
+    BaseIterator operator++(int)
+    {
+      BaseIterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    friend bool operator!=(const BaseIterator &a, const BaseIterator &b)
+    {
+      BLI_assert(a.slots_ == b.slots_);
+      return a.current_slot_ != b.current_slot_;
+    }
+
+    friend bool operator==(const BaseIterator &a, const BaseIterator &b)
+    {
+      return !(a != b);
+    }
+
+   protected:
+    Slot &current_slot() const
+    {
+      return slots_[current_slot_];
+    }
+  };
+
+  /**
+   * A utility iterator that reduces the amount of code when implementing the actual iterators.
+   * This uses the "curiously recurring template pattern" (CRTP).
+   */
+  template<typename SubIterator> class BaseIteratorRange : public BaseIterator {
+   public:
+    BaseIteratorRange(const uint8_t *ctrl,
+                      const Slot *slots,
+                      int64_t total_slots,
+                      int64_t current_slot)
+        : BaseIterator(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    SubIterator begin() const
+    {
+      for (int64_t i = 0; i < this->total_slots_; i++) {
+        if (group_probing::ctrl_is_occupied(this->ctrl_[i])) {
+          return SubIterator(this->ctrl_, this->slots_, this->total_slots_, i);
+        }
+      }
+      return this->end();
+    }
+
+    SubIterator end() const
+    {
+      return SubIterator(this->ctrl_, this->slots_, this->total_slots_, this->total_slots_);
+    }
+  };
+
+  class KeyIterator final : public BaseIteratorRange<KeyIterator> {
+   public:
+    using value_type = Key;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    KeyIterator(const uint8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : BaseIteratorRange<KeyIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    const Key &operator*() const
+    {
+      return this->current_slot().key;
+    }
+  };
+
+  class ValueIterator final : public BaseIteratorRange<ValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = const Value *;
+    using reference = const Value &;
+
+    ValueIterator(const uint8_t *ctrl,
+                  const Slot *slots,
+                  int64_t total_slots,
+                  int64_t current_slot)
+        : BaseIteratorRange<ValueIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    const Value &operator*() const
+    {
+      return this->current_slot().value;
+    }
+  };
+
+  class MutableValueIterator final : public BaseIteratorRange<MutableValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = Value *;
+    using reference = Value &;
+
+    MutableValueIterator(const uint8_t *ctrl,
+                         Slot *slots,
+                         int64_t total_slots,
+                         int64_t current_slot)
+        : BaseIteratorRange<MutableValueIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    Value &operator*()
+    {
+      return this->current_slot().value;
+    }
+  };
+
+  class ItemIterator final : public BaseIteratorRange<ItemIterator> {
+   public:
+    using value_type = Item;
+    using pointer = Item *;
+    using reference = Item &;
+
+    ItemIterator(const uint8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : BaseIteratorRange<ItemIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    Item operator*() const
+    {
+      const Slot &slot = this->current_slot();
+      return {slot.key, slot.value};
+    }
+  };
+
+  class MutableItemIterator final : public BaseIteratorRange<MutableItemIterator> {
+   public:
+    using value_type = MutableItem;
+    using pointer = MutableItem *;
+    using reference = MutableItem &;
+
+    MutableItemIterator(const uint8_t *ctrl,
+                        Slot *slots,
+                        int64_t total_slots,
+                        int64_t current_slot)
+        : BaseIteratorRange<MutableItemIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    MutableItem operator*() const
+    {
+      Slot &slot = this->current_slot();
+      return {slot.key, slot.value};
+    }
+  };
+
+  /**
+   * Allows writing a range-for loop that iterates over all keys. The iterator is invalidated, when
+   * the map is changed.
+   */
+  KeyIterator keys() const
+  {
+    return KeyIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map. The iterator is invalidated, when the map is
+   * changed.
+   */
+  ValueIterator values() const
+  {
+    return ValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map and allows you to change the values. The
+   * iterator is invalidated, when the map is changed.
+   */
+  MutableValueIterator values()
+  {
+    return MutableValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map. The key-value-pairs are stored in a
+   * #MapItem. The iterator is invalidated, when the map is changed.
+   */
+  ItemIterator items() const
+  {
+    return ItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map. The key-value-pairs are stored in a
+   * #MutableMapItem. The iterator is invalidated, when the map is changed.
+   */
+  MutableItemIterator items()
+  {
+    return MutableItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Remove the key-value-pair that the iterator is currently pointing at.
+   * It is valid to call this method while iterating over the map. However, after this method has
+   * been called, the removed element must not be accessed anymore.
+   */
+  void remove(const BaseIterator &iterator)
+  {
+    BLI_assert(group_probing::ctrl_is_occupied(ctrl_[iterator.current_slot_]));
+    this->remove_slot(iterator.current_slot_);
+  }
+
+  /**
+   * Remove all key-value-pairs for that the given predicate is true and return the number of
+   * removed pairs.
+   */
+  template<typename Predicate> int64_t remove_if(Predicate &&predicate)
+  {
+    const int64_t prev_size = this->size();
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (group_probing::ctrl_is_occupied(ctrl_[i])) {
+        if (predicate(MutableItem{slots_[i].key, slots_[i].value})) {
+          this->remove_slot(i);
+        }
+      }
+    }
+    return prev_size - this->size();
+  }
+
+  /**
+   * Return the number of key-value-pairs that are stored in the map.
+   */
+  int64_t size() const
+  {
+    return occupied_slots_;
+  }
+
+  /**
+   * Returns true if there are no elements in the map.
+   */
+  bool is_empty() const
+  {
+    return occupied_slots_ == 0;
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Returns the amount of removed slots in the map. This is mostly for debugging purposes.
+   */
+  int64_t removed_amount() const
+  {
+    return removed_slots_;
+  }
+
+  /**
+   * Returns the bytes required per element. This is mostly for debugging purposes.
+   */
+  int64_t size_per_element() const
+  {
+    return sizeof(Slot) + 1;
+  }
+
+  /**
+   * Returns the approximate memory requirements of the map in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return this->size_per_element() * capacity_;
+  }
+
+  /**
+   * Potentially resize the map such that the specified number of elements can be added without
+   * another grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    if (usable_slots_ < n) {
+      this->realloc_and_reinsert(n);
+    }
+  }
+
+  /**
+   * Removes all key-value-pairs from the map. The allocated memory is kept.
+   */
+  void clear()
+  {
+    this->destruct_slots();
+    if (capacity_ > 0) {
+      memset(ctrl_, group_probing::CTRL_EMPTY, size_t(capacity_));
+    }
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+  }
+
+  /**
+   * Removes all key-value-pairs from the map and frees any allocated memory.
+   */
+  void clear_and_shrink()
+  {
+    std::destroy_at(this);
+    new (this) GroupProbingMap(NoExceptConstructor{});
+  }
+
+  /**
+   * Get the number of groups that have to be checked to find the key or to determine that it is
+   * not in the map, minus one. This is mostly for debugging purposes.
+   */
+  int64_t count_collisions(const Key &key) const
+  {
+    if (capacity_ == 0) {
+      return 0;
+    }
+    const uint64_t mixed_hash = this->mixed_hash(key);
+    const uint8_t ctrl = group_probing::hash_to_ctrl(mixed_hash);
+    int64_t collisions = 0;
+    GROUP_PROBING_BEGIN (mixed_hash, probing) {
+      bool found = false;
+      group.match(ctrl).foreach_index([&](const int64_t i) {
+        found |= is_equal_(key, slots_[probing.offset() + i].key);
+      });
+      if (found) {
+        break;
+      }
+      collisions++;
+    }
+    GROUP_PROBING_END();
+    return collisions;
+  }
+
+ private:
+  uint64_t group_mask() const
+  {
+    return uint64_t(capacity_ / group_probing::GROUP_SIZE) - 1;
+  }
+
+  template<typename ForwardKey> uint64_t mixed_hash(const ForwardKey &key) const
+  {
+    return group_probing::mix_hash(hash_(key));
+  }
+
+  /** Index of the slot that contains the key, or -1 when it is not in the map. */
+  template<typename ForwardKey> int64_t find_slot(const ForwardKey &key) const
+  {
+    if (capacity_ == 0) {
+      return -1;
+    }
+    const uint64_t mixed_hash = this->mixed_hash(key);
+    const uint8_t ctrl = group_probing::hash_to_ctrl(mixed_hash);
+    GROUP_PROBING_BEGIN (mixed_hash, probing) {
+      int64_t found_index = -1;
+      group.match(ctrl).foreach_index([&](const int64_t i) {
+        if (found_index == -1 && is_equal_(key, slots_[probing.offset() + i].key)) {
+          found_index = probing.offset() + i;
+        }
+      });
+      if (found_index != -1) {
+        return found_index;
+      }
+    }
+    GROUP_PROBING_END();
+    return -1;
+  }
+
+  /** Index of the first slot along the probing sequence that can be used for a new key. */
+  int64_t find_free_slot(const uint64_t mixed_hash) const
+  {
+    BLI_assert(capacity_ > 0);
+    for (GroupProbing probing(mixed_hash, this->group_mask());; probing.next()) {
+      const Group group(ctrl_ + probing.offset());
+      const group_probing::BitMask free = group.match_free();
+      if (free.has_any()) {
+        return probing.offset() + free.first();
+      }
+    }
+  }
+
+  /**
+   * Return the value for the key, or add the key and construct the value in-place with
+   * `create_value(Value *)`.
+   */
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb__impl(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    const int64_t found_index = this->find_slot(key);
+    if (found_index != -1) {
+      return slots_[found_index].value;
+    }
+    this->ensure_can_add();
+    const uint64_t mixed_hash = this->mixed_hash(key);
+    const int64_t index = this->find_free_slot(mixed_hash);
+    this->occupy(index, mixed_hash, std::forward<ForwardKey>(key), create_value);
+    return slots_[index].value;
+  }
+
+  template<typename ForwardKey, typename CreateValueF>
+  void occupy(const int64_t index,
+              const uint64_t mixed_hash,
+              ForwardKey &&key,
+              const CreateValueF &create_value)
+  {
+    BLI_assert(!group_probing::ctrl_is_occupied(ctrl_[index]));
+    Slot &slot = slots_[index];
+    create_value(&slot.value);
+    try {
+      new (&slot.key) Key(std::forward<ForwardKey>(key));
+    }
+    catch (...) {
+      slot.value.~Value();
+      throw;
+    }
+    if (ctrl_[index] == group_probing::CTRL_REMOVED) {
+      removed_slots_--;
+    }
+    ctrl_[index] = group_probing::hash_to_ctrl(mixed_hash);
+    occupied_slots_++;
+  }
+
+  void remove_slot(const int64_t index)
+  {
+    BLI_assert(group_probing::ctrl_is_occupied(ctrl_[index]));
+    slots_[index].~Slot();
+    occupied_slots_--;
+    /* If the group has an empty slot, no probing sequence continues past this group, so the slot
+     * can become empty again instead of leaving a removed marker. */
+    const int64_t group_offset = index - index % group_probing::GROUP_SIZE;
+    if (Group(ctrl_ + group_offset).match_empty().has_any()) {
+      ctrl_[index] = group_probing::CTRL_EMPTY;
+    }
+    else {
+      ctrl_[index] = group_probing::CTRL_REMOVED;
+      removed_slots_++;
+    }
+  }
+
+  void ensure_can_add()
+  {
+    if (occupied_slots_ + removed_slots_ >= usable_slots_) {
+      this->realloc_and_reinsert(occupied_slots_ + 1);
+      BLI_assert(occupied_slots_ + removed_slots_ < usable_slots_);
+    }
+  }
+
+  void allocate(const int64_t capacity)
+  {
+    BLI_assert(capacity % group_probing::GROUP_SIZE == 0);
+    BLI_assert(is_power_of_2_constexpr(capacity));
+    const int64_t slots_offset = ceil_division<int64_t>(capacity, alignof(Slot)) * alignof(Slot);
+    void *buffer = allocator_.allocate(size_t(slots_offset + capacity * int64_t(sizeof(Slot))),
+                                       std::max<size_t>(group_probing::GROUP_SIZE, alignof(Slot)),
+                                       AT);
+    ctrl_ = static_cast<uint8_t *>(buffer);
+    slots_ = reinterpret_cast<Slot *>(ctrl_ + slots_offset);
+    memset(ctrl_, group_probing::CTRL_EMPTY, size_t(capacity));
+    capacity_ = capacity;
+    usable_slots_ = floor_multiplication_with_fraction(capacity,
+                                                       group_probing::LOAD_FACTOR_NUMERATOR,
+                                                       group_probing::LOAD_FACTOR_DENOMINATOR);
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+  }
+
+  BLI_NOINLINE void realloc_and_reinsert(const int64_t min_usable_slots)
+  {
+    const int64_t new_capacity = std::max<int64_t>(
+        group_probing::GROUP_SIZE,
+        total_slot_amount_for_usable_slots(min_usable_slots,
+                                           group_probing::LOAD_FACTOR_NUMERATOR,
+                                           group_probing::LOAD_FACTOR_DENOMINATOR));
+    uint8_t *old_ctrl = ctrl_;
+    Slot *old_slots = slots_;
+    const int64_t old_capacity = capacity_;
+    const int64_t old_size = occupied_slots_;
+
+    this->allocate(new_capacity);
+    for (const int64_t i : IndexRange(old_capacity)) {
+      if (group_probing::ctrl_is_occupied(old_ctrl[i])) {
+        Slot &old_slot = old_slots[i];
+        const uint64_t mixed_hash = this->mixed_hash(old_slot.key);
+        const int64_t index = this->find_free_slot(mixed_hash);
+        /* Moving keys and values is assumed to not throw here. */
+        new (&slots_[index]) Slot(std::move(old_slot));
+        old_slot.~Slot();
+        ctrl_[index] = group_probing::hash_to_ctrl(mixed_hash);
+      }
+    }
+    occupied_slots_ = old_size;
+    if (old_ctrl != nullptr) {
+      allocator_.deallocate(old_ctrl);
+    }
+  }
+
+  void destruct_slots()
+  {
+    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+      for (const int64_t i : IndexRange(capacity_)) {
+        if (group_probing::ctrl_is_occupied(ctrl_[i])) {
+          slots_[i].~Slot();
+        }
+      }
+    }
+  }
+
+  void noexcept_reset() noexcept
+  {
+    Allocator allocator = allocator_;
+    this->~GroupProbingMap();
+    new (this) GroupProbingMap(NoExceptConstructor(), allocator);
+  }
+
+#undef GROUP_PROBING_BEGIN
+#undef GROUP_PROBING_END
+};
+
+}  // namespace blender
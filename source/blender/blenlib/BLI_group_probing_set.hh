@@ -0,0 +1,300 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::GroupProbingSet<Key>` is a hash set with the same interface as `blender::Set`, but
+ * with the memory layout of #GroupProbingMap. See BLI_group_probing_map.hh for details on when to
+ * use it.
+ *
+ * It is implemented as a #GroupProbingMap with an empty value type, which does not use any memory
+ * in the slots.
+ */
+
+#include "BLI_group_probing_map.hh"
+
+namespace blender {
+
+template<
+    /**
+     * Type of the elements that are stored in this set. It has to be movable.
+     * Furthermore, the hash and is-equal functions have to support it.
+     */
+    typename Key,
+    /**
+     * The hash function used to hash the keys. There is a default for many types. See BLI_hash.hh
+     * for examples on how to define a custom hash function.
+     */
+    typename Hash = DefaultHash<Key>,
+    /**
+     * The equality operator used to compare keys. By default it will simply compare keys using the
+     * `==` operator.
+     */
+    typename IsEqual = DefaultEquality<Key>,
+    /**
+     * The allocator used by this set. Should rarely be changed, except when you don't want that
+     * MEM_* is used internally.
+     */
+    typename Allocator = GuardedAllocator>
+class GroupProbingSet {
+ private:
+  using EmptyValue = group_probing::EmptyValue;
+  using MapType = GroupProbingMap<Key, EmptyValue, Hash, IsEqual, Allocator>;
+
+  MapType map_;
+
+ public:
+  using Iterator = typename MapType::KeyIterator;
+  using value_type = Key;
+  using pointer = const Key *;
+  using const_pointer = const Key *;
+  using reference = const Key &;
+  using const_reference = const Key &;
+  using iterator = Iterator;
+  using size_type = int64_t;
+
+  GroupProbingSet(Allocator allocator = {}) noexcept : map_(allocator) {}
+
+  GroupProbingSet(NoExceptConstructor, Allocator allocator = {}) noexcept
+      : GroupProbingSet(allocator)
+  {
+  }
+
+  GroupProbingSet(Span<Key> values, Allocator allocator = {})
+      : GroupProbingSet(NoExceptConstructor(), allocator)
+  {
+    this->add_multiple(values);
+  }
+
+  /**
+   * Construct a set that contains the given keys. Duplicates will be removed automatically.
+   */
+  GroupProbingSet(const std::initializer_list<Key> &values)
+      : GroupProbingSet(Span<Key>(values))
+  {
+  }
+
+  /**
+   * Add a new key to the set. This invokes undefined behavior when the key is in the set already.
+   */
+  void add_new(const Key &key)
+  {
+    map_.add_new_as(key, EmptyValue());
+  }
+  void add_new(Key &&key)
+  {
+    map_.add_new_as(std::move(key), EmptyValue());
+  }
+
+  /**
+   * Add a key to the set. If the key exists in the set already, nothing is done. Returns true if
+   * the key has been newly added.
+   */
+  bool add(const Key &key)
+  {
+    return this->add_as(key);
+  }
+  bool add(Key &&key)
+  {
+    return this->add_as(std::move(key));
+  }
+  template<typename ForwardKey> bool add_as(ForwardKey &&key)
+  {
+    return map_.add_as(std::forward<ForwardKey>(key), EmptyValue());
+  }
+
+  /**
+   * Convenience function to add many keys to the set at once. Duplicates are removed
+   * automatically.
+   */
+  void add_multiple(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add(key);
+    }
+  }
+
+  /**
+   * Convenience function to add many new keys to the set at once. The keys must not exist in the
+   * set before and there must not be duplicates in the array.
+   */
+  void add_multiple_new(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add_new(key);
+    }
+  }
+
+  /**
+   * Returns true if the key is in the set.
+   */
+  bool contains(const Key &key) const
+  {
+    return map_.contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return map_.contains_as(key);
+  }
+
+  /**
+   * Returns the key that is stored in the set that compares equal to the given key. This invokes
+   * undefined behavior when the key is not in the set.
+   */
+  const Key &lookup_key(const Key &key) const
+  {
+    return this->lookup_key_as(key);
+  }
+  template<typename ForwardKey> const Key &lookup_key_as(const ForwardKey &key) const
+  {
+    const Key *ptr = map_.lookup_key_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+
+  /**
+   * Returns a pointer to the key that is stored in the set that compares equal to the given key.
+   * If the key is not in the set, nullptr is returned instead.
+   */
+  const Key *lookup_key_ptr(const Key &key) const
+  {
+    return map_.lookup_key_ptr_as(key);
+  }
+  template<typename ForwardKey> const Key *lookup_key_ptr_as(const ForwardKey &key) const
+  {
+    return map_.lookup_key_ptr_as(key);
+  }
+
+  /**
+   * Deletes the key from the set. Returns true when the key did exist beforehand, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return map_.remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    return map_.remove_as(key);
+  }
+
+  /**
+   * Deletes the key from the set. This invokes undefined behavior when the key is not in the set.
+   */
+  void remove_contained(const Key &key)
+  {
+    map_.remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    map_.remove_contained_as(key);
+  }
+
+  /**
+   * Remove all values for which the given predicate is true and return the number of removed
+   * values.
+   */
+  template<typename Predicate> int64_t remove_if(Predicate &&predicate)
+  {
+    return map_.remove_if([&](const MutableMapItem<Key, EmptyValue> item) {
+      return predicate(item.key);
+    });
+  }
+
+  Iterator begin() const
+  {
+    return map_.keys().begin();
+  }
+
+  Iterator end() const
+  {
+    return map_.keys().end();
+  }
+
+  /**
+   * Returns the number of keys stored in the set.
+   */
+  int64_t size() const
+  {
+    return map_.size();
+  }
+
+  /**
+   * Returns true if no keys are stored.
+   */
+  bool is_empty() const
+  {
+    return map_.is_empty();
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t capacity() const
+  {
+    return map_.capacity();
+  }
+
+  /**
+   * Returns the amount of removed slots in the set. This is mostly for debugging purposes.
+   */
+  int64_t removed_amount() const
+  {
+    return map_.removed_amount();
+  }
+
+  /**
+   * Returns the bytes required per element. This is mostly for debugging purposes.
+   */
+  int64_t size_per_element() const
+  {
+    return map_.size_per_element();
+  }
+
+  /**
+   * Returns the approximate memory requirements of the set in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return map_.size_in_bytes();
+  }
+
+  /**
+   * Potentially resize the set such that it can hold the specified number of keys without another
+   * grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    map_.reserve(n);
+  }
+
+  /**
+   * Remove all keys from the set. The allocated memory is kept.
+   */
+  void clear()
+  {
+    map_.clear();
+  }
+
+  /**
+   * Removes all keys from the set and frees any allocated memory.
+   */
+  void clear_and_shrink()
+  {
+    map_.clear_and_shrink();
+  }
+
+  /**
+   * Get the number of collisions that have to be checked to find the key or to determine that it
+   * is not in the set. This is mostly for debugging purposes.
+   */
+  int64_t count_collisions(const Key &key) const
+  {
+    return map_.count_collisions(key);
+  }
+};
+
+}  // namespace blender
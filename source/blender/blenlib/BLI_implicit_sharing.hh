@@ -61,6 +61,14 @@ class ImplicitSharingInfo : NonCopyable, NonMovable {
    */
   mutable std::atomic<int64_t> version_ = 0;
 
+ protected:
+  /**
+   * When set, the referenced data can never be modified in place, not even by a single owner. This
+   * is used for data that is not owned by Blender's allocators, like memory-mapped files. Code
+   * that wants to change the data will make a copy instead.
+   */
+  bool data_is_read_only_ = false;
+
  public:
   virtual ~ImplicitSharingInfo()
   {
@@ -68,10 +76,17 @@ class ImplicitSharingInfo : NonCopyable, NonMovable {
     BLI_assert(weak_users_ == 0);
   }
 
-  /** Whether the resource can be modified in place because there is only one owner. */
+  /**
+   * Whether the resource can be modified in place because there is only one owner and the data is
+   * not read-only.
+   *
+   * \note This does not mean the same as having a single owner anymore. Read-only data is never
+   * mutable, so code that makes data mutable copies it even when it is the only owner. Use
+   * #strong_users to check for ownership instead.
+   */
   bool is_mutable() const
   {
-    return strong_users_.load(std::memory_order_relaxed) == 1;
+    return !data_is_read_only_ && strong_users_.load(std::memory_order_relaxed) == 1;
   }
 
   /**
@@ -83,6 +98,12 @@ class ImplicitSharingInfo : NonCopyable, NonMovable {
     return strong_users_.load(std::memory_order_acquire) == 0;
   }
 
+  /** Number of owners of the data, mainly useful for memory usage statistics. */
+  int strong_users() const
+  {
+    return strong_users_.load(std::memory_order_relaxed);
+  }
+
   /** Call when a the data has a new additional owner. */
   void add_user() const
   {
@@ -283,7 +283,11 @@ class IndexMask : private IndexMaskData {
    *   `i == mask[pos]`
    */
   template<typename Fn> void foreach_index(Fn &&fn) const;
-  template<typename Fn> void foreach_index(GrainSize grain_size, Fn &&fn) const;
+  template<typename Fn>
+  void foreach_index(GrainSize grain_size,
+                     Fn &&fn,
+                     threading::detail::CallSite call_site = {__builtin_FILE(),
+                                                              __builtin_LINE()}) const;
 
   /**
    * Same as #foreach_index, but generates more code, increasing compile time and binary size. This
@@ -292,7 +296,10 @@ class IndexMask : private IndexMaskData {
    */
   template<typename IndexT, typename Fn> void foreach_index_optimized(Fn &&fn) const;
   template<typename IndexT, typename Fn>
-  void foreach_index_optimized(GrainSize grain_size, Fn &&fn) const;
+  void foreach_index_optimized(GrainSize grain_size,
+                               Fn &&fn,
+                               threading::detail::CallSite call_site = {__builtin_FILE(),
+                                                                        __builtin_LINE()}) const;
 
   /**
    * Calls the function once for every segment. This should be used instead of #foreach_index if
@@ -306,7 +313,11 @@ class IndexMask : private IndexMaskData {
    *   `segment[0] == mask[segment_pos]`
    */
   template<typename Fn> void foreach_segment(Fn &&fn) const;
-  template<typename Fn> void foreach_segment(GrainSize grain_size, Fn &&fn) const;
+  template<typename Fn>
+  void foreach_segment(GrainSize grain_size,
+                       Fn &&fn,
+                       threading::detail::CallSite call_site = {__builtin_FILE(),
+                                                                __builtin_LINE()}) const;
 
   /**
    * This is similar to #foreach_segment but supports slightly different function signatures:
@@ -318,7 +329,11 @@ class IndexMask : private IndexMaskData {
    * function is instantiated twice. Only use this when very little processing happens per index.
    */
   template<typename Fn> void foreach_segment_optimized(Fn &&fn) const;
-  template<typename Fn> void foreach_segment_optimized(GrainSize grain_size, Fn &&fn) const;
+  template<typename Fn>
+  void foreach_segment_optimized(GrainSize grain_size,
+                                 Fn &&fn,
+                                 threading::detail::CallSite call_site = {__builtin_FILE(),
+                                                                          __builtin_LINE()}) const;
 
   /**
    * Calls the function once for every range. Note that this might call the function for each index
@@ -633,19 +648,25 @@ template<typename Fn> inline void IndexMask::foreach_index(Fn &&fn) const
 }
 
 template<typename Fn>
-inline void IndexMask::foreach_index(const GrainSize grain_size, Fn &&fn) const
-{
-  threading::parallel_for(this->index_range(), grain_size.value, [&](const IndexRange range) {
-    const IndexMask sub_mask = this->slice(range);
-    sub_mask.foreach_index([&](const int64_t i, [[maybe_unused]] const int64_t index_pos) {
-      if constexpr (std::is_invocable_r_v<void, Fn, int64_t, int64_t>) {
-        fn(i, index_pos + range.start());
-      }
-      else {
-        fn(i);
-      }
-    });
-  });
+inline void IndexMask::foreach_index(const GrainSize grain_size,
+                                     Fn &&fn,
+                                     const threading::detail::CallSite call_site) const
+{
+  threading::parallel_for(
+      this->index_range(),
+      grain_size.value,
+      [&](const IndexRange range) {
+        const IndexMask sub_mask = this->slice(range);
+        sub_mask.foreach_index([&](const int64_t i, [[maybe_unused]] const int64_t index_pos) {
+          if constexpr (std::is_invocable_r_v<void, Fn, int64_t, int64_t>) {
+            fn(i, index_pos + range.start());
+          }
+          else {
+            fn(i);
+          }
+        });
+      },
+      call_site);
 }
 
 template<typename T, typename Fn>
@@ -713,20 +734,26 @@ inline void IndexMask::foreach_index_optimized(Fn &&fn) const
 }
 
 template<typename IndexT, typename Fn>
-inline void IndexMask::foreach_index_optimized(const GrainSize grain_size, Fn &&fn) const
-{
-  threading::parallel_for(this->index_range(), grain_size.value, [&](const IndexRange range) {
-    const IndexMask sub_mask = this->slice(range);
-    sub_mask.foreach_segment(
-        [&](const IndexMaskSegment segment, [[maybe_unused]] const int64_t segment_pos) {
-          if constexpr (std::is_invocable_r_v<void, Fn, IndexT, IndexT>) {
-            optimized_foreach_index_with_pos<IndexT>(segment, segment_pos + range.start(), fn);
-          }
-          else {
-            optimized_foreach_index<IndexT>(segment, fn);
-          }
-        });
-  });
+inline void IndexMask::foreach_index_optimized(const GrainSize grain_size,
+                                               Fn &&fn,
+                                               const threading::detail::CallSite call_site) const
+{
+  threading::parallel_for(
+      this->index_range(),
+      grain_size.value,
+      [&](const IndexRange range) {
+        const IndexMask sub_mask = this->slice(range);
+        sub_mask.foreach_segment(
+            [&](const IndexMaskSegment segment, [[maybe_unused]] const int64_t segment_pos) {
+              if constexpr (std::is_invocable_r_v<void, Fn, IndexT, IndexT>) {
+                optimized_foreach_index_with_pos<IndexT>(segment, segment_pos + range.start(), fn);
+              }
+              else {
+                optimized_foreach_index<IndexT>(segment, fn);
+              }
+            });
+      },
+      call_site);
 }
 
 template<typename Fn> inline void IndexMask::foreach_segment_optimized(Fn &&fn) const
@@ -754,21 +781,27 @@ template<typename Fn> inline void IndexMask::foreach_segment_optimized(Fn &&fn)
 }
 
 template<typename Fn>
-inline void IndexMask::foreach_segment_optimized(const GrainSize grain_size, Fn &&fn) const
-{
-  threading::parallel_for(this->index_range(), grain_size.value, [&](const IndexRange range) {
-    const IndexMask sub_mask = this->slice(range);
-    sub_mask.foreach_segment_optimized(
-        [&fn, range_start = range.start()](const auto segment,
-                                           [[maybe_unused]] const int64_t start_segment_pos) {
-          if constexpr (has_segment_and_start_parameter<Fn>) {
-            fn(segment, start_segment_pos + range_start);
-          }
-          else {
-            fn(segment);
-          }
-        });
-  });
+inline void IndexMask::foreach_segment_optimized(const GrainSize grain_size,
+                                                 Fn &&fn,
+                                                 const threading::detail::CallSite call_site) const
+{
+  threading::parallel_for(
+      this->index_range(),
+      grain_size.value,
+      [&](const IndexRange range) {
+        const IndexMask sub_mask = this->slice(range);
+        sub_mask.foreach_segment_optimized(
+            [&fn, range_start = range.start()](const auto segment,
+                                               [[maybe_unused]] const int64_t start_segment_pos) {
+              if constexpr (has_segment_and_start_parameter<Fn>) {
+                fn(segment, start_segment_pos + range_start);
+              }
+              else {
+                fn(segment);
+              }
+            });
+      },
+      call_site);
 }
 
 template<typename Fn> inline void IndexMask::foreach_segment(Fn &&fn) const
@@ -787,21 +820,27 @@ template<typename Fn> inline void IndexMask::foreach_segment(Fn &&fn) const
 }
 
 template<typename Fn>
-inline void IndexMask::foreach_segment(const GrainSize grain_size, Fn &&fn) const
-{
-  threading::parallel_for(this->index_range(), grain_size.value, [&](const IndexRange range) {
-    const IndexMask sub_mask = this->slice(range);
-    sub_mask.foreach_segment(
-        [&fn, range_start = range.start()](const IndexMaskSegment mask_segment,
-                                           [[maybe_unused]] const int64_t segment_pos) {
-          if constexpr (has_segment_and_start_parameter<Fn>) {
-            fn(mask_segment, segment_pos + range_start);
-          }
-          else {
-            fn(mask_segment);
-          }
-        });
-  });
+inline void IndexMask::foreach_segment(const GrainSize grain_size,
+                                       Fn &&fn,
+                                       const threading::detail::CallSite call_site) const
+{
+  threading::parallel_for(
+      this->index_range(),
+      grain_size.value,
+      [&](const IndexRange range) {
+        const IndexMask sub_mask = this->slice(range);
+        sub_mask.foreach_segment(
+            [&fn, range_start = range.start()](const IndexMaskSegment mask_segment,
+                                               [[maybe_unused]] const int64_t segment_pos) {
+              if constexpr (has_segment_and_start_parameter<Fn>) {
+                fn(mask_segment, segment_pos + range_start);
+              }
+              else {
+                fn(mask_segment);
+              }
+            });
+      },
+      call_site);
 }
 
 template<typename Fn> inline void IndexMask::foreach_range(Fn &&fn) const
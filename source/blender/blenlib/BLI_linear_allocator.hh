@@ -28,6 +28,8 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
  private:
   BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
   Vector<void *, 2> owned_buffers_;
+  /** Total size of the owned buffers, used to reserve the same amount of memory on #reset. */
+  int64_t owned_buffers_size_ = 0;
 
   uintptr_t current_begin_;
   uintptr_t current_end_;
@@ -213,6 +215,40 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
     this->provide_buffer(aligned_buffer.ptr(), Size);
   }
 
+  /**
+   * Free all allocations at once, all memory allocated before becomes invalid. The owned memory
+   * (up to the given size) is kept in a single buffer, so that the same allocations can be done
+   * again without allocating memory from the system. A buffer passed to #provide_buffer is not
+   * used anymore.
+   */
+  void reset(const int64_t max_retained_size = INT64_MAX)
+  {
+#ifdef BLI_DEBUG_LINEAR_ALLOCATOR_SIZE
+    user_requested_size_ = 0;
+#endif
+    const int64_t retained_size = std::min(owned_buffers_size_, max_retained_size);
+    if (owned_buffers_.size() == 1 && owned_buffers_size_ == retained_size) {
+      current_begin_ = uintptr_t(owned_buffers_[0]);
+      current_end_ = current_begin_ + retained_size;
+      return;
+    }
+    for (void *ptr : owned_buffers_) {
+      allocator_.deallocate(ptr);
+    }
+    owned_buffers_.clear();
+    owned_buffers_size_ = 0;
+#ifdef BLI_DEBUG_LINEAR_ALLOCATOR_SIZE
+    owned_allocation_size_ = 0;
+#endif
+    current_begin_ = 0;
+    current_end_ = 0;
+    if (retained_size > 0) {
+      void *buffer = this->allocated_owned(retained_size, 64);
+      current_begin_ = uintptr_t(buffer);
+      current_end_ = current_begin_ + retained_size;
+    }
+  }
+
   /**
    * This allocator takes ownership of the buffers owned by `other`. Therefor, when `other` is
    * destructed, memory allocated using it is not freed.
@@ -223,6 +259,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   void transfer_ownership_from(LinearAllocator<> &other)
   {
     owned_buffers_.extend(other.owned_buffers_);
+    owned_buffers_size_ += other.owned_buffers_size_;
 #ifdef BLI_DEBUG_LINEAR_ALLOCATOR_SIZE
     user_requested_size_ += other.user_requested_size_;
     owned_allocation_size_ += other.owned_allocation_size_;
@@ -260,6 +297,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   {
     void *buffer = allocator_.allocate(size, alignment, __func__);
     owned_buffers_.append(buffer);
+    owned_buffers_size_ += size;
 #ifdef BLI_DEBUG_LINEAR_ALLOCATOR_SIZE
     owned_allocation_size_ += size;
 #endif
@@ -34,6 +34,15 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Returns the length of the mapped file. */
+size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+
+/* By default, IO errors when accessing the memory of #BLI_mmap_get_pointer directly make it read
+ * as zeroes. Use this when data references the memory without checking for errors, to report the
+ * error and abort instead of silently continuing with broken data. Errors in #BLI_mmap_read are
+ * still returned as usual. */
+void BLI_mmap_set_errors_fatal(BLI_mmap_file *file) ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
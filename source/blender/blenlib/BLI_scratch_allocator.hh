@@ -0,0 +1,88 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #ScratchAllocator allocates temporary buffers of containers from an arena that belongs to the
+ * current thread, if there is one. Allocating from the arena is much cheaper than a system
+ * allocation, and deallocating is a no-op. The whole arena is reset at once by its owner, for
+ * example the depsgraph after every evaluation.
+ *
+ * Arenas are activated for the current thread with a #ScratchArenaScope. Without an active arena,
+ * the allocator falls back to Blender's guarded allocator, so the containers can be used anywhere.
+ *
+ * \warning Containers using this allocator must not outlive the scope of the code that created
+ * them. They must not be stored in data that persists after the evaluation, because the memory
+ * becomes invalid when the arena is reset.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+/** The arena that is used by #ScratchAllocator on the current thread, may be null. */
+LinearAllocator<> *scratch_arena_get();
+
+/**
+ * Activates an arena for the current thread while the scope exists. Scopes can be nested, the
+ * previously active arena is restored at the end.
+ */
+class ScratchArenaScope : NonCopyable, NonMovable {
+ private:
+  LinearAllocator<> *previous_arena_;
+
+ public:
+  ScratchArenaScope(LinearAllocator<> &arena);
+  ~ScratchArenaScope();
+};
+
+class ScratchAllocator {
+ private:
+  struct MemHead {
+    /** Offset to the beginning of the allocation, zero for memory owned by an arena. */
+    int offset;
+  };
+
+ public:
+  void *allocate(size_t size, size_t alignment, const char *name)
+  {
+    BLI_assert(is_power_of_2_i(int(alignment)));
+    /* Keep the returned pointer aligned. */
+    const size_t header_size = std::max(alignment, sizeof(MemHead));
+    void *ptr;
+    int offset;
+    if (LinearAllocator<> *arena = scratch_arena_get()) {
+      ptr = arena->allocate(int64_t(size + header_size), int64_t(alignment));
+      offset = 0;
+    }
+    else {
+      ptr = MEM_mallocN_aligned(size + header_size, alignment, name);
+      offset = int(header_size);
+    }
+    void *used_ptr = POINTER_OFFSET(ptr, header_size);
+    (static_cast<MemHead *>(used_ptr) - 1)->offset = offset;
+    return used_ptr;
+  }
+
+  void deallocate(void *ptr)
+  {
+    const MemHead *head = static_cast<const MemHead *>(ptr) - 1;
+    if (head->offset != 0) {
+      MEM_freeN(POINTER_OFFSET(ptr, -head->offset));
+    }
+  }
+};
+
+template<typename T, int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(T))>
+using ScratchArray = Array<T, InlineBufferCapacity, ScratchAllocator>;
+
+template<typename T, int64_t InlineBufferCapacity = default_inline_buffer_capacity(sizeof(T))>
+using ScratchVector = Vector<T, InlineBufferCapacity, ScratchAllocator>;
+
+}  // namespace blender
@@ -65,13 +65,27 @@ inline void parallel_for_each(Range &&range, const Function &function)
 }
 
 namespace detail {
+
+/**
+ * Location of the caller of a parallel loop, see #BLI_task_statistics.hh. This is passed as
+ * default argument, so that it is evaluated where the function is called.
+ */
+struct CallSite {
+  const char *file;
+  int line;
+};
+
 void parallel_for_impl(IndexRange range,
                        int64_t grain_size,
-                       FunctionRef<void(IndexRange)> function);
+                       FunctionRef<void(IndexRange)> function,
+                       const CallSite &call_site);
 }  // namespace detail
 
 template<typename Function>
-inline void parallel_for(IndexRange range, int64_t grain_size, const Function &function)
+inline void parallel_for(IndexRange range,
+                         int64_t grain_size,
+                         const Function &function,
+                         const detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
   if (range.is_empty()) {
     return;
@@ -80,7 +94,7 @@ inline void parallel_for(IndexRange range, int64_t grain_size, const Function &f
     function(range);
     return;
   }
-  detail::parallel_for_impl(range, grain_size, function);
+  detail::parallel_for_impl(range, grain_size, function, call_site);
 }
 
 /**
@@ -113,15 +127,21 @@ inline IndexRange align_sub_range(const IndexRange unaligned_range,
  * larger, which means that work is distributed less evenly.
  */
 template<typename Function>
-inline void parallel_for_aligned(const IndexRange range,
-                                 const int64_t grain_size,
-                                 const int64_t alignment,
-                                 const Function &function)
+inline void parallel_for_aligned(
+    const IndexRange range,
+    const int64_t grain_size,
+    const int64_t alignment,
+    const Function &function,
+    const detail::CallSite call_site = {__builtin_FILE(), __builtin_LINE()})
 {
-  parallel_for(range, grain_size, [&](const IndexRange unaligned_range) {
-    const IndexRange aligned_range = align_sub_range(unaligned_range, alignment, range);
-    function(aligned_range);
-  });
+  parallel_for(
+      range,
+      grain_size,
+      [&](const IndexRange unaligned_range) {
+        const IndexRange aligned_range = align_sub_range(unaligned_range, alignment, range);
+        function(aligned_range);
+      },
+      call_site);
 }
 
 template<typename Value, typename Function, typename Reduction>
@@ -0,0 +1,79 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Optional instrumentation of #threading::parallel_for. When enabled, every call that is
+ * executed in parallel records how its work was distributed over the threads, grouped by the
+ * location of the call in the source code. This helps finding call sites with a grain size that
+ * doesn't fit the cost of the work they do.
+ *
+ * The adaptive grain size mode uses the same measurements to replace the grain size passed by the
+ * caller with one that results in tasks of roughly #ADAPTIVE_GRAIN_TASK_TIME.
+ */
+
+#include <iosfwd>
+
+#include "BLI_vector.hh"
+
+namespace blender::threading::statistics {
+
+/** Aimed run time of a single task in the adaptive grain size mode, in seconds. */
+constexpr double ADAPTIVE_GRAIN_TASK_TIME = 100e-6;
+
+struct CallSiteStatistics {
+  const char *file = nullptr;
+  int line = 0;
+
+  /** Number of calls that were executed in parallel. */
+  int64_t calls = 0;
+  /** Number of processed indices. */
+  int64_t items = 0;
+  /** Number of sub-ranges that were executed. */
+  int64_t tasks = 0;
+  /** Number of sub-ranges that were executed on another thread than the calling one. */
+  int64_t stolen_tasks = 0;
+  /** Sum of the number of threads that took part in each call. */
+  int64_t threads = 0;
+  /** Time from the start to the end of the calls, in seconds. */
+  double wall_time = 0.0;
+  /** Time spent executing tasks, summed over all threads, in seconds. */
+  double busy_time = 0.0;
+  /** Time the participating threads didn't spend executing tasks, in seconds. */
+  double idle_time = 0.0;
+  /**
+   * Sum over all calls of the busy time of the busiest thread divided by the average busy time.
+   * A perfectly balanced call adds 1.
+   */
+  double imbalance = 0.0;
+  /** Grain size used by the last call. */
+  int64_t grain_size = 0;
+  /** Average time per item, in seconds. */
+  double item_time = 0.0;
+};
+
+/** Start or stop recording statistics for parallel loops. */
+void enable(bool enable);
+bool is_enabled();
+
+/**
+ * Choose the grain size of parallel loops based on the measured cost per item,
+ * instead of the grain size passed in by the caller.
+ */
+void use_adaptive_grain_size(bool use);
+bool is_adaptive_grain_size_used();
+
+/** Remove all recorded statistics. */
+void clear();
+
+/** Recorded statistics for all call sites, sorted by decreasing wall time. */
+Vector<CallSiteStatistics> get();
+
+/** Print a table with the recorded statistics. */
+void print(std::ostream &stream);
+
+}  // namespace blender::threading::statistics
@@ -9,6 +9,7 @@
 #include "BLI_mmap.h"
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h"
 
 #include <string.h>
@@ -36,6 +37,10 @@ struct BLI_mmap_file {
   /* Flag to indicate IO errors. Needs to be volatile since it's being set from
    * within the signal handler, which is not part of the normal execution flow. */
   volatile bool io_error;
+
+  /* Errors when accessing the memory directly can't be recovered from, see
+   * #BLI_mmap_set_errors_fatal. */
+  bool errors_fatal;
 };
 
 #ifndef WIN32
@@ -44,10 +49,14 @@ struct BLI_mmap_file {
  * To do so, we keep a list of all current FileDatas that use memory-mapped files,
  * and if a SIGBUS is caught, we check if the failed address is inside one of the
  * mapped regions.
- * If it is, we set a flag to indicate a failed read and remap the memory in
- * question to a zero-backed region in order to avoid additional signals.
- * The code that actually reads the memory area has to check whether the flag was
- * set after it's done reading.
+ * If it is and the error happened inside #BLI_mmap_read, we set a flag to indicate
+ * a failed read and remap the memory in question to a zero-backed region in order
+ * to avoid additional signals. The code that actually reads the memory area has to
+ * check whether the flag was set after it's done reading.
+ * Files can be marked with #BLI_mmap_set_errors_fatal when data references the mapped
+ * memory directly, without checking for errors. Silently replacing it with zeroes would
+ * corrupt that data, e.g. when the file is truncated by another process while it is
+ * mapped. Errors outside of #BLI_mmap_read are reported and abort the process then.
  * If the error occurred outside of a memory-mapped region, we call the previous
  * handler if one was configured and abort the process otherwise.
  */
@@ -58,6 +67,19 @@ static struct error_handler_data {
   void (*next_handler)(int, siginfo_t *, void *);
 } error_handler = {0};
 
+/* Mappings may be freed from any thread when their memory is referenced by shared data. */
+static ThreadMutex error_handler_mutex = BLI_MUTEX_INITIALIZER;
+
+/* The file currently read by #BLI_mmap_read in this thread. */
+static _Thread_local const BLI_mmap_file *reading_file = NULL;
+
+/* Only uses functions that are safe to call from a signal handler. */
+static void sigbus_handler_report(const char *message)
+{
+  const ssize_t written = write(STDERR_FILENO, message, strlen(message));
+  UNUSED_VARS(written);
+}
+
 static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
 {
   /* We only handle SIGBUS here for now. */
@@ -70,6 +92,13 @@ static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
 
     /* Is the address where the error occurred in this file's mapped range? */
     if (error_addr >= file->memory && error_addr < file->memory + file->length) {
+      if (file->errors_fatal && reading_file != file) {
+        sigbus_handler_report(
+            "SIGBUS handler: Error accessing memory-mapped file, it was likely truncated or "
+            "modified while in use\n");
+        abort();
+      }
+
       file->io_error = true;
 
       /* Replace the mapped memory with zeroes. */
@@ -118,14 +147,19 @@ static bool sigbus_handler_setup(void)
 /* Adds a file to the list that the error handler checks. */
 static void sigbus_handler_add(BLI_mmap_file *file)
 {
-  BLI_addtail(&error_handler.open_mmaps, BLI_genericNodeN(file));
+  LinkData *link = BLI_genericNodeN(file);
+  BLI_mutex_lock(&error_handler_mutex);
+  BLI_addtail(&error_handler.open_mmaps, link);
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 
 /* Removes a file from the list that the error handler checks. */
 static void sigbus_handler_remove(BLI_mmap_file *file)
 {
+  BLI_mutex_lock(&error_handler_mutex);
   LinkData *link = BLI_findptr(&error_handler.open_mmaps, file, offsetof(LinkData, data));
   BLI_freelinkN(&error_handler.open_mmaps, link);
+  BLI_mutex_unlock(&error_handler_mutex);
 }
 #endif
 
@@ -187,7 +221,9 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 #ifndef WIN32
   /* If an error occurs in this call, sigbus_handler will be called and will set
    * file->io_error to true. */
+  reading_file = file;
   memcpy(dest, file->memory + offset, length);
+  reading_file = NULL;
 #else
   /* On Windows, we use exception handling to be notified of errors. */
   __try
@@ -210,6 +246,16 @@ void *BLI_mmap_get_pointer(BLI_mmap_file *file)
   return file->memory;
 }
 
+size_t BLI_mmap_get_length(const BLI_mmap_file *file)
+{
+  return file->length;
+}
+
+void BLI_mmap_set_errors_fatal(BLI_mmap_file *file)
+{
+  file->errors_fatal = true;
+}
+
 void BLI_mmap_free(BLI_mmap_file *file)
 {
 #ifndef WIN32
@@ -14,14 +14,18 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, tau, e, inf, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
- *      min, max, radians, degrees,
+ *      min, max, radians, degrees, float, bool,
  *      abs, fabs, floor, ceil, trunc, int,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log, log1p, log2, log10, sqrt, pow, fmod, hypot, copysign
+ *  - References:
+ *      `root.attr[index].attr`, for a root name given to #BLI_expr_pylike_parse_ex.
+ *      The value of every distinct reference is passed as an additional parameter.
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -100,6 +104,10 @@ struct ExprPyLike_Parsed {
   int ops_count;
   int max_stack;
 
+  /* Paths of the references, stored as consecutive null-terminated strings after the ops. */
+  int refs_count;
+  const char *refs;
+
   ExprOp ops[];
 };
 
@@ -143,6 +151,22 @@ bool BLI_expr_pylike_is_using_param(ExprPyLike_Parsed *expr, int index)
   return false;
 }
 
+int BLI_expr_pylike_refs_count(ExprPyLike_Parsed *expr)
+{
+  return expr != NULL ? expr->refs_count : 0;
+}
+
+const char *BLI_expr_pylike_ref_path(ExprPyLike_Parsed *expr, int index)
+{
+  BLI_assert(index >= 0 && index < BLI_expr_pylike_refs_count(expr));
+
+  const char *path = expr->refs;
+  for (int i = 0; i < index; i++) {
+    path += strlen(path) + 1;
+  }
+  return path;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -302,6 +326,51 @@ static double op_sub(double a, double b)
   return a - b;
 }
 
+static double op_floordiv(double a, double b)
+{
+  if (b == 0.0) {
+    /* Raise the same floating point exception as the division. */
+    return a / b;
+  }
+
+  /* Python semantics: use the exact remainder instead of rounding the quotient first,
+   * e.g. `7 // 0.1` is 69 even though `7 / 0.1` rounds to 70. */
+  double mod = fmod(a, b);
+  double div = (a - mod) / b;
+  if (mod != 0.0 && ((mod < 0.0) != (b < 0.0))) {
+    div -= 1.0;
+  }
+  if (div == 0.0) {
+    return copysign(0.0, a / b);
+  }
+  /* The division is nearly exact, snap to the nearest integer. */
+  double result = floor(div);
+  if (div - result > 0.5) {
+    result += 1.0;
+  }
+  return result;
+}
+
+static double op_mod(double a, double b)
+{
+  /* Python semantics: the result has the sign of the divisor. */
+  double result = fmod(a, b);
+  if (result != 0.0 && ((result < 0.0) != (b < 0.0))) {
+    result += b;
+  }
+  return result;
+}
+
+static double op_float(double arg)
+{
+  return arg;
+}
+
+static double op_bool(double arg)
+{
+  return arg ? 1.0 : 0.0;
+}
+
 static double op_radians(double arg)
 {
   return arg * M_PI / 180.0;
@@ -382,7 +451,14 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI},
+    {"tau", 2.0 * M_PI},
+    {"e", M_E},
+    {"inf", INFINITY},
+    {"True", 1.0},
+    {"False", 0.0},
+    {NULL, 0.0},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -414,12 +490,26 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log1p", OPCODE_FUNC1, log1p},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
+    {"float", OPCODE_FUNC1, op_float},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -449,6 +539,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_LE MAKE_CHAR2('<', '=')
 #define TOKEN_NE MAKE_CHAR2('!', '=')
 #define TOKEN_EQ MAKE_CHAR2('=', '=')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 #define TOKEN_AND MAKE_CHAR2('A', 'N')
 #define TOKEN_OR MAKE_CHAR2('O', 'R')
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
@@ -476,6 +568,13 @@ typedef struct ExprParseState {
   int param_names_len;
   const char **param_names;
 
+  /* Root name of references, may be NULL. */
+  const char *ref_root;
+
+  /* Paths of the references found so far, see #ExprPyLike_Parsed.refs. */
+  int refs_count, refs_len, refs_max_len;
+  char *refs;
+
   /* Original expression */
   const char *expr;
   const char *cur;
@@ -698,6 +797,13 @@ static bool parse_next_token(ExprParseState *state)
     return true;
   }
 
+  /* ** and // tokens */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* Special characters (single character tokens) */
   if (strchr(token_characters, *state->cur)) {
     state->token = *state->cur++;
@@ -770,19 +876,72 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+/* Parse a reference path after its root name, and add it as a parameter. */
+static bool parse_reference(ExprParseState *state)
 {
-  int i;
+  /* The path is never longer than the expression itself. */
+  char *path = MEM_mallocN(strlen(state->expr) + 1, __func__);
+  char *out = path;
+  bool ok = parse_next_token(state) && state->token == '.';
+
+  while (ok) {
+    if (state->token == '.') {
+      ok = parse_next_token(state) && state->token == TOKEN_ID;
+      if (ok) {
+        out += sprintf(out, (out == path) ? "%s" : ".%s", state->tokenbuf);
+        ok = parse_next_token(state);
+      }
+    }
+    else if (state->token == '[') {
+      /* Only non-negative integer literals are supported as index. */
+      ok = parse_next_token(state) && state->token == TOKEN_NUMBER &&
+           strspn(state->tokenbuf, "0123456789") == strlen(state->tokenbuf);
+      if (ok) {
+        out += sprintf(out, "[%s]", state->tokenbuf);
+        ok = parse_next_token(state) && state->token == ']' && parse_next_token(state);
+      }
+    }
+    else {
+      break;
+    }
+  }
 
-  switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
+  if (!ok) {
+    MEM_freeN(path);
+    return false;
+  }
 
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
+  /* Reuse the parameter of an identical reference. */
+  int index = 0;
+  const char *ref = state->refs;
+  for (; index < state->refs_count; index++, ref += strlen(ref) + 1) {
+    if (STREQ(ref, path)) {
+      break;
+    }
+  }
+
+  if (index == state->refs_count) {
+    int len = (int)(out - path) + 1;
+    if (state->refs_len + len > state->refs_max_len) {
+      state->refs_max_len = power_of_2_max_i(state->refs_len + len);
+      state->refs = MEM_reallocN(state->refs, state->refs_max_len);
+    }
+    memcpy(state->refs + state->refs_len, path, len);
+    state->refs_len += len;
+    state->refs_count++;
+  }
+
+  MEM_freeN(path);
+
+  parse_add_op(state, OPCODE_PARAMETER, 1)->arg.ival = state->param_names_len + index;
+  return true;
+}
+
+static bool parse_primary(ExprParseState *state)
+{
+  int i;
 
+  switch (state->token) {
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -801,6 +960,11 @@ static bool parse_unary(ExprParseState *state)
         }
       }
 
+      /* References to attributes of the root. */
+      if (state->ref_root != NULL && STREQ(state->tokenbuf, state->ref_root)) {
+        return parse_reference(state);
+      }
+
       /* Ordinary builtin constants. */
       for (i = 0; builtin_consts[i].name; i++) {
         if (STREQ(state->tokenbuf, builtin_consts[i].name)) {
@@ -853,6 +1017,37 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+static bool parse_unary(ExprParseState *state);
+
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  /* Right associative, and binds tighter than an unary operator on its left. */
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -869,6 +1064,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -1055,6 +1260,14 @@ static bool parse_expr(ExprParseState *state)
 ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
                                          const char **param_names,
                                          int param_names_len)
+{
+  return BLI_expr_pylike_parse_ex(expression, param_names, param_names_len, NULL);
+}
+
+ExprPyLike_Parsed *BLI_expr_pylike_parse_ex(const char *expression,
+                                            const char **param_names,
+                                            int param_names_len,
+                                            const char *ref_root)
 {
   /* Prepare the parser state. */
   ExprParseState state;
@@ -1064,6 +1277,7 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
 
   state.param_names_len = param_names_len;
   state.param_names = param_names;
+  state.ref_root = ref_root;
 
   state.tokenbuf = MEM_mallocN(strlen(expression) + 1, __func__);
 
@@ -1076,13 +1290,18 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
   if (parse_next_token(&state) && parse_expr(&state) && state.token == 0) {
     BLI_assert(state.stack_ptr == 1);
 
-    int bytesize = sizeof(ExprPyLike_Parsed) + state.ops_count * sizeof(ExprOp);
+    int bytesize = sizeof(ExprPyLike_Parsed) + state.ops_count * sizeof(ExprOp) +
+                   state.refs_len;
 
     expr = MEM_mallocN(bytesize, "ExprPyLike_Parsed");
     expr->ops_count = state.ops_count;
     expr->max_stack = state.max_stack;
 
     memcpy(expr->ops, state.ops, state.ops_count * sizeof(ExprOp));
+
+    expr->refs_count = state.refs_count;
+    expr->refs = (const char *)(expr->ops + state.ops_count);
+    memcpy((char *)expr->refs, state.refs, state.refs_len);
   }
   else {
     /* Always return a non-NULL object so that parse failure can be cached. */
@@ -1091,6 +1310,7 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
 
   MEM_freeN(state.tokenbuf);
   MEM_freeN(state.ops);
+  MEM_SAFE_FREE(state.refs);
   return expr;
 }
 
@@ -117,14 +117,23 @@ FileReader *BLI_filereader_new_mmap(int filedes)
     return NULL;
   }
 
+  FileReader *reader = BLI_filereader_new_mmap_file(mmap);
+  reader->close = memory_close_mmap;
+
+  return reader;
+}
+
+FileReader *BLI_filereader_new_mmap_file(BLI_mmap_file *mmap)
+{
   MemoryReader *mem = MEM_callocN(sizeof(MemoryReader), __func__);
 
   mem->mmap = mmap;
-  mem->length = BLI_lseek(filedes, 0, SEEK_END);
+  mem->length = BLI_mmap_get_length(mmap);
 
   mem->reader.read = memory_read_mmap;
   mem->reader.seek = memory_seek;
-  mem->reader.close = memory_close_mmap;
+  /* The mapping is owned by the caller. */
+  mem->reader.close = memory_close_raw;
 
   return (FileReader *)mem;
 }
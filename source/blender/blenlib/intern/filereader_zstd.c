@@ -13,9 +13,17 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Maximum number of frames that are decompressed at once when reading sequentially.
+ * Frames written by Blender are 1 MB, so this bounds the cache to a few MB per reader.
+ */
+#define ZSTD_CACHED_FRAMES_MAX 16
+
 typedef struct {
   FileReader reader;
 
@@ -30,8 +38,12 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /** Decompressed frames, starting at #cached_frame. */
+    char *cached_content[ZSTD_CACHED_FRAMES_MAX];
     int cached_frame;
+    int cached_frames_num;
+    /** Number of frames to decompress in parallel when reading sequentially. */
+    int prefetch_frames_num;
   } seek;
 } ZstdReader;
 
@@ -128,6 +140,7 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.prefetch_frames_num = clamp_i(BLI_system_thread_count(), 1, ZSTD_CACHED_FRAMES_MAX);
 
   return true;
 }
@@ -155,42 +168,118 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+static void zstd_cache_clear(ZstdReader *zstd)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
   }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  int frame_first;
+  const char *compressed_data;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_fn(void *__restrict userdata,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = data->frame_first + iter;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const size_t *compressed_ofs = zstd->seek.compressed_ofs;
+  const size_t *uncompressed_ofs = zstd->seek.uncompressed_ofs;
+  size_t compressed_size = compressed_ofs[frame + 1] - compressed_ofs[frame];
+  size_t uncompressed_size = uncompressed_ofs[frame + 1] - uncompressed_ofs[frame];
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* The shared context can only be used when decompressing a single frame. */
+  size_t res = ZSTD_decompress(uncompressed_data,
+                               uncompressed_size,
+                               data->compressed_data +
+                                   (compressed_ofs[frame] - compressed_ofs[data->frame_first]),
+                               compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+  }
+  /* Failed frames are left empty and checked after all threads are done, instead of setting a
+   * shared error flag from multiple threads. */
+  zstd->seek.cached_content[iter] = uncompressed_data;
+}
+
+/* Ensure that the given frame is loaded, when reading past the currently loaded frames,
+ * the following frames are decompressed in parallel as well. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  const int cached_frame = zstd->seek.cached_frame;
+  if (frame >= cached_frame && frame < cached_frame + zstd->seek.cached_frames_num) {
+    /* Cached frame matches, so just return it. */
+    return zstd->seek.cached_content[frame - cached_frame];
+  }
+
+  /* Only read ahead when reading sequentially, random access (e.g. data read on demand)
+   * should not pay for decompressing frames it doesn't need. */
+  const bool is_sequential = (zstd->seek.cached_frames_num != 0) &&
+                             (frame == cached_frame + zstd->seek.cached_frames_num);
+  const int frames_num = is_sequential ?
+                             min_ii(zstd->seek.prefetch_frames_num,
+                                    zstd->seek.frames_num - frame) :
+                             1;
+
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_cache_clear(zstd);
+
+  /* Consecutive frames are stored contiguously, so they can be read at once. */
+  size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                           zstd->seek.compressed_ofs[frame];
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
   {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
-  MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
-    return NULL;
+  bool error = false;
+  if (frames_num == 1) {
+    size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                               zstd->seek.uncompressed_ofs[frame];
+    char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+    size_t res = ZSTD_decompressDCtx(
+        zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+    if (ZSTD_isError(res) || res < uncompressed_size) {
+      MEM_freeN(uncompressed_data);
+      uncompressed_data = NULL;
+      error = true;
+    }
+    zstd->seek.cached_content[0] = uncompressed_data;
   }
+  else {
+    ZstdDecompressData data = {zstd, frame, compressed_data};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_fn, &settings);
+    for (int i = 0; i < frames_num; i++) {
+      if (zstd->seek.cached_content[i] == NULL) {
+        error = true;
+      }
+    }
+  }
+  MEM_freeN(compressed_data);
 
   zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  zstd->seek.cached_frames_num = frames_num;
+  if (error) {
+    zstd_cache_clear(zstd);
+    return NULL;
+  }
+  return zstd->seek.cached_content[0];
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -283,10 +372,7 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
+    zstd_cache_clear(zstd);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_scratch_allocator.hh"
+
+namespace blender {
+
+static thread_local LinearAllocator<> *active_arena = nullptr;
+
+LinearAllocator<> *scratch_arena_get()
+{
+  return active_arena;
+}
+
+ScratchArenaScope::ScratchArenaScope(LinearAllocator<> &arena) : previous_arena_(active_arena)
+{
+  active_arena = &arena;
+}
+
+ScratchArenaScope::~ScratchArenaScope()
+{
+  active_arena = previous_arena_;
+}
+
+}  // namespace blender
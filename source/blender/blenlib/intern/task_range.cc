@@ -8,16 +8,26 @@
  * Task parallel range functions.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <thread>
 
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_hash.hh"
 #include "BLI_lazy_threading.hh"
+#include "BLI_map.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_statistics.hh"
 #include "BLI_threads.h"
+#include "BLI_timeit.hh"
 
 #include "atomic_ops.h"
 
@@ -158,16 +168,204 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS * /*tls*/)
 #endif
 }
 
+namespace blender::threading::statistics {
+
+static std::atomic<bool> statistics_enabled = false;
+static std::atomic<bool> adaptive_grain_size_enabled = false;
+
+struct CallSiteKey {
+  StringRefNull file;
+  int line;
+
+  uint64_t hash() const
+  {
+    return get_default_hash_2(file, line);
+  }
+
+  friend bool operator==(const CallSiteKey &a, const CallSiteKey &b)
+  {
+    return a.line == b.line && a.file == b.file;
+  }
+};
+
+struct StatisticsStorage {
+  std::mutex mutex;
+  Map<CallSiteKey, CallSiteStatistics> map;
+};
+
+static StatisticsStorage &get_storage()
+{
+  static StatisticsStorage storage;
+  return storage;
+}
+
+void enable(const bool enable)
+{
+  statistics_enabled = enable;
+}
+
+bool is_enabled()
+{
+  return statistics_enabled;
+}
+
+void use_adaptive_grain_size(const bool use)
+{
+  adaptive_grain_size_enabled = use;
+}
+
+bool is_adaptive_grain_size_used()
+{
+  return adaptive_grain_size_enabled;
+}
+
+void clear()
+{
+  StatisticsStorage &storage = get_storage();
+  std::lock_guard lock{storage.mutex};
+  storage.map.clear();
+}
+
+Vector<CallSiteStatistics> get()
+{
+  StatisticsStorage &storage = get_storage();
+  Vector<CallSiteStatistics> result;
+  {
+    std::lock_guard lock{storage.mutex};
+    result.extend(storage.map.values().begin(), storage.map.values().end());
+  }
+  std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+    return a.wall_time > b.wall_time;
+  });
+  return result;
+}
+
+void print(std::ostream &stream)
+{
+  const Vector<CallSiteStatistics> all_stats = get();
+  stream << "Parallel for statistics (" << all_stats.size() << " call sites):\n";
+  stream << std::setw(10) << "Wall ms" << std::setw(10) << "Busy ms" << std::setw(10)
+         << "Idle ms" << std::setw(8) << "Calls" << std::setw(12) << "Items" << std::setw(10)
+         << "Tasks" << std::setw(10) << "Stolen" << std::setw(9) << "Threads" << std::setw(10)
+         << "Imbalance" << std::setw(8) << "Grain"
+         << "  Call site\n";
+  for (const CallSiteStatistics &stats : all_stats) {
+    const double calls = double(std::max<int64_t>(stats.calls, 1));
+    stream << std::fixed << std::setprecision(2) << std::setw(10) << stats.wall_time * 1e3
+           << std::setw(10) << stats.busy_time * 1e3 << std::setw(10) << stats.idle_time * 1e3
+           << std::setw(8) << stats.calls << std::setw(12) << stats.items << std::setw(10)
+           << stats.tasks << std::setw(10) << stats.stolen_tasks << std::setw(9)
+           << double(stats.threads) / calls << std::setw(10) << stats.imbalance / calls
+           << std::setw(8) << stats.grain_size << "  " << stats.file << ":" << stats.line
+           << "\n";
+  }
+}
+
+/**
+ * Grain size resulting in tasks of about #ADAPTIVE_GRAIN_TASK_TIME, while still creating enough
+ * tasks to keep all threads busy.
+ */
+static int64_t adaptive_grain_size(const CallSiteStatistics &stats,
+                                   const IndexRange range,
+                                   const int64_t grain_size)
+{
+  if (stats.item_time <= 0.0) {
+    return grain_size;
+  }
+  const int64_t threads_num = BLI_task_scheduler_num_threads();
+  const int64_t grain_size_max = std::max<int64_t>(1, range.size() / (threads_num * 4));
+  return std::clamp<int64_t>(
+      int64_t(ADAPTIVE_GRAIN_TASK_TIME / stats.item_time), 1, grain_size_max);
+}
+
+#ifdef WITH_TBB
+
+static void parallel_for_instrumented(const IndexRange range,
+                                      int64_t grain_size,
+                                      const FunctionRef<void(IndexRange)> function,
+                                      const detail::CallSite &call_site)
+{
+  using namespace blender::timeit;
+  const CallSiteKey key{call_site.file, call_site.line};
+  StatisticsStorage &storage = get_storage();
+
+  if (adaptive_grain_size_enabled) {
+    std::lock_guard lock{storage.mutex};
+    if (const CallSiteStatistics *stats = storage.map.lookup_ptr(key)) {
+      grain_size = adaptive_grain_size(*stats, range, grain_size);
+    }
+  }
+
+  const std::thread::id caller_thread = std::this_thread::get_id();
+  std::atomic<int64_t> tasks = 0;
+  std::atomic<int64_t> stolen_tasks = 0;
+  tbb::enumerable_thread_specific<Nanoseconds> busy_time_per_thread(Nanoseconds(0));
+
+  const TimePoint start = Clock::now();
+  tbb::parallel_for(
+      tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
+      [&](const tbb::blocked_range<int64_t> &subrange) {
+        const TimePoint task_start = Clock::now();
+        function(IndexRange(subrange.begin(), subrange.size()));
+        busy_time_per_thread.local() += Clock::now() - task_start;
+        tasks.fetch_add(1, std::memory_order_relaxed);
+        if (std::this_thread::get_id() != caller_thread) {
+          stolen_tasks.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+  const double wall_time = std::chrono::duration<double>(Clock::now() - start).count();
+
+  int64_t threads_num = 0;
+  double busy_time = 0.0;
+  double busy_time_max = 0.0;
+  for (const Nanoseconds thread_busy_time : busy_time_per_thread) {
+    const double seconds = std::chrono::duration<double>(thread_busy_time).count();
+    busy_time += seconds;
+    busy_time_max = std::max(busy_time_max, seconds);
+    threads_num++;
+  }
+
+  std::lock_guard lock{storage.mutex};
+  CallSiteStatistics &stats = storage.map.lookup_or_add_cb(key, [&]() {
+    CallSiteStatistics new_stats;
+    new_stats.file = call_site.file;
+    new_stats.line = call_site.line;
+    return new_stats;
+  });
+  stats.calls++;
+  stats.items += range.size();
+  stats.tasks += tasks;
+  stats.stolen_tasks += stolen_tasks;
+  stats.threads += threads_num;
+  stats.wall_time += wall_time;
+  stats.busy_time += busy_time;
+  stats.idle_time += std::max(0.0, wall_time * double(threads_num) - busy_time);
+  stats.imbalance += busy_time > 0.0 ? busy_time_max / (busy_time / double(threads_num)) : 1.0;
+  stats.grain_size = grain_size;
+  stats.item_time = stats.busy_time / double(stats.items);
+}
+
+#endif
+
+}  // namespace blender::threading::statistics
+
 namespace blender::threading::detail {
 
 void parallel_for_impl(const IndexRange range,
                        const int64_t grain_size,
-                       const FunctionRef<void(IndexRange)> function)
+                       const FunctionRef<void(IndexRange)> function,
+                       const CallSite &call_site)
 {
 #ifdef WITH_TBB
   /* Invoking tbb for small workloads has a large overhead. */
   if (range.size() >= grain_size) {
     lazy_threading::send_hint();
+    if (statistics::statistics_enabled.load(std::memory_order_relaxed) ||
+        statistics::adaptive_grain_size_enabled.load(std::memory_order_relaxed))
+    {
+      statistics::parallel_for_instrumented(range, grain_size, function, call_site);
+      return;
+    }
     tbb::parallel_for(
         tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
         [function](const tbb::blocked_range<int64_t> &subrange) {
@@ -176,7 +374,7 @@ void parallel_for_impl(const IndexRange range,
     return;
   }
 #else
-  UNUSED_VARS(grain_size);
+  UNUSED_VARS(grain_size, call_site);
 #endif
   function(range);
 }
@@ -8,10 +8,13 @@
  * Task scheduler initialization.
  */
 
+#include <iostream>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_lazy_threading.hh"
 #include "BLI_task.h"
+#include "BLI_task_statistics.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -57,6 +60,12 @@ void BLI_task_scheduler_init()
 
 void BLI_task_scheduler_exit()
 {
+  if (blender::threading::statistics::is_enabled()) {
+    blender::threading::statistics::print(std::cout);
+  }
+  /* Free the statistics memory before leaks are checked. */
+  blender::threading::statistics::clear();
+
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
@@ -114,6 +114,10 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+
+TEST_PARSE_FAIL(BadPow, "2 *** 2")
+TEST_PARSE_FAIL(NoRefRoot, "self.x")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -146,6 +150,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(Tau, "tau", 2.0 * M_PI)
+TEST_CONST(E, "e", M_E)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -159,6 +165,15 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+
+TEST_CONST(Bool1, "bool(0.5)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+TEST_CONST(Float, "float(2)", 2.0)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -208,6 +223,25 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(BinaryFloorDiv1, "7 // 2", 3.0)
+TEST_CONST(BinaryFloorDiv2, "-7 // 2", -4.0)
+TEST_CONST(BinaryFloorDiv3, "7 // 0.1", 69.0)
+TEST_CONST(BinaryFloorDiv4, "-7 // 0.1", -70.0)
+TEST_CONST(BinaryFloorDiv5, "7 // -0.1", -70.0)
+TEST_CONST(BinaryFloorDiv6, "0.7 // 0.1", 6.0)
+TEST_EVAL(BinaryFloorDiv, "x // 2", -7, -4.0)
+
+TEST_CONST(BinaryMod1, "7 % 3", 1.0)
+TEST_CONST(BinaryMod2, "-7 % 3", 2.0)
+TEST_CONST(BinaryMod3, "7 % -3", -2.0)
+TEST_EVAL(BinaryMod, "x % 3", -7, 2.0)
+
+TEST_CONST(BinaryPow1, "2 ** 3", 8.0)
+TEST_CONST(BinaryPow2, "2 ** 3 ** 2", 512.0)
+TEST_CONST(BinaryPow3, "-2 ** 2", -4.0)
+TEST_CONST(BinaryPow4, "2 ** -1", 0.5)
+TEST_EVAL(BinaryPow, "x ** 2", 3, 9.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -322,6 +356,42 @@ TEST(expr_pylike, UsingParam)
   BLI_expr_pylike_free(expr);
 }
 
+TEST(expr_pylike, References)
+{
+  const char *names[1] = {"x"};
+  double values[3] = {1.0, 2.0, 3.0};
+
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse_ex(
+      "x + self.location[0] * 10 + self.pose.bones[1].length * 100 + self.location[0]",
+      names,
+      ARRAY_SIZE(names),
+      "self");
+
+  EXPECT_TRUE(BLI_expr_pylike_is_valid(expr));
+  ASSERT_EQ(BLI_expr_pylike_refs_count(expr), 2);
+  EXPECT_STREQ(BLI_expr_pylike_ref_path(expr, 0), "location[0]");
+  EXPECT_STREQ(BLI_expr_pylike_ref_path(expr, 1), "pose.bones[1].length");
+
+  double result;
+  eExprPyLike_EvalStatus status = BLI_expr_pylike_eval(expr, values, 3, &result);
+
+  EXPECT_EQ(status, EXPR_PYLIKE_SUCCESS);
+  EXPECT_EQ(result, 323.0);
+
+  BLI_expr_pylike_free(expr);
+}
+
+TEST(expr_pylike, ReferencesFail)
+{
+  const char *exprs[] = {"self", "self[0]", "self.", "self.a[-1]", "self.a[0.5]", "self.a[x]"};
+
+  for (const char *str : exprs) {
+    ExprPyLike_Parsed *expr = BLI_expr_pylike_parse_ex(str, nullptr, 0, "self");
+    EXPECT_FALSE(BLI_expr_pylike_is_valid(expr)) << str;
+    BLI_expr_pylike_free(expr);
+  }
+}
+
 #define TEST_ERROR(name, str, x, code) \
   TEST(expr_pylike, Error_##name) \
   { \
@@ -341,6 +411,9 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(FloorDivZero, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(ModZero, "1 % x", 0.0, EXPR_PYLIKE_MATH_ERROR)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
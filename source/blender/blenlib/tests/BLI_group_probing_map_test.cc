@@ -0,0 +1,212 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_exception_safety_test_utils.hh"
+#include "BLI_group_probing_map.hh"
+#include "BLI_group_probing_set.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+
+#include <string>
+
+namespace blender::tests {
+
+TEST(group_probing_map, DefaultConstructor)
+{
+  GroupProbingMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.capacity(), 0);
+  EXPECT_FALSE(map.contains(4));
+  EXPECT_EQ(map.lookup_ptr(4), nullptr);
+}
+
+TEST(group_probing_map, AddLookup)
+{
+  GroupProbingMap<int, int> map;
+  EXPECT_TRUE(map.add(2, 5));
+  EXPECT_FALSE(map.add(2, 6));
+  map.add_new(3, 7);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.lookup(2), 5);
+  EXPECT_EQ(map.lookup(3), 7);
+  EXPECT_EQ(map.lookup_default(4, 10), 10);
+  EXPECT_TRUE(map.add_overwrite(4, 1));
+  EXPECT_FALSE(map.add_overwrite(4, 2));
+  EXPECT_EQ(map.lookup(4), 2);
+  EXPECT_EQ(map.lookup_or_add(5, 3), 3);
+  EXPECT_EQ(map.lookup_or_add(5, 4), 3);
+  EXPECT_EQ(map.lookup_or_add_cb(6, []() { return 8; }), 8);
+  EXPECT_EQ(map.lookup_or_add_default(7), 0);
+  EXPECT_EQ(map.size(), 6);
+}
+
+TEST(group_probing_map, ManyKeys)
+{
+  GroupProbingMap<int, int> map;
+  for (const int i : IndexRange(10000)) {
+    map.add_new(i * 3, i);
+  }
+  EXPECT_EQ(map.size(), 10000);
+  for (const int i : IndexRange(10000)) {
+    EXPECT_EQ(map.lookup(i * 3), i);
+    EXPECT_FALSE(map.contains(i * 3 + 1));
+  }
+  int64_t sum = 0;
+  for (const auto item : map.items()) {
+    EXPECT_EQ(item.key, item.value * 3);
+    sum += item.value;
+  }
+  EXPECT_EQ(sum, 10000 * 9999 / 2);
+}
+
+TEST(group_probing_map, Remove)
+{
+  GroupProbingMap<int, int> map;
+  for (const int i : IndexRange(1000)) {
+    map.add(i, i);
+  }
+  for (const int i : IndexRange(1000)) {
+    if (i % 2 == 0) {
+      EXPECT_TRUE(map.remove(i));
+    }
+  }
+  EXPECT_FALSE(map.remove(0));
+  EXPECT_EQ(map.size(), 500);
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+  EXPECT_EQ(map.pop(1), 1);
+  EXPECT_EQ(map.pop_try(1), std::nullopt);
+  EXPECT_EQ(map.pop_try(3), 3);
+  EXPECT_EQ(map.remove_if([](auto item) { return item.key > 100; }), 450);
+  EXPECT_EQ(map.size(), 48);
+}
+
+TEST(group_probing_map, AddRemoveRepeated)
+{
+  /* Removed slots have to be reused or cleaned up, the map must not grow indefinitely. */
+  GroupProbingMap<int, int> map;
+  for (const int i : IndexRange(100000)) {
+    map.add_new(i, i);
+    if (i >= 10) {
+      map.remove_contained(i - 10);
+    }
+  }
+  EXPECT_EQ(map.size(), 10);
+  EXPECT_LE(map.capacity(), 64);
+  for (const int i : IndexRange(99990, 10)) {
+    EXPECT_EQ(map.lookup(i), i);
+  }
+}
+
+TEST(group_probing_map, RandomOperationsMatchMap)
+{
+  RandomNumberGenerator rng(0);
+  GroupProbingMap<int, int> group_map;
+  Map<int, int> map;
+  for (const int i : IndexRange(100000)) {
+    const int key = rng.get_int32(5000);
+    switch (rng.get_int32(3)) {
+      case 0:
+        EXPECT_EQ(group_map.add(key, i), map.add(key, i));
+        break;
+      case 1:
+        EXPECT_EQ(group_map.remove(key), map.remove(key));
+        break;
+      case 2:
+        EXPECT_EQ(group_map.lookup_default(key, -1), map.lookup_default(key, -1));
+        break;
+    }
+  }
+  EXPECT_EQ(group_map.size(), map.size());
+  for (const auto item : map.items()) {
+    EXPECT_EQ(group_map.lookup(item.key), item.value);
+  }
+}
+
+TEST(group_probing_map, CopyAndMove)
+{
+  GroupProbingMap<std::string, Vector<int>> map;
+  for (const int i : IndexRange(100)) {
+    map.add(std::to_string(i), {i, i + 1});
+  }
+  GroupProbingMap<std::string, Vector<int>> map_copy = map;
+  EXPECT_EQ(map_copy.size(), 100);
+  EXPECT_EQ(map_copy.lookup("42")[1], 43);
+
+  GroupProbingMap<std::string, Vector<int>> map_moved = std::move(map);
+  EXPECT_EQ(map_moved.size(), 100);
+  EXPECT_EQ(map.size(), 0); /* NOLINT: bugprone-use-after-move */
+  EXPECT_EQ(map_moved.lookup("99")[0], 99);
+
+  map = map_copy;
+  EXPECT_EQ(map.size(), 100);
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains("1"));
+  map.clear_and_shrink();
+  EXPECT_EQ(map.capacity(), 0);
+}
+
+TEST(group_probing_map, LookupAs)
+{
+  GroupProbingMap<std::string, int> map;
+  map.add("abc", 1);
+  EXPECT_EQ(map.lookup_as(StringRef("abc")), 1);
+  EXPECT_TRUE(map.contains_as(StringRef("abc")));
+  EXPECT_FALSE(map.contains_as(StringRef("abcd")));
+}
+
+TEST(group_probing_map, Reserve)
+{
+  GroupProbingMap<int, int> map;
+  map.reserve(1000);
+  const int64_t capacity = map.capacity();
+  EXPECT_GE(capacity, 1000);
+  for (const int i : IndexRange(1000)) {
+    map.add_new(i, i);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(group_probing_map, ThrowingValueConstructor)
+{
+  GroupProbingMap<int, ExceptionThrower> map;
+  map.add(1, ExceptionThrower(1));
+  ExceptionThrower value(2);
+  value.throw_during_copy = true;
+  EXPECT_ANY_THROW({ map.add(2, value); });
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_FALSE(map.contains(2));
+}
+
+TEST(group_probing_set, Basic)
+{
+  GroupProbingSet<int> set = {1, 2, 3, 2};
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains(2));
+  EXPECT_FALSE(set.contains(4));
+  EXPECT_TRUE(set.add(4));
+  EXPECT_FALSE(set.add(4));
+  EXPECT_TRUE(set.remove(1));
+  EXPECT_FALSE(set.remove(1));
+  int sum = 0;
+  for (const int key : set) {
+    sum += key;
+  }
+  EXPECT_EQ(sum, 9);
+}
+
+TEST(group_probing_set, EmptyValueHasNoSize)
+{
+  GroupProbingSet<int64_t> set;
+  EXPECT_EQ(set.size_per_element(), sizeof(int64_t) + 1);
+}
+
+}  // namespace blender::tests
@@ -113,4 +113,71 @@ TEST(implicit_sharing, Version)
   EXPECT_LT(old_version, sharing_info->version());
 }
 
+class ReadOnlySharingInfo : public ImplicitSharingInfo {
+ public:
+  ReadOnlySharingInfo()
+  {
+    data_is_read_only_ = true;
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    MEM_delete(this);
+  }
+};
+
+TEST(implicit_sharing, ReadOnlyData)
+{
+  static const int values[4] = {1, 2, 3, 4};
+  const ImplicitSharingInfo *sharing_info = MEM_new<ReadOnlySharingInfo>(__func__);
+  EXPECT_FALSE(sharing_info->is_mutable());
+
+  /* Making the data mutable has to copy it, even though there is a single user. */
+  int *data = const_cast<int *>(values);
+  implicit_sharing::make_trivial_data_mutable(&data, &sharing_info, 4);
+  EXPECT_NE(data, values);
+  EXPECT_EQ(data[3], 4);
+  EXPECT_TRUE(sharing_info->is_mutable());
+  sharing_info->remove_user_and_delete_if_last();
+}
+
+TEST(implicit_sharing, ReadOnlyDataOwnership)
+{
+  const ImplicitSharingInfo *sharing_info = MEM_new<ReadOnlySharingInfo>(__func__);
+  /* A single owner does not make read-only data mutable. */
+  EXPECT_EQ(sharing_info->strong_users(), 1);
+  EXPECT_FALSE(sharing_info->is_mutable());
+  sharing_info->add_user();
+  EXPECT_FALSE(sharing_info->is_mutable());
+  sharing_info->remove_user_and_delete_if_last();
+  EXPECT_EQ(sharing_info->strong_users(), 1);
+  EXPECT_FALSE(sharing_info->is_mutable());
+  EXPECT_FALSE(sharing_info->is_expired());
+
+  /* Weak users and versions work as for other data. */
+  sharing_info->add_weak_user();
+  const int64_t version = sharing_info->version();
+  sharing_info->remove_user_and_delete_if_last();
+  EXPECT_TRUE(sharing_info->is_expired());
+  EXPECT_EQ(sharing_info->version(), version);
+  sharing_info->remove_weak_user_and_delete_if_last();
+}
+
+TEST(implicit_sharing, ReadOnlyDataResize)
+{
+  static const int values[4] = {1, 2, 3, 4};
+  const ImplicitSharingInfo *sharing_info = MEM_new<ReadOnlySharingInfo>(__func__);
+
+  /* Resizing must not reallocate the read-only data in place. */
+  int *data = const_cast<int *>(values);
+  implicit_sharing::resize_trivial_array(&data, &sharing_info, 4, 8);
+  EXPECT_NE(data, values);
+  EXPECT_EQ(data[0], 1);
+  EXPECT_EQ(data[3], 4);
+  EXPECT_EQ(values[3], 4);
+  EXPECT_TRUE(sharing_info->is_mutable());
+  sharing_info->remove_user_and_delete_if_last();
+}
+
 }  // namespace blender::tests
@@ -170,4 +170,29 @@ TEST(linear_allocator, TransferOwnership)
   EXPECT_EQ(values[index], value);
 }
 
+TEST(linear_allocator, Reset)
+{
+  LinearAllocator<> allocator;
+  for ([[maybe_unused]] const int64_t i : IndexRange(100)) {
+    allocator.allocate(1000, 8);
+  }
+  allocator.allocate(100'000, 8);
+  allocator.reset();
+
+  /* The memory is reused in a single buffer after the reset. */
+  const uintptr_t begin = uintptr_t(allocator.allocate(1, 1));
+  for ([[maybe_unused]] const int64_t i : IndexRange(100)) {
+    const uintptr_t ptr = uintptr_t(allocator.allocate(1000, 8));
+    EXPECT_GT(ptr, begin);
+    EXPECT_LT(ptr, begin + 200'000);
+  }
+  allocator.reset();
+  EXPECT_EQ(uintptr_t(allocator.allocate(1, 1)), begin);
+
+  allocator.reset(0);
+  int *values = allocator.allocate_array<int>(10).data();
+  values[9] = 5;
+  EXPECT_EQ(values[9], 5);
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,56 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_scratch_allocator.hh"
+
+namespace blender::tests {
+
+TEST(scratch_allocator, WithoutArena)
+{
+  EXPECT_EQ(scratch_arena_get(), nullptr);
+  ScratchVector<int> values;
+  for (const int i : IndexRange(1000)) {
+    values.append(i);
+  }
+  EXPECT_EQ(values[999], 999);
+}
+
+TEST(scratch_allocator, WithArena)
+{
+  LinearAllocator<> arena;
+  {
+    ScratchArenaScope scope(arena);
+    EXPECT_EQ(scratch_arena_get(), &arena);
+    ScratchArray<int64_t> values(1000, 3);
+    EXPECT_EQ(values[500], 3);
+    ScratchVector<float, 0> aligned;
+    aligned.append(1.0f);
+  }
+  EXPECT_EQ(scratch_arena_get(), nullptr);
+  arena.reset();
+}
+
+TEST(scratch_allocator, MixedAllocations)
+{
+  LinearAllocator<> arena;
+  ScratchVector<int> values;
+  {
+    ScratchArenaScope scope(arena);
+    values.append_n_times(1, 100);
+  }
+  /* Growing outside of the scope has to reallocate with the guarded allocator. */
+  values.append_n_times(2, 1000);
+  EXPECT_EQ(values[50], 1);
+  EXPECT_EQ(values[500], 2);
+  {
+    LinearAllocator<> nested_arena;
+    ScratchArenaScope scope(arena);
+    ScratchArenaScope nested_scope(nested_arena);
+    EXPECT_EQ(scratch_arena_get(), &nested_arena);
+  }
+}
+
+}  // namespace blender::tests
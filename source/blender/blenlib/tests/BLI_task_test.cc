@@ -16,6 +16,7 @@
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_statistics.hh"
 
 #define ITEMS_NUM 10000
 
@@ -294,3 +295,32 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, ParallelForStatistics)
+{
+  namespace statistics = blender::threading::statistics;
+  statistics::clear();
+  statistics::enable(true);
+
+  std::atomic<int> counter = 0;
+  for ([[maybe_unused]] const int i : blender::IndexRange(2)) {
+    blender::threading::parallel_for(blender::IndexRange(10000), 100, [&](const auto range) {
+      counter += int(range.size());
+    });
+  }
+  statistics::enable(false);
+  EXPECT_EQ(counter, 20000);
+
+#ifdef WITH_TBB
+  const blender::Vector<statistics::CallSiteStatistics> stats = statistics::get();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].calls, 2);
+  EXPECT_EQ(stats[0].items, 20000);
+  EXPECT_GE(stats[0].tasks, 2);
+  EXPECT_LE(stats[0].stolen_tasks, stats[0].tasks);
+  EXPECT_NE(std::strstr(stats[0].file, "BLI_task_test.cc"), nullptr);
+#endif
+
+  statistics::clear();
+  EXPECT_TRUE(statistics::get().is_empty());
+}
@@ -0,0 +1,127 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Minimal micro-benchmark harness on top of GTest.
+ *
+ * Every benchmark runs its function in batches that take at least #BATCH_TIME_MIN, and reports
+ * the median time of a single call over #BATCHES_NUM batches. The median is used because it is
+ * much less affected by other processes than the mean.
+ *
+ * Results are printed, and when the `BLENDER_BENCHMARK_JSON` environment variable is set, they
+ * are also written to that file as JSON once all tests ran, e.g.:
+ *
+ * \code{.json}
+ * {"benchmarks": [{"name": "map_insert", "time": 1.2e-3, "time_min": 1.1e-3, "iterations": 400}]}
+ * \endcode
+ *
+ * This is what `tests/performance/tests/blenlib.py` reads to graph the results over time.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "testing/testing.h"
+
+#include "BLI_function_ref.hh"
+#include "BLI_serialize.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+namespace blender::benchmark {
+
+constexpr int BATCHES_NUM = 15;
+constexpr double BATCH_TIME_MIN = 0.01;
+
+struct Result {
+  std::string name;
+  /** Median time of a single call, in seconds. */
+  double time;
+  /** Fastest time of a single call, in seconds. */
+  double time_min;
+  int64_t iterations;
+};
+
+inline Vector<Result> &results()
+{
+  static Vector<Result> results;
+  return results;
+}
+
+/** Make sure the compiler doesn't optimize away the computation of #value. */
+template<typename T> inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  const volatile T *volatile ptr = &value;
+  UNUSED_VARS(ptr);
+#endif
+}
+
+inline double batch_time(const FunctionRef<void()> fn, const int64_t iterations)
+{
+  using namespace blender::timeit;
+  const TimePoint start = Clock::now();
+  for ([[maybe_unused]] const int64_t i : IndexRange(iterations)) {
+    fn();
+  }
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/** Measure the time of #fn, see the file description. */
+inline void run(const std::string &name, const FunctionRef<void()> fn)
+{
+  /* Warm up caches and find the number of iterations needed per batch. */
+  int64_t iterations = 1;
+  while (batch_time(fn, iterations) < BATCH_TIME_MIN) {
+    iterations *= 2;
+  }
+
+  Vector<double> times;
+  for ([[maybe_unused]] const int i : IndexRange(BATCHES_NUM)) {
+    times.append(batch_time(fn, iterations) / double(iterations));
+  }
+  std::sort(times.begin(), times.end());
+
+  const Result result{name, times[times.size() / 2], times.first(), iterations};
+  std::cout << "  " << name << ": " << result.time * 1e6 << " us (min " << result.time_min * 1e6
+            << " us, " << iterations << " iterations)\n";
+  results().append(result);
+}
+
+/** Writes the JSON file after all tests ran. */
+class JsonEnvironment : public ::testing::Environment {
+ public:
+  void TearDown() override
+  {
+    const char *filepath = std::getenv("BLENDER_BENCHMARK_JSON");
+    if (filepath == nullptr || filepath[0] == '\0') {
+      return;
+    }
+    io::serialize::DictionaryValue root;
+    io::serialize::ArrayValue &benchmarks = *root.append_array("benchmarks");
+    for (const Result &result : results()) {
+      io::serialize::DictionaryValue &item = *benchmarks.append_dict();
+      item.append_str("name", result.name);
+      item.append_double("time", result.time);
+      item.append_double("time_min", result.time_min);
+      item.append_int("iterations", result.iterations);
+    }
+    io::serialize::write_json_file(filepath, root);
+  }
+};
+
+/** Register in each benchmark executable with #BLI_BENCHMARK_REGISTER_JSON_OUTPUT. */
+#define BLI_BENCHMARK_REGISTER_JSON_OUTPUT() \
+  static ::testing::Environment *const benchmark_json_environment = \
+      ::testing::AddGlobalTestEnvironment(new blender::benchmark::JsonEnvironment())
+
+}  // namespace blender::benchmark
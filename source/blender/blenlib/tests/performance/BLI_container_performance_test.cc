@@ -0,0 +1,225 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_benchmark.hh"
+
+#include "BLI_array.hh"
+#include "BLI_group_probing_map.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_vector_set.hh"
+#include "BLI_virtual_array.hh"
+
+namespace blender::benchmark::tests {
+
+BLI_BENCHMARK_REGISTER_JSON_OUTPUT();
+
+constexpr int ITEMS_NUM = 100000;
+
+static Array<int> random_keys(const int size)
+{
+  RandomNumberGenerator rng(0);
+  Array<int> keys(size);
+  for (int &key : keys) {
+    key = rng.get_int32();
+  }
+  return keys;
+}
+
+TEST(container_performance, Map)
+{
+  const Array<int> keys = random_keys(ITEMS_NUM);
+
+  run("map_add", [&]() {
+    Map<int, int> map;
+    for (const int i : keys.index_range()) {
+      map.add(keys[i], i);
+    }
+    do_not_optimize(map);
+  });
+
+  Map<int, int> map;
+  for (const int i : keys.index_range()) {
+    map.add(keys[i], i);
+  }
+  run("map_lookup", [&]() {
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += map.lookup(key);
+    }
+    do_not_optimize(sum);
+  });
+  run("map_lookup_missing", [&]() {
+    int64_t found = 0;
+    for (const int key : keys) {
+      found += map.contains(key + 1);
+    }
+    do_not_optimize(found);
+  });
+}
+
+TEST(container_performance, GroupProbingMap)
+{
+  const Array<int> keys = random_keys(ITEMS_NUM);
+
+  run("group_probing_map_add", [&]() {
+    GroupProbingMap<int, int> map;
+    for (const int i : keys.index_range()) {
+      map.add(keys[i], i);
+    }
+    do_not_optimize(map);
+  });
+
+  GroupProbingMap<int, int> map;
+  for (const int i : keys.index_range()) {
+    map.add(keys[i], i);
+  }
+  run("group_probing_map_lookup", [&]() {
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += map.lookup(key);
+    }
+    do_not_optimize(sum);
+  });
+  run("group_probing_map_lookup_missing", [&]() {
+    int64_t found = 0;
+    for (const int key : keys) {
+      found += map.contains(key + 1);
+    }
+    do_not_optimize(found);
+  });
+}
+
+TEST(container_performance, Set)
+{
+  const Array<int> keys = random_keys(ITEMS_NUM);
+
+  run("set_add", [&]() {
+    Set<int> set;
+    for (const int key : keys) {
+      set.add(key);
+    }
+    do_not_optimize(set);
+  });
+
+  Set<int> set;
+  set.add_multiple(keys);
+  run("set_contains", [&]() {
+    int64_t found = 0;
+    for (const int key : keys) {
+      found += set.contains(key);
+    }
+    do_not_optimize(found);
+  });
+}
+
+TEST(container_performance, VectorSet)
+{
+  const Array<int> keys = random_keys(ITEMS_NUM);
+
+  run("vector_set_add", [&]() {
+    VectorSet<int> set;
+    for (const int key : keys) {
+      set.add(key);
+    }
+    do_not_optimize(set);
+  });
+
+  VectorSet<int> set;
+  set.add_multiple(keys);
+  run("vector_set_index_of", [&]() {
+    int64_t sum = 0;
+    for (const int key : keys) {
+      sum += set.index_of(key);
+    }
+    do_not_optimize(sum);
+  });
+}
+
+TEST(container_performance, IndexMask)
+{
+  const int size = ITEMS_NUM * 10;
+  const Array<int> values = random_keys(size);
+
+  run("index_mask_from_predicate", [&]() {
+    IndexMaskMemory memory;
+    const IndexMask mask = IndexMask::from_predicate(
+        IndexRange(size), GrainSize(4096), memory, [&](const int64_t i) {
+          return values[i] % 3 == 0;
+        });
+    do_not_optimize(mask.size());
+  });
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(4096), memory, [&](const int64_t i) {
+        return values[i] % 3 == 0;
+      });
+  run("index_mask_foreach_index", [&]() {
+    int64_t sum = 0;
+    mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+    do_not_optimize(sum);
+  });
+}
+
+TEST(container_performance, OffsetIndices)
+{
+  RandomNumberGenerator rng(0);
+  Array<int> counts(ITEMS_NUM + 1);
+  for (int &count : counts.as_mutable_span().drop_back(1)) {
+    count = rng.get_int32(8);
+  }
+
+  run("offset_indices_accumulate", [&]() {
+    Array<int> offsets_data = counts;
+    const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(
+        offsets_data);
+    do_not_optimize(offsets.total_size());
+  });
+
+  Array<int> offsets_data = counts;
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(offsets_data);
+  run("offset_indices_iterate", [&]() {
+    int64_t sum = 0;
+    for (const int i : offsets.index_range()) {
+      sum += offsets[i].size();
+    }
+    do_not_optimize(sum);
+  });
+}
+
+TEST(container_performance, VArrayDevirtualize)
+{
+  const int size = ITEMS_NUM * 10;
+  const Array<int> values = random_keys(size);
+  const VArray<int> varray_span = VArray<int>::ForSpan(values);
+  const VArray<int> varray_single = VArray<int>::ForSingle(1, size);
+
+  run("varray_get", [&]() {
+    int64_t sum = 0;
+    for (const int i : varray_span.index_range()) {
+      sum += varray_span[i];
+    }
+    do_not_optimize(sum);
+  });
+
+  const auto sum_devirtualized = [](const VArray<int> &varray) {
+    int64_t sum = 0;
+    devirtualize_varray(varray, [&](const auto span) {
+      for (const int i : varray.index_range()) {
+        sum += span[i];
+      }
+    });
+    return sum;
+  };
+  run("varray_devirtualize_span",
+      [&]() { do_not_optimize(sum_devirtualized(varray_span)); });
+  run("varray_devirtualize_single",
+      [&]() { do_not_optimize(sum_devirtualized(varray_single)); });
+}
+
+}  // namespace blender::benchmark::tests
@@ -0,0 +1,116 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_benchmark.hh"
+
+#include "BLI_array.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+#include "BLI_rand.hh"
+
+namespace blender::benchmark::tests {
+
+BLI_BENCHMARK_REGISTER_JSON_OUTPUT();
+
+constexpr int ITEMS_NUM = 100000;
+
+static Array<float3> random_vectors(const int size)
+{
+  RandomNumberGenerator rng(0);
+  Array<float3> vectors(size);
+  for (float3 &vector : vectors) {
+    vector = rng.get_unit_float3() * (rng.get_float() + 0.5f);
+  }
+  return vectors;
+}
+
+static float4x4 random_transform(RandomNumberGenerator &rng)
+{
+  return math::from_loc_rot_scale<float4x4>(rng.get_unit_float3(),
+                                            math::EulerXYZ(rng.get_float(),
+                                                           rng.get_float(),
+                                                           rng.get_float()),
+                                            float3(rng.get_float() + 0.5f));
+}
+
+TEST(math_performance, Vector)
+{
+  const Array<float3> a = random_vectors(ITEMS_NUM);
+  const Array<float3> b = random_vectors(ITEMS_NUM);
+  Array<float3> result(ITEMS_NUM);
+
+  run("vector_normalize", [&]() {
+    for (const int i : a.index_range()) {
+      result[i] = math::normalize(a[i]);
+    }
+    do_not_optimize(result.data());
+  });
+  run("vector_dot", [&]() {
+    float sum = 0.0f;
+    for (const int i : a.index_range()) {
+      sum += math::dot(a[i], b[i]);
+    }
+    do_not_optimize(sum);
+  });
+  run("vector_cross", [&]() {
+    for (const int i : a.index_range()) {
+      result[i] = math::cross(a[i], b[i]);
+    }
+    do_not_optimize(result.data());
+  });
+  run("vector_normalize_c", [&]() {
+    for (const int i : a.index_range()) {
+      normalize_v3_v3(result[i], a[i]);
+    }
+    do_not_optimize(result.data());
+  });
+}
+
+TEST(math_performance, Matrix)
+{
+  RandomNumberGenerator rng(0);
+  Array<float4x4> matrices(ITEMS_NUM / 10);
+  for (float4x4 &matrix : matrices) {
+    matrix = random_transform(rng);
+  }
+  const float4x4 transform = random_transform(rng);
+  const Array<float3> positions = random_vectors(ITEMS_NUM);
+  Array<float4x4> result(matrices.size());
+  Array<float3> result_positions(ITEMS_NUM);
+
+  run("matrix_multiply", [&]() {
+    for (const int i : matrices.index_range()) {
+      result[i] = transform * matrices[i];
+    }
+    do_not_optimize(result.data());
+  });
+  run("matrix_multiply_c", [&]() {
+    for (const int i : matrices.index_range()) {
+      mul_m4_m4m4(result[i].ptr(), transform.ptr(), matrices[i].ptr());
+    }
+    do_not_optimize(result.data());
+  });
+  run("matrix_invert", [&]() {
+    for (const int i : matrices.index_range()) {
+      result[i] = math::invert(matrices[i]);
+    }
+    do_not_optimize(result.data());
+  });
+  run("matrix_transform_point", [&]() {
+    for (const int i : positions.index_range()) {
+      result_positions[i] = math::transform_point(transform, positions[i]);
+    }
+    do_not_optimize(result_positions.data());
+  });
+  run("matrix_transform_point_c", [&]() {
+    for (const int i : positions.index_range()) {
+      mul_v3_m4v3(result_positions[i], transform.ptr(), positions[i]);
+    }
+    do_not_optimize(result_positions.data());
+  });
+}
+
+}  // namespace blender::benchmark::tests
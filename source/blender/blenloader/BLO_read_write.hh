@@ -33,6 +33,12 @@
 
 #include "DNA_windowmanager_types.h" /* for eReportType */
 
+#include "BLI_function_ref.hh"
+
+namespace blender {
+class ImplicitSharingInfo;
+}
+
 struct BlendDataReader;
 struct BlendFileReadReport;
 struct BlendLibReader;
@@ -188,6 +194,20 @@ void BLO_write_string(BlendWriter *writer, const char *data_ptr);
  */
 bool BLO_write_is_undo(BlendWriter *writer);
 
+/**
+ * Write data that is owned through implicit sharing. For undo steps, the data is not copied but
+ * the undo step becomes an additional owner of it instead (which makes the data immutable). This
+ * makes undo steps of large unchanged arrays (e.g. mesh attributes) almost free.
+ *
+ * \param approximate_size_in_bytes: Only used for memory usage statistics of the undo step.
+ * \param write_fn: Writes the data, called when it can't be shared.
+ */
+void BLO_write_shared(BlendWriter *writer,
+                      const void *data,
+                      size_t approximate_size_in_bytes,
+                      const blender::ImplicitSharingInfo *sharing_info,
+                      blender::FunctionRef<void()> write_fn);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -248,6 +268,34 @@ void BLO_read_pointer_array(BlendDataReader *reader, void **ptr_p);
 int BLO_read_fileversion_get(BlendDataReader *reader);
 bool BLO_read_requires_endian_switch(BlendDataReader *reader);
 bool BLO_read_data_is_undo(BlendDataReader *reader);
+
+/**
+ * Read data written with #BLO_write_shared. When the data was shared with the undo step, the
+ * pointer is already valid and a new user is added to the sharing info.
+ *
+ * \param data_ptr: Pointer to the (old) address of the data, as stored in the file.
+ * \param read_fn: Reads the data and returns the sharing info for it, when it wasn't shared.
+ * \return The sharing info, with a user owned by the caller.
+ */
+const blender::ImplicitSharingInfo *BLO_read_shared(
+    BlendDataReader *reader,
+    void **data_ptr,
+    blender::FunctionRef<const blender::ImplicitSharingInfo *()> read_fn);
+/**
+ * Same as #BLO_read_shared, for arrays of trivial types that \a read_fn would use as stored in the
+ * file (no pointers, no endian switch). When the file is memory-mapped, large arrays reference the
+ * mapped file directly instead of being copied. Their sharing info is never mutable, so the data
+ * is copied when it is modified.
+ *
+ * \param size_in_bytes: The size of the array, the data-block has to be at least as large.
+ * \param alignment: Required alignment of the data, mapped data that isn't aligned is copied.
+ */
+const blender::ImplicitSharingInfo *BLO_read_shared_array(
+    BlendDataReader *reader,
+    void **data_ptr,
+    int64_t size_in_bytes,
+    int64_t alignment,
+    blender::FunctionRef<const blender::ImplicitSharingInfo *()> read_fn);
 void BLO_read_data_globmap_add(BlendDataReader *reader, void *oldaddr, void *newaddr);
 void BLO_read_glob_list(BlendDataReader *reader, ListBase *list);
 BlendFileReadReport *BLO_read_data_reports(BlendDataReader *reader);
@@ -11,16 +11,48 @@
 
 #include "BLI_filereader.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
 
+#include "DNA_sdna_types.h"
+
+namespace blender {
+class ImplicitSharingInfo;
+}
 struct GHash;
 struct Main;
 struct Scene;
 
+/**
+ * Chunks at least this large are stored as slices (see #MemFileChunkSlice). The writer passes
+ * large arrays as a single chunk for this, instead of splitting them into small pieces.
+ */
+#define MEMFILE_SLICE_CHUNK_SIZE_MIN (size_t(1) << 18)
+
+/**
+ * Part of the data of a large #MemFileChunk, split at content-defined boundaries so that
+ * unchanged parts of the data can be shared between undo steps, even when the chunk as a whole
+ * changed.
+ */
+struct MemFileChunkSlice {
+  const char *buf;
+  /** Size in bytes. */
+  size_t size;
+  uint32_t hash;
+  /** Number of #MemFileChunk using this slice, it is freed when that reaches zero. */
+  int users;
+};
+
 struct MemFileChunk {
   void *next, *prev;
+  /** Data of the chunk, null when the data is stored in #slices instead. */
   const char *buf;
   /** Size in bytes. */
   size_t size;
+  /** When the chunk is large, its data is stored in slices shared with other chunks (the
+   * #is_identical ownership logic doesn't apply to these then). */
+  MemFileChunkSlice **slices;
+  int slices_num;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
@@ -32,9 +64,36 @@ struct MemFileChunk {
   uint id_session_uuid;
 };
 
+/**
+ * Data stored in the undo step by keeping a reference to it through implicit sharing, instead of
+ * copying it into #MemFileChunk's (see #BLO_write_shared). The map key is the address of the data,
+ * which is also the pointer stored in the written structs.
+ */
+struct MemFileSharedStorage {
+  blender::Map<const void *, const blender::ImplicitSharingInfo *> map;
+
+  /**
+   * A data-block that would have been written for shared data, it is not part of the chunks.
+   * Only used to write the memfile as a regular file, see #BLO_memfile_write_file.
+   */
+  struct Block {
+    /** Position in the data of the chunks, always at the start of a chunk. */
+    size_t offset;
+    BHead bhead;
+    /** Owned by #map. */
+    const void *data;
+  };
+  /** Ordered by their offset. */
+  blender::Vector<Block> blocks;
+
+  ~MemFileSharedStorage();
+};
+
 struct MemFile {
   ListBase chunks;
   size_t size;
+  /** Null when no data was shared. */
+  MemFileSharedStorage *shared_storage;
 };
 
 struct MemFileWriteData {
@@ -43,6 +102,8 @@ struct MemFileWriteData {
 
   uint current_id_session_uuid;
   MemFileChunk *reference_current_chunk;
+  /** Size of the chunks written so far. */
+  size_t written_size;
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   GHash *id_session_uuid_mapping;
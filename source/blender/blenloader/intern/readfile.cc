@@ -51,11 +51,15 @@
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_ghash.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_linklist.h"
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "PIL_time.h"
 
@@ -175,6 +179,24 @@
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
+/**
+ * Decode (endian switch and DNA reconstruct) the data-blocks belonging to an ID on the task pool.
+ * Only reading from the file has to be sequential, converting the blocks is independent.
+ */
+#define USE_PARALLEL_DATA_DECODE
+
+/**
+ * Large raw data-blocks of memory-mapped files are not copied when reading, arrays that are read
+ * with #BLO_read_shared_array reference the mapped file directly using implicit sharing instead.
+ * The mapping stays alive as long as any of that data is used, modifying it makes a copy.
+ *
+ * \note Not used on WIN32, where a file can't be replaced while it is mapped, which would break
+ * saving over the file that is open.
+ */
+#ifndef WIN32
+#  define USE_MMAP_SHARED_DATA
+#endif
+
 static CLG_LogRef LOG = {"blo.readfile"};
 static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 
@@ -321,6 +343,171 @@ static void oldnewmap_free(OldNewMap *onm)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Memory-Mapped Data API
+ * \{ */
+
+#ifdef USE_MMAP_SHARED_DATA
+
+/**
+ * Raw data-blocks smaller than this are always copied, referencing the mapped file only pays off
+ * for large arrays and keeps the whole mapping alive.
+ */
+#  define MMAP_SHARED_DATA_MIN_SIZE (64 * 1024)
+
+/** Owns the mapping of a file, it is freed when neither the #FileData nor any data uses it. */
+struct MMapFileSharing : public blender::ImplicitSharingInfo {
+  BLI_mmap_file *mmap_file;
+  const char *memory;
+  size_t length;
+
+  MMapFileSharing(BLI_mmap_file *mmap_file)
+      : mmap_file(mmap_file),
+        memory(static_cast<const char *>(BLI_mmap_get_pointer(mmap_file))),
+        length(BLI_mmap_get_length(mmap_file))
+  {
+    /* Shared data references the memory directly, it would silently become zeroes when the file
+     * is truncated while it's in use. */
+    BLI_mmap_set_errors_fatal(mmap_file);
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(mmap_file);
+    MEM_delete(this);
+  }
+};
+
+/**
+ * Sharing info for a single data-block referencing the mapped file. The mapped pages are
+ * read-only, so the data is never mutable, not even with a single owner.
+ */
+class MMapDataSharing : public blender::ImplicitSharingInfo {
+ private:
+  const MMapFileSharing *file_sharing_;
+
+ public:
+  MMapDataSharing(const MMapFileSharing *file_sharing) : file_sharing_(file_sharing)
+  {
+    data_is_read_only_ = true;
+    file_sharing_->add_user();
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    file_sharing_->remove_user_and_delete_if_last();
+    MEM_delete(this);
+  }
+};
+
+struct MMapData {
+  /** Offset of the data in the mapped file. */
+  off64_t file_offset;
+  size_t size;
+  /** Name used when the data has to be copied after all. */
+  const char *allocname;
+  /** Created on first use by #BLO_read_shared_array, the map owns one user. */
+  const MMapDataSharing *sharing_info;
+};
+
+struct MMapDataMap {
+  blender::Map<const void *, MMapData> map;
+  /** Whether data-blocks of a file SDNA struct can be used as stored in the file. */
+  blender::Map<int, bool> struct_is_plain;
+};
+
+/**
+ * Structs are used as stored in the file when they are equal to the current DNA and don't have
+ * pointers, which are remapped in place when reading. This covers arrays of types like `vec3f`,
+ * `MIntProperty` and `MFloatProperty`. Raw data (#BHead.SDNAnr 0) is always plain.
+ */
+static bool mmap_struct_is_plain(FileData *fd, const int sdna_nr)
+{
+  if (sdna_nr == 0) {
+    return true;
+  }
+  if (fd->compflags[sdna_nr] != SDNA_CMP_EQUAL) {
+    return false;
+  }
+  return fd->mmap_datamap->struct_is_plain.lookup_or_add_cb(
+      sdna_nr, [&]() { return !DNA_struct_has_pointers(fd->filesdna, sdna_nr); });
+}
+
+/**
+ * Register a data-block that can reference the mapped file instead of being read into the
+ * datamap. Returns false when the data has to be read as usual.
+ */
+static bool mmap_data_register(FileData *fd, BHead *bhead, const char *allocname)
+{
+  if (fd->mmap_datamap == nullptr) {
+    return false;
+  }
+  /* Only data that is used as is (no pointers to convert, no endian switch). */
+  if (bhead->len < MMAP_SHARED_DATA_MIN_SIZE || (fd->flags & FD_FLAGS_SWITCH_ENDIAN) ||
+      !mmap_struct_is_plain(fd, bhead->SDNAnr))
+  {
+    return false;
+  }
+  const BHeadN *new_bhead = BHEADN_FROM_BHEAD(bhead);
+  if (new_bhead->has_data || new_bhead->file_offset == 0 ||
+      size_t(new_bhead->file_offset) + size_t(bhead->len) > fd->mmap_sharing->length)
+  {
+    return false;
+  }
+  if (fd->datamap->map.contains(bhead->old)) {
+    return false;
+  }
+  fd->mmap_datamap->map.add_overwrite(
+      bhead->old, MMapData{new_bhead->file_offset, size_t(bhead->len), allocname, nullptr});
+  return true;
+}
+
+/**
+ * The data is accessed with the generic API (see #newdataadr), which allows modifying it in
+ * place. Copy it into the datamap like any other data-block.
+ */
+static void *mmap_data_copy_into_datamap(FileData *fd, const void *adr, const int nr)
+{
+  if (fd->mmap_datamap == nullptr || adr == nullptr) {
+    return nullptr;
+  }
+  const std::optional<MMapData> data = fd->mmap_datamap->map.pop_try(adr);
+  if (!data) {
+    return nullptr;
+  }
+  void *new_data = MEM_mallocN(data->size, data->allocname);
+  if (UNLIKELY(!BLI_mmap_read(
+          fd->mmap_sharing->mmap_file, new_data, size_t(data->file_offset), data->size)))
+  {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+    memset(new_data, 0, data->size);
+  }
+  if (data->sharing_info) {
+    data->sharing_info->remove_user_and_delete_if_last();
+  }
+  oldnewmap_insert(fd->datamap, adr, new_data, nr);
+  return new_data;
+}
+
+static void mmap_datamap_clear(FileData *fd)
+{
+  if (fd->mmap_datamap == nullptr) {
+    return;
+  }
+  for (const MMapData &data : fd->mmap_datamap->map.values()) {
+    if (data.sharing_info) {
+      data.sharing_info->remove_user_and_delete_if_last();
+    }
+  }
+  fd->mmap_datamap->map.clear();
+}
+
+#endif /* USE_MMAP_SHARED_DATA */
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Helper Functions
  * \{ */
@@ -1182,10 +1369,22 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   /* Rewind the file after reading the header. */
   rawfile->seek(rawfile, 0, SEEK_SET);
 
+#ifdef USE_MMAP_SHARED_DATA
+  MMapFileSharing *mmap_sharing = nullptr;
+#endif
+
   /* Check if we have a regular file. */
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     /* Try opening the file with memory-mapped IO. */
+#ifdef USE_MMAP_SHARED_DATA
+    if (BLI_mmap_file *mmap_file = BLI_mmap_open(filedes)) {
+      /* The mapping may outlive the #FileData when data references it. */
+      mmap_sharing = MEM_new<MMapFileSharing>(__func__, mmap_file);
+      file = BLI_filereader_new_mmap_file(mmap_file);
+    }
+#else
     file = BLI_filereader_new_mmap(filedes);
+#endif
     if (file == nullptr) {
       /* `mmap` failed, so just keep using `rawfile`. */
       file = rawfile;
@@ -1216,6 +1415,12 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   FileData *fd = filedata_new(reports);
   fd->file = file;
+#ifdef USE_MMAP_SHARED_DATA
+  if (mmap_sharing) {
+    fd->mmap_sharing = mmap_sharing;
+    fd->mmap_datamap = MEM_new<MMapDataMap>(__func__);
+  }
+#endif
 
   return fd;
 }
@@ -1352,6 +1557,16 @@ void blo_filedata_free(FileData *fd)
     if (fd->libmap && !(fd->flags & FD_FLAGS_NOT_MY_LIBMAP)) {
       oldnewmap_free(fd->libmap);
     }
+#ifdef USE_MMAP_SHARED_DATA
+    if (fd->mmap_datamap) {
+      mmap_datamap_clear(fd);
+      MEM_delete(fd->mmap_datamap);
+    }
+    if (fd->mmap_sharing) {
+      /* Data read from the file may still reference the mapping. */
+      fd->mmap_sharing->remove_user_and_delete_if_last();
+    }
+#endif
     if (fd->old_idmap_uuid != nullptr) {
       BKE_main_idmap_destroy(fd->old_idmap_uuid);
     }
@@ -1418,13 +1633,25 @@ BlendThumbnail *BLO_thumbnail_from_file(const char *filepath)
 /* Only direct data-blocks. */
 static void *newdataadr(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+  void *newadr = oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+#ifdef USE_MMAP_SHARED_DATA
+  if (newadr == nullptr) {
+    newadr = mmap_data_copy_into_datamap(fd, adr, 1);
+  }
+#endif
+  return newadr;
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+  void *newadr = oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+#ifdef USE_MMAP_SHARED_DATA
+  if (newadr == nullptr) {
+    newadr = mmap_data_copy_into_datamap(fd, adr, 0);
+  }
+#endif
+  return newadr;
 }
 
 void *blo_read_get_new_globaldata_address(FileData *fd, const void *adr)
@@ -1501,7 +1728,7 @@ static void change_link_placeholder_to_real_ID_pointer(ListBase *mainlist,
 static void insert_packedmap(FileData *fd, PackedFile *pf)
 {
   oldnewmap_insert(fd->packedmap, pf, pf, 0);
-  oldnewmap_insert(fd->packedmap, pf->data, pf->data, 0);
+  oldnewmap_insert(fd->packedmap, const_cast<void *>(pf->data), const_cast<void *>(pf->data), 0);
 }
 
 void blo_make_packed_pointer_map(FileData *fd, Main *oldmain)
@@ -2521,9 +2748,120 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_PARALLEL_DATA_DECODE
+
+struct ReadDataDecodeItem {
+  /** The block as listed in the file. */
+  BHead *bhead;
+  /** Block holding the data to decode, may be a temporary copy of `bhead` (read on demand). */
+  BHead *bhead_data;
+  /** Decoded data, inserted into the datamap. */
+  void *data;
+};
+
+/**
+ * Check whether reading the block needs any conversion, blocks which don't are read directly
+ * into their final allocation by #read_struct.
+ */
+static bool read_struct_needs_decode(const FileData *fd, const BHead *bh)
+{
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return true;
+  }
+  return fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL;
+}
+
+/**
+ * Thread-safe part of #read_struct, expects the data of `bh` to be loaded.
+ */
+static void *read_struct_decode(const FileData *fd, BHead *bh, const char *blockname)
+{
+  if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs(fd->filesdna, bh);
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+  void *temp = MEM_mallocN(bh->len, blockname);
+  memcpy(temp, (bh + 1), bh->len);
+  return temp;
+}
+
+/**
+ * Same as #read_data_into_datamap, but the data-blocks are gathered first,
+ * so the conversion of all blocks owned by the ID can run in parallel.
+ */
+static BHead *read_data_into_datamap_parallel(FileData *fd, BHead *bhead, const char *allocname)
+{
+  using namespace blender;
+  Vector<ReadDataDecodeItem> items;
+  Vector<int64_t> decode_indices;
+
+  /* File access is sequential: read the raw data of blocks that need decoding,
+   * other blocks are read directly into their final memory. */
+  for (bhead = blo_bhead_next(fd, bhead); bhead && bhead->code == BLO_CODE_DATA;
+       bhead = blo_bhead_next(fd, bhead))
+  {
+#  ifdef USE_MMAP_SHARED_DATA
+    if (mmap_data_register(fd, bhead, allocname)) {
+      continue;
+    }
+#  endif
+    ReadDataDecodeItem item = {bhead, bhead, nullptr};
+    if (!read_struct_needs_decode(fd, bhead)) {
+      item.data = read_struct(fd, bhead, allocname);
+    }
+    else {
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+      if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+        item.bhead_data = blo_bhead_read_full(fd, bhead);
+        if (UNLIKELY(item.bhead_data == nullptr)) {
+          fd->flags &= ~FD_FLAGS_FILE_OK;
+        }
+      }
+#  endif
+      if (item.bhead_data) {
+        decode_indices.append(items.size());
+      }
+    }
+    items.append(item);
+  }
+
+  threading::parallel_for(decode_indices.index_range(), 64, [&](const IndexRange range) {
+    for (const int64_t i : decode_indices.as_span().slice(range)) {
+      ReadDataDecodeItem &item = items[i];
+      item.data = read_struct_decode(fd, item.bhead_data, allocname);
+    }
+  });
+
+  /* Keep the insertion order of the sequential code path. */
+  for (ReadDataDecodeItem &item : items) {
+    if (item.data) {
+      oldnewmap_insert(fd->datamap, item.bhead->old, item.data, 0);
+    }
+    if (item.bhead_data && item.bhead_data != item.bhead) {
+      MEM_freeN(BHEADN_FROM_BHEAD(item.bhead_data));
+    }
+  }
+
+  return bhead;
+}
+
+#endif /* USE_PARALLEL_DATA_DECODE */
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
+#ifdef USE_PARALLEL_DATA_DECODE
+  /* Undo steps share the DNA of the current session, there is nothing to decode. */
+  if ((fd->flags & FD_FLAGS_IS_MEMFILE) == 0) {
+    return read_data_into_datamap_parallel(fd, bhead, allocname);
+  }
+#endif
+
   bhead = blo_bhead_next(fd, bhead);
 
   while (bhead && bhead->code == BLO_CODE_DATA) {
@@ -2547,6 +2885,13 @@ static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *all
     }
 #endif
 
+#ifdef USE_MMAP_SHARED_DATA
+    if (mmap_data_register(fd, bhead, allocname)) {
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+#endif
+
     void *data = read_struct(fd, bhead, allocname);
     if (data) {
       oldnewmap_insert(fd->datamap, bhead->old, data, 0);
@@ -3022,9 +3367,15 @@ static BHead *read_libblock(FileData *fd,
   /* Read datablock contents.
    * Use convenient malloc name for debugging and better memory link prints. */
   const char *allocname = dataname(idcode);
+  /* Attribute the memory of the data-block to its type, see #MEM_use_memory_tags. */
+  const char *old_tag_scope = MEM_tag_scope_set(BKE_idtype_idcode_to_name(idcode));
   bhead = read_data_into_datamap(fd, bhead, allocname);
   const bool success = direct_link_id(fd, main, id_tag, id, id_old);
+  MEM_tag_scope_set(old_tag_scope);
   oldnewmap_clear(fd->datamap);
+#ifdef USE_MMAP_SHARED_DATA
+  mmap_datamap_clear(fd);
+#endif
 
   if (!success) {
     /* XXX This is probably working OK currently given the very limited scope of that flag.
@@ -3069,6 +3420,9 @@ BHead *blo_read_asset_data_block(FileData *fd, BHead *bhead, AssetMetaData **r_a
   BKE_asset_metadata_read(&reader, *r_asset_data);
 
   oldnewmap_clear(fd->datamap);
+#ifdef USE_MMAP_SHARED_DATA
+  mmap_datamap_clear(fd);
+#endif
 
   return bhead;
 }
@@ -3493,6 +3847,9 @@ static BHead *read_userdef(BlendFileData *bfd, FileData *fd, BHead *bhead)
 
   /* free fd->datamap again */
   oldnewmap_clear(fd->datamap);
+#ifdef USE_MMAP_SHARED_DATA
+  mmap_datamap_clear(fd);
+#endif
 
   return bhead;
 }
@@ -5019,6 +5376,56 @@ bool BLO_read_data_is_undo(BlendDataReader *reader)
   return (reader->fd->flags & FD_FLAGS_IS_MEMFILE);
 }
 
+const blender::ImplicitSharingInfo *BLO_read_shared(
+    BlendDataReader *reader,
+    void **data_ptr,
+    const blender::FunctionRef<const blender::ImplicitSharingInfo *()> read_fn)
+{
+  if (BLO_read_data_is_undo(reader) && *data_ptr != nullptr) {
+    const UndoReader *undo_reader = reinterpret_cast<const UndoReader *>(reader->fd->file);
+    const MemFileSharedStorage *shared_storage = undo_reader->memfile->shared_storage;
+    if (shared_storage != nullptr) {
+      if (const blender::ImplicitSharingInfo *sharing_info = shared_storage->map.lookup_default(
+              *data_ptr, nullptr))
+      {
+        /* The data was not written but shared with the undo step, the pointer is still valid.
+         * The caller becomes an additional owner. */
+        sharing_info->add_user();
+        return sharing_info;
+      }
+    }
+  }
+  return read_fn();
+}
+
+const blender::ImplicitSharingInfo *BLO_read_shared_array(
+    BlendDataReader *reader,
+    void **data_ptr,
+    const int64_t size_in_bytes,
+    const int64_t alignment,
+    const blender::FunctionRef<const blender::ImplicitSharingInfo *()> read_fn)
+{
+#ifdef USE_MMAP_SHARED_DATA
+  FileData *fd = reader->fd;
+  if (fd->mmap_datamap != nullptr && *data_ptr != nullptr) {
+    if (MMapData *data = fd->mmap_datamap->map.lookup_ptr(*data_ptr)) {
+      const char *mapped_data = fd->mmap_sharing->memory + data->file_offset;
+      if (data->size >= size_t(size_in_bytes) && uintptr_t(mapped_data) % alignment == 0) {
+        if (data->sharing_info == nullptr) {
+          data->sharing_info = MEM_new<MMapDataSharing>(__func__, fd->mmap_sharing);
+        }
+        data->sharing_info->add_user();
+        *data_ptr = const_cast<char *>(mapped_data);
+        return data->sharing_info;
+      }
+    }
+  }
+#else
+  UNUSED_VARS(size_in_bytes, alignment);
+#endif
+  return BLO_read_shared(reader, data_ptr, read_fn);
+}
+
 void BLO_read_data_globmap_add(BlendDataReader *reader, void *oldaddr, void *newaddr)
 {
   oldnewmap_insert(reader->fd->globmap, oldaddr, newaddr, 0);
@@ -32,6 +32,8 @@ struct IDNameLib_Map;
 struct Key;
 struct Main;
 struct MemFile;
+struct MMapDataMap;
+struct MMapFileSharing;
 struct Object;
 struct OldNewMap;
 struct ReportList;
@@ -108,6 +110,14 @@ struct FileData {
   OldNewMap *packedmap;
   BLOCacheStorage *cache_storage;
 
+  /**
+   * Owns the mapping when the file is read with memory-mapped IO, large raw data-blocks can
+   * reference it directly instead of being copied. See #USE_MMAP_SHARED_DATA.
+   */
+  MMapFileSharing *mmap_sharing;
+  /** Raw data-blocks of the current ID that haven't been copied from the mapped file yet. */
+  MMapDataMap *mmap_datamap;
+
   BHeadSort *bheadmap;
   int tot_bheadmap;
 
@@ -6,6 +6,8 @@
  * \ingroup blenloader
  */
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -26,6 +28,12 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_implicit_sharing.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.hh"
@@ -37,23 +45,204 @@
 /* keep last */
 #include "BLI_strict_flags.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Content Defined Slices
+ *
+ * Large chunks (typically the arrays of big meshes) are split into slices at boundaries defined
+ * by their content, using a "gear" rolling hash (as in FastCDC). Editing some data then only
+ * changes the slices around the edit, even when it shifts all the data that follows, and the
+ * other slices are shared with the previous undo step.
+ * \{ */
+
+#define MEMFILE_SLICE_SIZE_MIN (size_t(1) << 14)
+#define MEMFILE_SLICE_SIZE_MAX (size_t(1) << 18)
+/**
+ * A boundary is found when these bits of the rolling hash are all zero, giving slices of 64 KiB
+ * on average. The high bits are used since they depend on more of the preceding bytes.
+ */
+#define MEMFILE_SLICE_HASH_MASK (uint64_t(0xffff) << 48)
+
+static const uint64_t *memfile_slice_gear_table()
+{
+  static const std::array<uint64_t, 256> table = []() {
+    /* Any fixed random values work, they only have to be the same for the whole session. */
+    blender::RandomNumberGenerator rng(0);
+    std::array<uint64_t, 256> values;
+    for (uint64_t &value : values) {
+      value = (uint64_t(rng.get_uint32()) << 32) | uint64_t(rng.get_uint32());
+    }
+    return values;
+  }();
+  return table.data();
+}
+
+/** \return The size of the slice starting at `buf`. */
+static size_t memfile_slice_size_next(const char *buf, const size_t size)
+{
+  if (size <= MEMFILE_SLICE_SIZE_MIN) {
+    return size;
+  }
+  const uint64_t *gear_table = memfile_slice_gear_table();
+  const size_t size_max = std::min(size, MEMFILE_SLICE_SIZE_MAX);
+  uint64_t hash = 0;
+  for (size_t i = MEMFILE_SLICE_SIZE_MIN; i < size_max; i++) {
+    hash = (hash << 1) + gear_table[uchar(buf[i])];
+    if ((hash & MEMFILE_SLICE_HASH_MASK) == 0) {
+      return i + 1;
+    }
+  }
+  return size_max;
+}
+
+static void memfile_chunk_slices_set(MemFileChunk *chunk,
+                                     const blender::Span<MemFileChunkSlice *> slices)
+{
+  chunk->slices_num = int(slices.size());
+  chunk->slices = static_cast<MemFileChunkSlice **>(
+      MEM_malloc_arrayN(size_t(slices.size()), sizeof(MemFileChunkSlice *), __func__));
+  std::copy(slices.begin(), slices.end(), chunk->slices);
+}
+
+static blender::Span<MemFileChunkSlice *> memfile_chunk_slices(const MemFileChunk *chunk)
+{
+  return {chunk->slices, chunk->slices_num};
+}
+
+/**
+ * Store the data of `chunk` as slices, sharing the ones which are unchanged compared to the
+ * reference chunk.
+ */
+static void memfile_chunk_slices_add(MemFile *memfile,
+                                     MemFileChunk *chunk,
+                                     const MemFileChunk *compchunk,
+                                     const char *buf)
+{
+  using namespace blender;
+  Map<uint32_t, MemFileChunkSlice *> reference_slices;
+  if (compchunk != nullptr && compchunk->slices != nullptr) {
+    for (MemFileChunkSlice *slice : memfile_chunk_slices(compchunk)) {
+      reference_slices.add(slice->hash, slice);
+    }
+  }
+
+  Vector<MemFileChunkSlice *, 32> slices;
+  size_t offset = 0;
+  while (offset < chunk->size) {
+    const char *slice_buf = buf + offset;
+    const size_t slice_size = memfile_slice_size_next(slice_buf, chunk->size - offset);
+    const uint32_t hash = BLI_hash_mm2(reinterpret_cast<const uchar *>(slice_buf), slice_size, 0);
+
+    MemFileChunkSlice *slice = reference_slices.lookup_default(hash, nullptr);
+    if (slice != nullptr && slice->size == slice_size &&
+        memcmp(slice->buf, slice_buf, slice_size) == 0)
+    {
+      slice->users++;
+    }
+    else {
+      char *buf_new = static_cast<char *>(MEM_mallocN(slice_size, "Chunk slice buffer"));
+      memcpy(buf_new, slice_buf, slice_size);
+      slice = MEM_cnew<MemFileChunkSlice>(__func__);
+      slice->buf = buf_new;
+      slice->size = slice_size;
+      slice->hash = hash;
+      slice->users = 1;
+      memfile->size += slice_size;
+    }
+    slices.append(slice);
+    offset += slice_size;
+  }
+  memfile_chunk_slices_set(chunk, slices);
+}
+
+static void memfile_chunk_slices_free(MemFileChunk *chunk)
+{
+  for (MemFileChunkSlice *slice : memfile_chunk_slices(chunk)) {
+    BLI_assert(slice->users > 0);
+    if (--slice->users == 0) {
+      MEM_freeN((void *)slice->buf);
+      MEM_freeN(slice);
+    }
+  }
+  MEM_freeN(chunk->slices);
+  chunk->slices = nullptr;
+  chunk->slices_num = 0;
+}
+
+static bool memfile_chunk_data_equals(const MemFileChunk *chunk, const char *buf, size_t size)
+{
+  if (chunk->size != size) {
+    return false;
+  }
+  if (chunk->slices == nullptr) {
+    return memcmp(chunk->buf, buf, size) == 0;
+  }
+  for (const MemFileChunkSlice *slice : memfile_chunk_slices(chunk)) {
+    if (memcmp(slice->buf, buf, slice->size) != 0) {
+      return false;
+    }
+    buf += slice->size;
+  }
+  return true;
+}
+
+/** Copy `size` bytes of the chunk data, starting at `offset`. */
+static void memfile_chunk_data_read(const MemFileChunk *chunk,
+                                    size_t offset,
+                                    char *r_buf,
+                                    size_t size)
+{
+  if (chunk->slices == nullptr) {
+    memcpy(r_buf, chunk->buf + offset, size);
+    return;
+  }
+  for (const MemFileChunkSlice *slice : memfile_chunk_slices(chunk)) {
+    if (size == 0) {
+      break;
+    }
+    if (offset >= slice->size) {
+      offset -= slice->size;
+      continue;
+    }
+    const size_t read_size = std::min(size, slice->size - offset);
+    memcpy(r_buf, slice->buf + offset, read_size);
+    r_buf += read_size;
+    size -= read_size;
+    offset = 0;
+  }
+}
+
+/** \} */
+
 /* **************** support for memory-write, for undo buffers *************** */
 
+MemFileSharedStorage::~MemFileSharedStorage()
+{
+  for (const blender::ImplicitSharingInfo *sharing_info : map.values()) {
+    sharing_info->remove_user_and_delete_if_last();
+  }
+}
+
 void BLO_memfile_free(MemFile *memfile)
 {
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (chunk->slices != nullptr) {
+      memfile_chunk_slices_free(chunk);
+    }
+    else if (chunk->is_identical == false) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
   }
+  MEM_delete(memfile->shared_storage);
+  memfile->shared_storage = nullptr;
   memfile->size = 0;
 }
 
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
   /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
-   * by it (i.e. shared with some previous memory steps). */
+   * by it (i.e. shared with some previous memory steps). Sliced chunks are reference counted, so
+   * they don't need any ownership transfer. */
   GHash *buffer_to_second_memchunk = BLI_ghash_new(
       BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
 
@@ -61,7 +250,7 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   for (MemFileChunk *sc = static_cast<MemFileChunk *>(second->chunks.first); sc != nullptr;
        sc = static_cast<MemFileChunk *>(sc->next))
   {
-    if (sc->is_identical) {
+    if (sc->is_identical && sc->slices == nullptr) {
       BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
     }
   }
@@ -71,7 +260,7 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   for (MemFileChunk *fc = static_cast<MemFileChunk *>(first->chunks.first); fc != nullptr;
        fc = static_cast<MemFileChunk *>(fc->next))
   {
-    if (!fc->is_identical) {
+    if (!fc->is_identical && fc->slices == nullptr) {
       MemFileChunk *sc = static_cast<MemFileChunk *>(
           BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf));
       if (sc != nullptr) {
@@ -103,6 +292,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 {
   mem_data->written_memfile = written_memfile;
   mem_data->reference_memfile = reference_memfile;
+  mem_data->written_size = 0;
   mem_data->reference_current_chunk = reference_memfile ? static_cast<MemFileChunk *>(
                                                               reference_memfile->chunks.first) :
                                                           nullptr;
@@ -150,6 +340,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
       MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
   curchunk->size = size;
   curchunk->buf = nullptr;
+  curchunk->slices = nullptr;
+  curchunk->slices_num = 0;
   curchunk->is_identical = false;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
@@ -157,22 +349,35 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->is_identical_future = true;
   curchunk->id_session_uuid = mem_data->current_id_session_uuid;
   BLI_addtail(&memfile->chunks, curchunk);
+  mem_data->written_size += size;
 
   /* we compare compchunk with buf */
-  if (*compchunk_step != nullptr) {
-    MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
+  MemFileChunk *compchunk = *compchunk_step;
+  if (compchunk != nullptr) {
+    if (memfile_chunk_data_equals(compchunk, buf, size)) {
+      if (compchunk->slices != nullptr) {
+        for (MemFileChunkSlice *slice : memfile_chunk_slices(compchunk)) {
+          slice->users++;
+        }
+        memfile_chunk_slices_set(curchunk, memfile_chunk_slices(compchunk));
+      }
+      else {
         curchunk->buf = compchunk->buf;
-        curchunk->is_identical = true;
-        compchunk->is_identical_future = true;
       }
+      curchunk->is_identical = true;
+      compchunk->is_identical_future = true;
     }
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
   /* not equal... */
-  if (curchunk->buf == nullptr) {
+  if (curchunk->is_identical) {
+    /* pass */
+  }
+  else if (size >= MEMFILE_SLICE_CHUNK_SIZE_MIN) {
+    memfile_chunk_slices_add(memfile, curchunk, compchunk, buf);
+  }
+  else {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
     memcpy(buf_new, buf, size);
     curchunk->buf = buf_new;
@@ -199,6 +404,28 @@ Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
   return bmain_undo;
 }
 
+static bool memfile_write_buf(const int file, const char *buf, const size_t size)
+{
+#ifdef _WIN32
+  return size_t(write(file, buf, uint(size))) == size;
+#else
+  return size_t(write(file, buf, size)) == size;
+#endif
+}
+
+static bool memfile_write_data(const int file, const MemFileChunk *chunk)
+{
+  if (chunk->slices == nullptr) {
+    return memfile_write_buf(file, chunk->buf, chunk->size);
+  }
+  for (const MemFileChunkSlice *slice : memfile_chunk_slices(chunk)) {
+    if (!memfile_write_buf(file, slice->buf, slice->size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool BLO_memfile_write_file(MemFile *memfile, const char *filepath)
 {
   MemFileChunk *chunk;
@@ -229,18 +456,37 @@ bool BLO_memfile_write_file(MemFile *memfile, const char *filepath)
     return false;
   }
 
+  /* Data shared with the undo step is written where it would have been in the chunks. */
+  const blender::Span<MemFileSharedStorage::Block> shared_blocks =
+      memfile->shared_storage ? memfile->shared_storage->blocks.as_span() :
+                                blender::Span<MemFileSharedStorage::Block>();
+  int64_t shared_block_index = 0;
+  size_t offset = 0;
+  bool ok = true;
+
   for (chunk = static_cast<MemFileChunk *>(memfile->chunks.first); chunk;
        chunk = static_cast<MemFileChunk *>(chunk->next))
   {
-#ifdef _WIN32
-    if (size_t(write(file, chunk->buf, uint(chunk->size))) != chunk->size)
-#else
-    if (size_t(write(file, chunk->buf, chunk->size)) != chunk->size)
-#endif
+    for (; shared_block_index < shared_blocks.size() &&
+           shared_blocks[shared_block_index].offset <= offset;
+         shared_block_index++)
     {
+      const MemFileSharedStorage::Block &block = shared_blocks[shared_block_index];
+      BLI_assert(block.offset == offset);
+      if (!memfile_write_buf(file, reinterpret_cast<const char *>(&block.bhead), sizeof(BHead)) ||
+          !memfile_write_buf(file, static_cast<const char *>(block.data), size_t(block.bhead.len)))
+      {
+        ok = false;
+        break;
+      }
+    }
+    if (!ok || !memfile_write_data(file, chunk)) {
       break;
     }
+    offset += chunk->size;
   }
+  /* The file always ends with a chunk (the `ENDB` block). */
+  BLI_assert(chunk != nullptr || shared_block_index == shared_blocks.size());
 
   close(file);
 
@@ -310,7 +556,8 @@ static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
         readsize = chunk->size - chunkoffset;
       }
 
-      memcpy(POINTER_OFFSET(buffer, totread), chunk->buf + chunkoffset, readsize);
+      memfile_chunk_data_read(
+          chunk, chunkoffset, static_cast<char *>(POINTER_OFFSET(buffer, totread)), readsize);
       totread += readsize;
       undo->reader.offset += (off64_t)readsize;
       seek += readsize;
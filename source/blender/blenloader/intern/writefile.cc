@@ -91,6 +91,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_link_utils.h"
 #include "BLI_linklist.h"
 #include "BLI_math_base.h"
@@ -427,6 +428,11 @@ struct WriteData {
   MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
+  /**
+   * Set while writing data shared with the undo step (see #BLO_write_shared). Its data-blocks are
+   * only remembered in the storage instead of being written to the chunks.
+   */
+  MemFileSharedStorage *shared_storage_write;
 
   /**
    * Wrap writing, so we can use zstd or
@@ -547,6 +553,13 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
         wd->buffer.used_len = 0;
       }
 
+      /* The memfile splits large chunks into slices at content-defined boundaries, which can be
+       * shared with the previous undo step even when the edit shifted the following data. */
+      if (wd->use_memfile && len >= MEMFILE_SLICE_CHUNK_SIZE_MIN && len <= INT_MAX) {
+        writedata_do_write(wd, adr, len);
+        return;
+      }
+
       do {
         size_t writelen = MIN2(len, wd->buffer.chunk_size);
         writedata_do_write(wd, adr, writelen);
@@ -690,6 +703,13 @@ static void writestruct_at_address_nr(
     return;
   }
 
+  if (wd->shared_storage_write) {
+    /* Only the shared data itself is kept alive by the storage, not temporary copies. */
+    BLI_assert(adr == data);
+    wd->shared_storage_write->blocks.append({wd->mem.written_size, bh, data});
+    return;
+  }
+
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, data, size_t(bh.len));
 }
@@ -724,6 +744,11 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = 0;
   bh.len = int(len);
 
+  if (wd->shared_storage_write) {
+    wd->shared_storage_write->blocks.append({wd->mem.written_size, bh, adr});
+    return;
+  }
+
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, adr, len);
 }
@@ -1796,4 +1821,36 @@ bool BLO_write_is_undo(BlendWriter *writer)
   return writer->wd->use_memfile;
 }
 
+void BLO_write_shared(BlendWriter *writer,
+                      const void *data,
+                      const size_t approximate_size_in_bytes,
+                      const blender::ImplicitSharingInfo *sharing_info,
+                      const blender::FunctionRef<void()> write_fn)
+{
+  if (data == nullptr) {
+    return;
+  }
+  if (BLO_write_is_undo(writer) && sharing_info != nullptr) {
+    MemFile &memfile = *writer->wd->mem.written_memfile;
+    if (memfile.shared_storage == nullptr) {
+      memfile.shared_storage = MEM_new<MemFileSharedStorage>(__func__);
+    }
+    if (memfile.shared_storage->map.add(data, sharing_info)) {
+      /* The undo step becomes an owner of the data, which also makes it immutable. */
+      sharing_info->add_user();
+      /* Only an estimate, data shared by many owners is counted less. */
+      memfile.size += approximate_size_in_bytes / size_t(sharing_info->strong_users());
+    }
+    /* Remember the data-blocks that would be written, so that the memfile can still be saved as
+     * a regular file. They start a new chunk to have a well defined position. */
+    WriteData *wd = writer->wd;
+    mywrite_flush(wd);
+    wd->shared_storage_write = memfile.shared_storage;
+    write_fn();
+    wd->shared_storage_write = nullptr;
+    return;
+  }
+  write_fn();
+}
+
 /** \} */
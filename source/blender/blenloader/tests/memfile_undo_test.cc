@@ -0,0 +1,136 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "blendfile_loading_base_test.h"
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_path_util.h"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "BKE_appdir.h"
+#include "BKE_customdata.h"
+#include "BKE_main.h"
+#include "BKE_mesh.hh"
+#include "BKE_undo_system.h"
+
+#include "BLO_readfile.h"
+#include "BLO_undofile.hh"
+#include "BLO_writefile.hh"
+
+namespace blender::blenloader::tests {
+
+static Vector<char> random_data(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Vector<char> data(size);
+  for (char &value : data) {
+    value = char(rng.get_uint32());
+  }
+  return data;
+}
+
+/** Store the data in the memfile, like writing an undo step with a single large array. */
+static void memfile_write(MemFile &memfile, MemFile *reference, const Span<char> data)
+{
+  MemFileWriteData mem_data = {};
+  BLO_memfile_write_init(&mem_data, &memfile, reference);
+  BLO_memfile_chunk_add(&mem_data, data.data(), size_t(data.size()));
+  BLO_memfile_write_finalize(&mem_data);
+}
+
+static Vector<char> memfile_read(MemFile &memfile)
+{
+  int64_t size = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile.chunks) {
+    size += int64_t(chunk->size);
+  }
+  Vector<char> data(size);
+  FileReader *reader = BLO_memfile_new_filereader(&memfile, STEP_REDO);
+  EXPECT_EQ(reader->read(reader, data.data(), size_t(size)), size);
+  reader->close(reader);
+  return data;
+}
+
+TEST(memfile_undo, LargeChunkPartialEdit)
+{
+  const int64_t size = int64_t(4) << 20;
+  Vector<char> data = random_data(size, 0);
+
+  MemFile memfile_a = {};
+  memfile_write(memfile_a, nullptr, data);
+  EXPECT_EQ(memfile_a.size, size_t(size));
+
+  /* Change a few bytes in the middle, most of the data is shared with the previous step. */
+  for (const int64_t i : IndexRange(size / 2, 100)) {
+    data[i] = char(~data[i]);
+  }
+  MemFile memfile_b = {};
+  memfile_write(memfile_b, &memfile_a, data);
+  EXPECT_GT(memfile_b.size, size_t(0));
+  EXPECT_LE(memfile_b.size, 2 * MEMFILE_SLICE_CHUNK_SIZE_MIN);
+  EXPECT_EQ(memfile_read(memfile_b).as_span(), data.as_span());
+  const Vector<char> data_b = data;
+
+  /* Inserting data shifts everything that follows, which is still shared. */
+  const Vector<char> inserted = random_data(16, 1);
+  data.insert(size / 4, inserted.as_span());
+  MemFile memfile_c = {};
+  memfile_write(memfile_c, &memfile_b, data);
+  EXPECT_LE(memfile_c.size, 2 * MEMFILE_SLICE_CHUNK_SIZE_MIN);
+  EXPECT_EQ(memfile_read(memfile_c).as_span(), data.as_span());
+
+  /* Removing a step keeps the slices used by the later steps alive. */
+  BLO_memfile_merge(&memfile_a, &memfile_b);
+  EXPECT_EQ(memfile_read(memfile_b).as_span(), data_b.as_span());
+  BLO_memfile_free(&memfile_b);
+  EXPECT_EQ(memfile_read(memfile_c).as_span(), data.as_span());
+  BLO_memfile_free(&memfile_c);
+}
+
+class MemfileUndoWriteTest : public BlendfileLoadingBaseTest {
+};
+
+TEST_F(MemfileUndoWriteTest, WriteFileWithSharedData)
+{
+  BKE_tempdir_init("");
+
+  Main *bmain = BKE_main_new();
+  Mesh *mesh = BKE_mesh_add(bmain, "Mesh");
+  const int verts_num = 1000;
+  mesh->totvert = verts_num;
+  CustomData_add_layer_named(
+      &mesh->vert_data, CD_PROP_FLOAT3, CD_CONSTRUCT, verts_num, "position");
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(float(i), float(i) * 0.5f, -float(i));
+  }
+
+  /* The positions are not copied into the undo step, but shared with it. */
+  MemFile memfile = {};
+  ASSERT_TRUE(BLO_write_file_mem(bmain, nullptr, &memfile, 0));
+  ASSERT_NE(memfile.shared_storage, nullptr);
+  EXPECT_TRUE(memfile.shared_storage->map.contains(positions.data()));
+
+  /* Saving the undo step (as done for auto-save and crash files) includes the shared data. */
+  const std::string filepath = std::string(BKE_tempdir_session()) + SEP_STR +
+                               "memfile_undo_shared.blend";
+  ASSERT_TRUE(BLO_memfile_write_file(&memfile, filepath.c_str()));
+
+  BlendFileReadReport reports = {nullptr};
+  BlendFileData *bfd = BLO_read_from_file(filepath.c_str(), BLO_READ_SKIP_NONE, &reports);
+  ASSERT_NE(bfd, nullptr);
+  const Mesh *mesh_read = static_cast<const Mesh *>(bfd->main->meshes.first);
+  ASSERT_NE(mesh_read, nullptr);
+  ASSERT_EQ(mesh_read->totvert, verts_num);
+  EXPECT_EQ(mesh_read->vert_positions(), positions.as_span());
+
+  BLO_blendfiledata_free(bfd);
+  BLO_memfile_free(&memfile);
+  BKE_main_free(bmain);
+}
+
+}  // namespace blender::blenloader::tests
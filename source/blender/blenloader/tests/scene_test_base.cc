@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "scene_test_base.h"
+
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_collection.h"
+#include "BKE_layer.h"
+#include "BKE_main.h"
+#include "BKE_mesh.hh"
+#include "BKE_object.h"
+#include "BKE_scene.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+void SceneTestBase::SetUp()
+{
+  BlendfileLoadingBaseTest::SetUp();
+  bmain = BKE_main_new();
+  scene = BKE_scene_add(bmain, "Scene");
+  view_layer = BKE_view_layer_default_view(scene);
+}
+
+void SceneTestBase::TearDown()
+{
+  /* The depsgraph references the main database. */
+  BlendfileLoadingBaseTest::TearDown();
+  BKE_main_free(bmain);
+  bmain = nullptr;
+}
+
+Object *SceneTestBase::add_object(const short type, const char *name)
+{
+  Object *object = BKE_object_add_only_object(bmain, type, name);
+  if (type == OB_MESH) {
+    object->data = BKE_mesh_add(bmain, name);
+  }
+  BKE_collection_object_add(bmain, scene->master_collection, object);
+  BKE_main_collection_sync(bmain);
+  return object;
+}
+
+Depsgraph *SceneTestBase::scene_depsgraph_build()
+{
+  Depsgraph *graph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+  DEG_graph_build_from_view_layer(graph);
+  return graph;
+}
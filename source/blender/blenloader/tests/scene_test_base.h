@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "blendfile_loading_base_test.h"
+
+struct Main;
+struct Object;
+struct Scene;
+struct ViewLayer;
+
+/* Base for tests which build a scene in code instead of loading a blend file. */
+class SceneTestBase : public BlendfileLoadingBaseTest {
+ protected:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  ViewLayer *view_layer = nullptr;
+
+  /* Creates an empty main database with a scene. */
+  void SetUp() override;
+  /* Frees the depsgraph and then the main database. */
+  void TearDown() override;
+
+  /* Add an object of the given type to the scene, meshes get new empty mesh data. */
+  Object *add_object(short type, const char *name);
+  /* Create a depsgraph of the scene and build its relations, without evaluating it. */
+  Depsgraph *scene_depsgraph_build();
+};
@@ -41,19 +41,19 @@ char *BM_mesh_debug_info(BMesh *bm)
   BLI_dynstr_appendf(dynstr, "    'totface': %d,\n", bm->totface);
 
   BLI_dynstr_append(dynstr, "    'vert_layers': (\n");
-  CustomData_debug_info_from_layers(&bm->vdata, indent8, dynstr);
+  CustomData_debug_info_from_layers(&bm->vdata, bm->totvert, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'edge_layers': (\n");
-  CustomData_debug_info_from_layers(&bm->edata, indent8, dynstr);
+  CustomData_debug_info_from_layers(&bm->edata, bm->totedge, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'loop_layers': (\n");
-  CustomData_debug_info_from_layers(&bm->ldata, indent8, dynstr);
+  CustomData_debug_info_from_layers(&bm->ldata, bm->totloop, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "    'poly_layers': (\n");
-  CustomData_debug_info_from_layers(&bm->pdata, indent8, dynstr);
+  CustomData_debug_info_from_layers(&bm->pdata, bm->totface, indent8, dynstr);
   BLI_dynstr_append(dynstr, "    ),\n");
 
   BLI_dynstr_append(dynstr, "}\n");
@@ -70,6 +70,19 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(struct Main *bmain);
 
+/**
+ * Tag relations of the given ID for update in the given graph.
+ *
+ * Unlike #DEG_graph_tag_relations_update this allows the graph to update the relations of the ID
+ * in place. It is only to be used for changes which do not affect how other IDs depend on this
+ * one, like adding a constraint or a modifier to an object. The graph is fully rebuilt when it can
+ * not be updated in place.
+ */
+void DEG_graph_id_tag_relations_update(struct Depsgraph *graph, struct ID *id);
+
+/** Tag relations of the given ID for update in all graphs. */
+void DEG_id_relations_tag_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
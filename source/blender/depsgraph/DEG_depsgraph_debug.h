@@ -53,6 +53,21 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Tracing */
+
+/**
+ * Start recording the evaluation of all dependency graphs into a file in the Chrome trace event
+ * format, which can be opened with `chrome://tracing` or Perfetto. Every evaluated operation is
+ * recorded with its timing, thread and owner.
+ *
+ * \return false when the file can not be created, or a trace is already being recorded.
+ */
+bool DEG_debug_trace_begin(const char *filepath);
+/** Stop recording and close the trace file. */
+void DEG_debug_trace_end(void);
+bool DEG_debug_trace_is_active(void);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -11,12 +11,14 @@
 #include <cstring>
 
 #include "DNA_ID.h"
+#include "DNA_action_types.h"
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_layer_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_listbase.h"
 #include "BLI_stack.h"
 #include "BLI_utildefines.h"
 
@@ -148,6 +150,25 @@ bool DepsgraphBuilder::check_pchan_has_bbone_segments(const Object *object, cons
   return check_pchan_has_bbone_segments(object, pchan);
 }
 
+bool DepsgraphBuilder::check_pose_can_eval_batched(const Object *object)
+{
+  BLI_assert(object->type == OB_ARMATURE);
+  if (object->pose == nullptr) {
+    return false;
+  }
+  LISTBASE_FOREACH (const bPoseChannel *, pchan, &object->pose->chanbase) {
+    if (pchan->constraints.first != nullptr) {
+      return false;
+    }
+  }
+  /* Drivers of the object may read bones of the pose, and writing to other bones of the same
+   * pose would form a cycle with the single operation. */
+  if (object->adt != nullptr && !BLI_listbase_is_empty(&object->adt->drivers)) {
+    return false;
+  }
+  return true;
+}
+
 const char *DepsgraphBuilder::get_rna_path_relative_to_scene_camera(const Scene *scene,
                                                                     const PointerRNA &target_prop,
                                                                     const char *rna_path)
@@ -35,6 +35,13 @@ class DepsgraphBuilder {
   virtual bool check_pchan_has_bbone_segments(const Object *object, const bPoseChannel *pchan);
   virtual bool check_pchan_has_bbone_segments(const Object *object, const char *bone_name);
 
+  /**
+   * Whether all bones of the pose can be evaluated by a single operation. This is the case when
+   * no bone has constraints and no driver of the object writes to the pose, so that the bones
+   * only depend on their parents.
+   */
+  virtual bool check_pose_can_eval_batched(const Object *object);
+
   /**
    * If `target_prop` + `rna_path` uses indirection via the `scene.camera` pointer, returns
    * the sub-string of `rna_path` relative to the camera; otherwise returns nullptr.
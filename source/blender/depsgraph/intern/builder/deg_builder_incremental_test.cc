@@ -0,0 +1,130 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include <set>
+#include <string>
+
+#include "tests/scene_test_base.h"
+
+#include "BLI_listbase.h"
+
+#include "DNA_modifier_types.h"
+#include "DNA_object_force_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_effect.h"
+#include "BKE_modifier.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "intern/builder/pipeline_view_layer.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender::deg::tests {
+
+static std::string node_identifier(const Node *node)
+{
+  if (node->type == NodeType::OPERATION) {
+    return static_cast<const OperationNode *>(node)->full_identifier();
+  }
+  return node->identifier();
+}
+
+/* All operations and relations of the graph, in a form which does not depend on the order in
+ * which they were built. */
+static std::set<std::string> graph_relations(::Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  std::set<std::string> result;
+  for (const OperationNode *op_node : deg_graph->operations) {
+    result.insert(node_identifier(op_node));
+    for (const Relation *rel : op_node->inlinks) {
+      result.insert(node_identifier(rel->from) + " -> " + node_identifier(rel->to) + " (" +
+                    rel->name + ")");
+    }
+  }
+  return result;
+}
+
+class DepsgraphIncrementalBuildTest : public SceneTestBase {
+ protected:
+  /* Update the relations of the object, and return whether that was done in place. */
+  bool update_relations(Object *object)
+  {
+    DEG_graph_id_tag_relations_update(depsgraph, &object->id);
+    deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+    ViewLayerBuilderPipeline builder(depsgraph);
+    const bool updated_in_place = builder.build_incremental(deg_graph->ids_need_update_relations);
+    /* Rebuilds the whole graph when the object can not be updated in place. */
+    DEG_graph_relations_update(depsgraph);
+    EXPECT_FALSE(deg_graph->need_update_relations);
+    return updated_in_place;
+  }
+
+  /* Compare the relations of the updated graph with a graph built from scratch. */
+  void expect_relations_match_full_build()
+  {
+    ::Depsgraph *full_graph = scene_depsgraph_build();
+    EXPECT_EQ(graph_relations(depsgraph), graph_relations(full_graph));
+    DEG_graph_free(full_graph);
+  }
+};
+
+TEST_F(DepsgraphIncrementalBuildTest, ObjectEdit)
+{
+  Object *parent = add_object(OB_EMPTY, "Parent");
+  Object *child = add_object(OB_EMPTY, "Child");
+  depsgraph = scene_depsgraph_build();
+  const std::set<std::string> relations_before = graph_relations(depsgraph);
+
+  child->parent = parent;
+  EXPECT_TRUE(update_relations(child));
+  EXPECT_NE(graph_relations(depsgraph), relations_before);
+  expect_relations_match_full_build();
+
+  /* Removing the relation again. */
+  child->parent = nullptr;
+  EXPECT_TRUE(update_relations(child));
+  EXPECT_EQ(graph_relations(depsgraph), relations_before);
+  expect_relations_match_full_build();
+}
+
+TEST_F(DepsgraphIncrementalBuildTest, ModifierAdd)
+{
+  Object *object = add_object(OB_MESH, "Mesh");
+  Object *offset = add_object(OB_EMPTY, "Offset");
+  depsgraph = scene_depsgraph_build();
+
+  ArrayModifierData *amd = reinterpret_cast<ArrayModifierData *>(
+      BKE_modifier_new(eModifierType_Array));
+  amd->offset_type |= MOD_ARR_OFF_OBJ;
+  amd->offset_ob = offset;
+  BLI_addtail(&object->modifiers, amd);
+
+  EXPECT_TRUE(update_relations(object));
+  expect_relations_match_full_build();
+}
+
+TEST_F(DepsgraphIncrementalBuildTest, ForceFieldFallback)
+{
+  Object *field = add_object(OB_EMPTY, "Field");
+  Object *object = add_object(OB_EMPTY, "Object");
+  depsgraph = scene_depsgraph_build();
+
+  /* Relations of other objects depend on force fields, so the whole graph is rebuilt. */
+  field->pd = BKE_partdeflect_new(PFIELD_FORCE);
+  object->parent = field;
+  EXPECT_FALSE(update_relations(field));
+  expect_relations_match_full_build();
+}
+
+}  // namespace blender::deg::tests
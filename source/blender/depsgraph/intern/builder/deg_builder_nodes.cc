@@ -151,6 +151,13 @@ IDNode *DepsgraphNodeBuilder::add_id_node(ID *id)
 {
   BLI_assert(id->session_uuid != MAIN_ID_SESSION_UUID_UNSET);
 
+  if (is_incremental_build_) {
+    /* Keep the state of the nodes which are updated in place. */
+    if (IDNode *id_node = find_id_node(id)) {
+      return id_node;
+    }
+  }
+
   const ID_Type id_type = GS(id->name);
   IDNode *id_node = nullptr;
   ID *id_cow = nullptr;
@@ -252,6 +259,10 @@ OperationNode *DepsgraphNodeBuilder::add_operation_node(ComponentNode *comp_node
     op_node = comp_node->add_operation(op, opcode, name, name_tag);
     graph_->operations.append(op_node);
   }
+  else if (stale_operations_.remove(op_node)) {
+    /* Operation is re-used by an incremental build, the callback might have changed. */
+    op_node->evaluate = op;
+  }
   else {
     fprintf(stderr,
             "add_operation: Operation already exists - %s has %s at %p\n",
@@ -295,6 +306,9 @@ OperationNode *DepsgraphNodeBuilder::ensure_operation_node(ID *id,
 {
   OperationNode *operation = find_operation_node(id, comp_type, comp_name, opcode, name, name_tag);
   if (operation != nullptr) {
+    if (stale_operations_.remove(operation)) {
+      operation->evaluate = op;
+    }
     return operation;
   }
   return add_operation_node(id, comp_type, comp_name, opcode, op, name, name_tag);
@@ -309,6 +323,9 @@ OperationNode *DepsgraphNodeBuilder::ensure_operation_node(ID *id,
 {
   OperationNode *operation = find_operation_node(id, comp_type, opcode, name, name_tag);
   if (operation != nullptr) {
+    if (stale_operations_.remove(operation)) {
+      operation->evaluate = op;
+    }
     return operation;
   }
   return add_operation_node(id, comp_type, opcode, op, name, name_tag);
@@ -544,6 +561,102 @@ void DepsgraphNodeBuilder::end_build()
   update_invalid_cow_pointers();
 }
 
+void DepsgraphNodeBuilder::begin_incremental_build(Span<Object *> objects)
+{
+  is_incremental_build_ = true;
+  incremental_id_nodes_num_ = graph_->id_nodes.size();
+
+  scene_ = graph_->scene;
+  view_layer_ = graph_->view_layer;
+  /* See build_view_layer(). */
+  view_layer_index_ = 0;
+
+  Set<const ID *> updated_ids;
+  for (const Object *object : objects) {
+    updated_ids.add(&object->id);
+  }
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (!updated_ids.contains(id_node->id_orig)) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  for (Object *object : objects) {
+    IDNode *id_node = find_id_node(&object->id);
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      comp_node->reopen_build();
+      /* These components are only created together with the ID node. */
+      if (ELEM(comp_node->type, NodeType::COPY_ON_WRITE, NodeType::VISIBILITY)) {
+        continue;
+      }
+      comp_node->entry_operation = nullptr;
+      comp_node->exit_operation = nullptr;
+      for (OperationNode *op_node : comp_node->operations_map->values()) {
+        /* Flags which are set by the builder from the current state of the object. */
+        op_node->flag &= ~DEPSOP_FLAG_MUTE;
+        stale_operations_.add(op_node);
+      }
+      incremental_components_.append({comp_node, comp_node->operations_map->size()});
+    }
+  }
+}
+
+void DepsgraphNodeBuilder::build_object_incremental(Object *object)
+{
+  const IDNode *id_node = find_id_node(&object->id);
+  /* Find the base index the same way as build_view_layer() does. */
+  int base_index = -1;
+  if (id_node->has_base) {
+    int index = 0;
+    BKE_view_layer_synced_ensure(scene_, view_layer_);
+    LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer_)) {
+      if (!need_pull_base_into_graph(base)) {
+        continue;
+      }
+      if (base->object == object) {
+        base_index = index;
+        break;
+      }
+      index++;
+    }
+  }
+  build_object(base_index, object, id_node->linked_state, id_node->is_visible_on_build);
+}
+
+bool DepsgraphNodeBuilder::end_incremental_build()
+{
+  if (graph_->id_nodes.size() != incremental_id_nodes_num_) {
+    /* New IDs were pulled into the graph, they need the full build. */
+    return false;
+  }
+  /* Operations which are not needed anymore can only be removed when no other ID depends on them,
+   * the relations of the updated objects themselves are already removed at this point. */
+  for (OperationNode *op_node : stale_operations_) {
+    if (!op_node->inlinks.is_empty() || !op_node->outlinks.is_empty()) {
+      return false;
+    }
+  }
+  for (OperationNode *op_node : stale_operations_) {
+    op_node->owner->operations_map->remove(
+        ComponentNode::OperationIDKey(op_node->opcode, op_node->name.c_str(), op_node->name_tag));
+    graph_->operations.remove_first_occurrence_and_reorder(op_node);
+    graph_->entry_tags.remove(op_node);
+    delete op_node;
+  }
+  stale_operations_.clear();
+  /* Relations of other IDs to a component are routed to its entry and exit operations. Those can
+   * only change safely if they are set explicitly. */
+  for (const pair<ComponentNode *, int64_t> &item : incremental_components_) {
+    const ComponentNode *comp_node = item.first;
+    if (comp_node->operations_map->size() != item.second &&
+        (comp_node->entry_operation == nullptr || comp_node->exit_operation == nullptr))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 void DepsgraphNodeBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -87,6 +87,16 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Update nodes of the given objects in the existing graph instead of building it from scratch.
+   * All the other IDs which are in the graph are considered built. Existing operations of the
+   * objects are re-used, so that relations of other IDs to them stay valid.
+   * See #AbstractBuilderPipeline::build_incremental(). */
+  virtual void begin_incremental_build(Span<Object *> objects);
+  virtual void build_object_incremental(Object *object);
+  /* Returns false if the nodes could not be updated in place, in which case the graph is to be
+   * fully rebuilt. */
+  virtual bool end_incremental_build();
+
   /**
    * `id_cow_self` is the user of `id_pointer`,
    * see also `LibraryIDLinkCallbackData` struct definition.
@@ -325,6 +335,14 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   /* Set of IDs which were already build. Makes it easier to keep track of
    * what was already built and what was not. */
   BuilderMap built_map_;
+
+  /* State of the incremental build. */
+  bool is_incremental_build_ = false;
+  int64_t incremental_id_nodes_num_ = 0;
+  /* Components of the updated objects, with their number of operations before the update. */
+  Vector<pair<ComponentNode *, int64_t>> incremental_components_;
+  /* Operations of the updated objects which were not added again by the builder (yet). */
+  Set<OperationNode *> stale_operations_;
 };
 
 }  // namespace blender::deg
@@ -26,7 +26,7 @@
 #include "DNA_scene_types.h"
 
 #include "BKE_action.h"
-#include "BKE_armature.h"
+#include "BKE_armature.hh"
 #include "BKE_constraint.h"
 #include "BKE_lib_query.h"
 
@@ -207,6 +207,19 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
       OperationCode::POSE_DONE,
       [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
   op_node->set_as_exit();
+  /* Without constraints bones only depend on their parents. Evaluating all of them from a single
+   * operation avoids the scheduling overhead of several operations per bone, which dominates for
+   * rigs with many simple bones. */
+  const bool eval_bones_batched = check_pose_can_eval_batched(object);
+  if (eval_bones_batched) {
+    add_operation_node(&object->id,
+                       NodeType::EVAL_POSE,
+                       OperationCode::POSE_EVAL_BONES,
+                       [scene_cow, object_cow, batch = bke::pose_eval_batch_build(*object->pose)](
+                           ::Depsgraph *depsgraph) {
+                         bke::pose_eval_bones_batched(depsgraph, scene_cow, object_cow, batch);
+                       });
+  }
   /* Bones. */
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
@@ -215,24 +228,37 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
     op_node->set_as_entry();
 
-    add_operation_node(&object->id,
-                       NodeType::BONE,
-                       pchan->name,
-                       OperationCode::BONE_POSE_PARENT,
-                       [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
-                         BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
-                       });
+    if (eval_bones_batched) {
+      /* Evaluated by the pose, the noops are kept so that relations to the bone still work. */
+      add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_POSE_PARENT);
+    }
+    else {
+      add_operation_node(&object->id,
+                         NodeType::BONE,
+                         pchan->name,
+                         OperationCode::BONE_POSE_PARENT,
+                         [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
+                           BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
+                         });
+    }
 
     /* NOTE: Dedicated noop for easier relationship construction. */
     add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
 
-    op_node = add_operation_node(&object->id,
-                                 NodeType::BONE,
-                                 pchan->name,
-                                 OperationCode::BONE_DONE,
-                                 [object_cow, pchan_index](::Depsgraph *depsgraph) {
-                                   BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
-                                 });
+    if (eval_bones_batched) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    }
+    else {
+      op_node = add_operation_node(&object->id,
+                                   NodeType::BONE,
+                                   pchan->name,
+                                   OperationCode::BONE_DONE,
+                                   [object_cow, pchan_index](::Depsgraph *depsgraph) {
+                                     BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                                   });
+    }
 
     /* B-Bone shape computation - the real last step if present. */
     if (check_pchan_has_bbone(object, pchan)) {
@@ -359,7 +359,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return add_graph_relation(timesrc, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -387,7 +387,7 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return add_graph_relation(node_from, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -402,6 +402,47 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
   return nullptr;
 }
 
+Relation *DepsgraphRelationBuilder::add_graph_relation(Node *node_from,
+                                                       Node *node_to,
+                                                       const char *description,
+                                                       int flags)
+{
+  const int64_t num_outlinks = node_from->outlinks.size();
+  Relation *relation = graph_->add_new_relation(node_from, node_to, description, flags);
+  const ID *owner_id = stack_.current_id();
+  if (node_from->outlinks.size() == num_outlinks) {
+    /* Existing relation was found. */
+    if (relation->owner_id != owner_id) {
+      relation->flag |= RELATION_FLAG_SHARED_OWNER;
+    }
+    return relation;
+  }
+  relation->owner_id = owner_id;
+
+  if (is_incremental_build_) {
+    for (Node *node : {node_from, node_to}) {
+      if (node->type == NodeType::OPERATION) {
+        incremental_affected_id_nodes_.add(static_cast<OperationNode *>(node)->owner->owner);
+      }
+    }
+    /* Relations to no-op operations without outgoing relations are removed when the graph is
+     * finalized (see #deg_graph_remove_unused_noops). They are not re-created for IDs which are
+     * not rebuilt, so such operations can not get outgoing relations now. */
+    if (num_outlinks == 0 && node_from->type == NodeType::OPERATION &&
+        !incremental_relation_sources_.contains(node_from))
+    {
+      const OperationNode *operation_from = static_cast<const OperationNode *>(node_from);
+      if (operation_from->is_noop() && (operation_from->flag & DEPSOP_FLAG_PINNED) == 0 &&
+          !incremental_ids_.contains(operation_from->owner->owner->id_orig))
+      {
+        is_incremental_build_failed_ = true;
+      }
+    }
+  }
+
+  return relation;
+}
+
 void DepsgraphRelationBuilder::add_particle_collision_relations(const OperationKey &key,
                                                                 Object *object,
                                                                 Collection *collection,
@@ -501,6 +542,69 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+bool DepsgraphRelationBuilder::begin_incremental_build(Span<Object *> objects)
+{
+  is_incremental_build_ = true;
+  scene_ = graph_->scene;
+
+  for (const Object *object : objects) {
+    incremental_ids_.add(&object->id);
+  }
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (!incremental_ids_.contains(id_node->id_orig)) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  /* Remove relations which were added by the builders of the updated objects. */
+  Vector<Relation *> relations_to_remove;
+  auto gather_relations = [&](const Node *node) {
+    for (Relation *relation : node->outlinks) {
+      if (relation->owner_id != nullptr && incremental_ids_.contains(relation->owner_id)) {
+        relations_to_remove.append(relation);
+      }
+    }
+  };
+  gather_relations(graph_->time_source);
+  for (const OperationNode *op_node : graph_->operations) {
+    gather_relations(op_node);
+  }
+  for (const Relation *relation : relations_to_remove) {
+    if (relation->flag & RELATION_FLAG_SHARED_OWNER) {
+      return false;
+    }
+  }
+  for (Relation *relation : relations_to_remove) {
+    for (Node *node : {relation->from, relation->to}) {
+      if (node->type == NodeType::OPERATION) {
+        incremental_affected_id_nodes_.add(static_cast<OperationNode *>(node)->owner->owner);
+      }
+    }
+    incremental_relation_sources_.add(relation->from);
+    relation->unlink();
+    delete relation;
+  }
+  return true;
+}
+
+bool DepsgraphRelationBuilder::end_incremental_build()
+{
+  /* Operations of the affected IDs might have been added or might have lost their dependency on
+   * the copy-on-write operation. Relations which already exist are not added again. */
+  const Vector<IDNode *> affected_id_nodes(incremental_affected_id_nodes_.begin(),
+                                           incremental_affected_id_nodes_.end());
+  for (IDNode *id_node : affected_id_nodes) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      comp_node->reopen_build();
+    }
+    build_copy_on_write_relations(id_node);
+  }
+  for (const ID *id : incremental_ids_) {
+    build_driver_relations(graph_->find_id_node(id));
+  }
+  return !is_incremental_build_failed_;
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -958,6 +1062,7 @@ void DepsgraphRelationBuilder::build_object_data(Object *object)
   ID *obdata_id = (ID *)object->data;
   /* Object data animation. */
   if (!built_map_.checkIsBuilt(obdata_id)) {
+    const BuilderStack::ScopedEntry stack_entry = stack_.trace(*obdata_id);
     build_animdata(obdata_id);
   }
   /* type-specific data. */
@@ -1597,7 +1702,7 @@ void DepsgraphRelationBuilder::build_animdata_curves_targets(ID *id,
       add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
       continue;
     }
-    graph_->add_new_relation(
+    add_graph_relation(
         operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     /* It is possible that animation is writing to a nested ID data-block,
      * need to make sure animation is evaluated after target ID is copied. */
@@ -3354,6 +3459,10 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(*id_orig);
+  /* Incremental builds also add relations of IDs which were not rebuilt, avoid duplicates. */
+  const int check_flag = is_incremental_build_ ? RELATION_CHECK_BEFORE_ADD : 0;
+
   OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
   /* XXX: This is a quick hack to make Alt-A to work. */
   // add_relation(time_source_key, copy_on_write_key, "Fluxgate capacitor hack");
@@ -3406,7 +3515,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "CoW Dependency");
+      Relation *rel = add_graph_relation(op_cow, op_entry, "CoW Dependency", check_flag);
       rel->flag |= rel_flag;
     }
     /* All dangling operations should also be executed after copy-on-write. */
@@ -3415,7 +3524,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
+        Relation *rel = add_graph_relation(op_cow, op_node, "CoW Dependency", check_flag);
         rel->flag |= rel_flag;
       }
       else {
@@ -3431,7 +3540,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
+          Relation *rel = add_graph_relation(op_cow, op_node, "CoW Dependency", check_flag);
           rel->flag |= rel_flag;
         }
       }
@@ -3453,8 +3562,10 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
       if (deg_copy_on_write_is_needed(object_data_id)) {
         OperationKey data_copy_on_write_key(
             object_data_id, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+        add_relation(data_copy_on_write_key,
+                     copy_on_write_key,
+                     "Eval Order",
+                     RELATION_FLAG_GODMODE | check_flag);
       }
     }
     else {
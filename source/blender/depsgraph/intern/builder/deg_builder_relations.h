@@ -86,6 +86,15 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   void begin_build();
 
+  /* Update relations of the given objects in the existing graph instead of building them from
+   * scratch. Relations which were added by the builders of the objects are removed, all other IDs
+   * which are in the graph are considered built. Returns false if the relations of the objects
+   * can not be updated in place. See #AbstractBuilderPipeline::build_incremental(). */
+  bool begin_incremental_build(Span<Object *> objects);
+  /* Build relations which are created for all ID nodes once the regular relations are built, for
+   * the IDs affected by the update. Returns false if the graph is to be fully rebuilt. */
+  bool end_incremental_build();
+
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
                          const KeyTo &key_to,
@@ -296,6 +305,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                    const char *description,
                                    int flags = 0);
 
+  /* Add relation to the graph, keeping track of the ID it is added for. */
+  Relation *add_graph_relation(Node *node_from,
+                               Node *node_to,
+                               const char *description,
+                               int flags = 0);
+
   template<typename KeyType>
   DepsNodeHandle create_node_handle(const KeyType &key, const char *default_name = "");
 
@@ -332,6 +347,15 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
   BuilderStack stack_;
+
+  /* State of the incremental build. */
+  bool is_incremental_build_ = false;
+  bool is_incremental_build_failed_ = false;
+  Set<const ID *> incremental_ids_;
+  /* ID nodes which relations were removed from or added to. */
+  Set<IDNode *> incremental_affected_id_nodes_;
+  /* Nodes which had relations to other nodes before the update. */
+  Set<const Node *> incremental_relation_sources_;
 };
 
 struct DepsNodeHandle {
@@ -360,6 +360,13 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
     ComponentKey local_transform_key(&object->id, NodeType::TRANSFORM);
     add_relation(local_transform_key, pose_key, "Local Transforms");
   }
+  /* All bones are evaluated by one operation, which orders them by their parents. */
+  const bool eval_bones_batched = check_pose_can_eval_batched(object);
+  OperationKey pose_eval_bones_key(
+      &object->id, NodeType::EVAL_POSE, OperationCode::POSE_EVAL_BONES);
+  if (eval_bones_batched) {
+    add_relation(pose_init_key, pose_eval_bones_key, "Pose Init -> Pose Bones");
+  }
   /* Links between operations for each bone. */
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
     const BuilderStack::ScopedEntry stack_entry = stack_.trace(*pchan);
@@ -375,10 +382,17 @@ void DepsgraphRelationBuilder::build_rig(Object *object)
     pchan->flag &= ~POSE_DONE;
     /* Pose init to bone local. */
     add_relation(pose_init_key, bone_local_key, "Pose Init - Bone Local", RELATION_FLAG_GODMODE);
-    /* Local to pose parenting operation. */
-    add_relation(bone_local_key, bone_pose_key, "Bone Local - Bone Pose");
+    if (eval_bones_batched) {
+      /* Bone local transforms are inputs of the pose evaluation, the per-bone noops follow it. */
+      add_relation(bone_local_key, pose_eval_bones_key, "Bone Local -> Pose Bones");
+      add_relation(pose_eval_bones_key, bone_pose_key, "Pose Bones -> Bone Pose");
+    }
+    else {
+      /* Local to pose parenting operation. */
+      add_relation(bone_local_key, bone_pose_key, "Bone Local - Bone Pose");
+    }
     /* Parent relation. */
-    if (pchan->parent != nullptr) {
+    if (pchan->parent != nullptr && !eval_bones_batched) {
       OperationCode parent_key_opcode;
       /* NOTE: this difference in handling allows us to prevent lockups
        * while ensuring correct poses for separate chains. */
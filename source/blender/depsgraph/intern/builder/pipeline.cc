@@ -4,10 +4,13 @@
 
 #include "pipeline.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BKE_global.h"
 
+#include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "deg_builder_cycle.h"
@@ -15,6 +18,10 @@
 #include "deg_builder_relations.h"
 #include "deg_builder_transitive.h"
 
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
 namespace blender::deg {
 
 AbstractBuilderPipeline::AbstractBuilderPipeline(::Depsgraph *graph)
@@ -32,16 +39,81 @@ void AbstractBuilderPipeline::build()
     start_time = PIL_check_seconds_timer();
   }
 
+  const char *old_tag_scope = MEM_tag_scope_set("Depsgraph");
   build_step_sanity_check();
   build_step_nodes();
   build_step_relations();
   build_step_finalize();
+  MEM_tag_scope_set(old_tag_scope);
 
   if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
     printf("Depsgraph built in %f seconds.\n", PIL_check_seconds_timer() - start_time);
   }
 }
 
+/* Objects which relations can not be updated in place since other IDs depend on them in ways
+ * which are not described by their own relations. */
+static bool object_supports_incremental_build(const Object *object)
+{
+  /* The light linking is resolved for all emitters at the end of the node build. */
+  if (object->light_linking != nullptr) {
+    return false;
+  }
+  /* Relations of the rigid body world and of the physics systems of other objects depend on
+   * these settings. */
+  if (object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr ||
+      object->pd != nullptr)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool AbstractBuilderPipeline::build_incremental(Span<ID *> ids)
+{
+  Vector<Object *> objects;
+  for (ID *id : ids) {
+    if (GS(id->name) != ID_OB) {
+      return false;
+    }
+    const IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr || id_node->linked_state == DEG_ID_LINKED_VIA_SET) {
+      return false;
+    }
+    Object *object = reinterpret_cast<Object *>(id);
+    if (!object_supports_incremental_build(object)) {
+      return false;
+    }
+    objects.append(object);
+  }
+
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = PIL_check_seconds_timer();
+  }
+
+  const char *old_tag_scope = MEM_tag_scope_set("Depsgraph");
+  const bool success = build_step_incremental(objects);
+  if (success) {
+    build_step_finalize();
+    for (Object *object : objects) {
+      deg_graph_->find_id_node(&object->id)->tag_update(deg_graph_, DEG_UPDATE_SOURCE_RELATIONS);
+    }
+  }
+  MEM_tag_scope_set(old_tag_scope);
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    if (success) {
+      printf("Depsgraph updated in place in %f seconds.\n",
+             PIL_check_seconds_timer() - start_time);
+    }
+    else {
+      printf("Depsgraph can not be updated in place, rebuilding.\n");
+    }
+  }
+  return success;
+}
+
 void AbstractBuilderPipeline::build_step_sanity_check()
 {
   BLI_assert(BLI_findindex(&scene_->view_layers, view_layer_) != -1);
@@ -92,6 +164,49 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->ids_need_update_relations.clear();
+}
+
+bool AbstractBuilderPipeline::build_step_incremental(Span<Object *> objects)
+{
+  /* Tag IDs for update when the builders change their evaluation flags, the same way it happens
+   * for a full build. */
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+  }
+
+  /* Relations are removed first, so that the node builder knows which operations are still used
+   * by other IDs. */
+  unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  if (!relation_builder->begin_incremental_build(objects)) {
+    return false;
+  }
+
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  node_builder->begin_incremental_build(objects);
+  for (Object *object : objects) {
+    node_builder->build_object_incremental(object);
+  }
+  if (!node_builder->end_incremental_build()) {
+    return false;
+  }
+
+  for (Object *object : objects) {
+    relation_builder->build_object(object);
+  }
+  if (!relation_builder->end_incremental_build()) {
+    return false;
+  }
+
+  /* Cycles are detected for the whole graph again, the relations which were removed might have
+   * been part of a cycle. */
+  for (OperationNode *op_node : deg_graph_->operations) {
+    for (Relation *rel : op_node->outlinks) {
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+    }
+  }
+  return true;
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
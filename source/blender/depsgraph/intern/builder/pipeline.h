@@ -13,7 +13,9 @@
 #include "intern/depsgraph_type.h"
 
 struct Depsgraph;
+struct ID;
 struct Main;
+struct Object;
 struct Scene;
 struct ViewLayer;
 
@@ -30,6 +32,10 @@ class DepsgraphRelationBuilder;
  * - build nodes
  * - build relations
  * - finalize
+ *
+ * When only relations of a few objects are to be updated, the existing graph can be updated in
+ * place with #build_incremental() instead. The nodes and relations of the objects are built
+ * again, everything else in the graph is kept as-is.
  */
 class AbstractBuilderPipeline {
  public:
@@ -37,6 +43,9 @@ class AbstractBuilderPipeline {
   virtual ~AbstractBuilderPipeline() = default;
 
   void build();
+  /* Update relations of the given IDs in the existing graph. Returns false if that is not
+   * possible, in which case the graph is to be fully rebuilt with #build(). */
+  bool build_incremental(Span<ID *> ids);
 
  protected:
   Depsgraph *deg_graph_;
@@ -52,6 +61,7 @@ class AbstractBuilderPipeline {
   void build_step_nodes();
   void build_step_relations();
   void build_step_finalize();
+  bool build_step_incremental(Span<Object *> objects);
 
   virtual void build_nodes(DepsgraphNodeBuilder &node_builder) = 0;
   virtual void build_relations(DepsgraphRelationBuilder &relation_builder) = 0;
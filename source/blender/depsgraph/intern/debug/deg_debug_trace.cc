@@ -0,0 +1,219 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+
+#include "PIL_time.h"
+
+#include "BLI_set.hh"
+#include "BLI_threads.h"
+
+#include "DNA_ID.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender::deg {
+namespace {
+
+/* Process id of all events, the trace only ever contains this process. */
+constexpr int trace_pid = 1;
+
+struct TraceFile {
+  std::mutex mutex;
+  FILE *file = nullptr;
+  /* Timestamps in the file are relative to this time. */
+  double start_time = 0.0;
+  bool has_events = false;
+  /* Threads which already got their name written. */
+  Set<int> named_threads;
+};
+
+TraceFile trace_file;
+std::atomic<bool> trace_is_active = false;
+std::atomic<int> trace_threads_num = 0;
+thread_local int trace_thread_index = -1;
+
+void json_escape(std::stringstream &ss, const char *str)
+{
+  for (const char *c = str; *c; c++) {
+    switch (*c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      default:
+        if (uchar(*c) < 0x20) {
+          ss << ' ';
+        }
+        else {
+          ss << *c;
+        }
+        break;
+    }
+  }
+}
+
+/* Timestamps and durations of the trace format are in microseconds. */
+int64_t trace_time_us(const double time)
+{
+  return int64_t(time * 1e6);
+}
+
+void trace_write_event(const std::stringstream &ss)
+{
+  fputs(trace_file.has_events ? ",\n" : "\n", trace_file.file);
+  fputs(ss.str().c_str(), trace_file.file);
+  trace_file.has_events = true;
+}
+
+void trace_write_thread_name(const int thread_index)
+{
+  if (!trace_file.named_threads.add(thread_index)) {
+    return;
+  }
+  std::stringstream ss;
+  ss << R"({"name": "thread_name", "ph": "M", "pid": )" << trace_pid
+     << ", \"tid\": " << thread_index << R"(, "args": {"name": ")";
+  if (thread_index == 0) {
+    ss << "Main";
+  }
+  else {
+    ss << "Worker " << thread_index;
+  }
+  ss << "\"}}";
+  trace_write_event(ss);
+}
+
+void trace_write_operation(const TraceEvent &event, const char *graph_name)
+{
+  const OperationNode *operation = event.operation;
+  const ComponentNode *comp_node = operation->owner;
+  const IDNode *id_node = comp_node->owner;
+
+  std::stringstream ss;
+  ss << "{\"name\": \"";
+  json_escape(ss, operation->identifier().c_str());
+  ss << "\", \"cat\": \"" << nodeTypeAsString(comp_node->type) << "\", \"ph\": \"X\"";
+  ss << ", \"ts\": " << trace_time_us(event.start_time - trace_file.start_time);
+  ss << ", \"dur\": " << trace_time_us(event.duration);
+  ss << ", \"pid\": " << trace_pid << ", \"tid\": " << event.thread_index;
+  ss << ", \"args\": {\"id\": \"";
+  json_escape(ss, id_node->id_orig->name);
+  ss << "\", \"component\": \"";
+  json_escape(ss, comp_node->name.c_str());
+  ss << "\", \"depsgraph\": \"";
+  json_escape(ss, graph_name);
+  ss << "\", \"critical_path_cost\": " << operation->critical_path_cost << "}}";
+  trace_write_event(ss);
+}
+
+}  // namespace
+
+bool deg_debug_trace_is_active()
+{
+  return trace_is_active.load(std::memory_order_relaxed);
+}
+
+int deg_debug_trace_thread_index()
+{
+  if (trace_thread_index == -1) {
+    /* The main thread is always listed first. */
+    trace_thread_index = BLI_thread_is_main() ? 0 : ++trace_threads_num;
+  }
+  return trace_thread_index;
+}
+
+void deg_debug_trace_write_evaluation(const Depsgraph *graph,
+                                      const double start_time,
+                                      const double end_time,
+                                      TraceEvents &events)
+{
+  std::scoped_lock lock(trace_file.mutex);
+  if (trace_file.file == nullptr) {
+    return;
+  }
+
+  const char *graph_name = graph->debug.name.c_str();
+
+  /* Span of the whole evaluation on the thread which requested it. */
+  const int thread_index = deg_debug_trace_thread_index();
+  trace_write_thread_name(thread_index);
+  std::stringstream ss;
+  ss << "{\"name\": \"Depsgraph Evaluation\", \"cat\": \"Depsgraph\", \"ph\": \"X\"";
+  ss << ", \"ts\": " << trace_time_us(start_time - trace_file.start_time);
+  ss << ", \"dur\": " << trace_time_us(end_time - start_time);
+  ss << ", \"pid\": " << trace_pid << ", \"tid\": " << thread_index;
+  ss << ", \"args\": {\"depsgraph\": \"";
+  json_escape(ss, graph_name);
+  ss << "\"}}";
+  trace_write_event(ss);
+
+  for (const Vector<TraceEvent> &thread_events : events) {
+    for (const TraceEvent &event : thread_events) {
+      trace_write_thread_name(event.thread_index);
+      trace_write_operation(event, graph_name);
+    }
+  }
+  fflush(trace_file.file);
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+bool DEG_debug_trace_begin(const char *filepath)
+{
+  std::scoped_lock lock(deg::trace_file.mutex);
+  if (deg::trace_file.file != nullptr) {
+    return false;
+  }
+  FILE *file = fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+  /* JSON array format, every line is one event. */
+  fputs("[", file);
+  deg::trace_file.file = file;
+  deg::trace_file.start_time = PIL_check_seconds_timer();
+  deg::trace_file.has_events = false;
+  deg::trace_file.named_threads.clear();
+  deg::trace_is_active = true;
+  return true;
+}
+
+void DEG_debug_trace_end()
+{
+  std::scoped_lock lock(deg::trace_file.mutex);
+  if (deg::trace_file.file == nullptr) {
+    return;
+  }
+  deg::trace_is_active = false;
+  fputs("\n]\n", deg::trace_file.file);
+  fclose(deg::trace_file.file);
+  deg::trace_file.file = nullptr;
+}
+
+bool DEG_debug_trace_is_active()
+{
+  return deg::deg_debug_trace_is_active();
+}
@@ -0,0 +1,46 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording of evaluation traces in the Chrome trace event format, which can be inspected with
+ * `chrome://tracing` or Perfetto. See #DEG_debug_trace_begin.
+ */
+
+#pragma once
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct OperationNode;
+
+/* Evaluation of a single operation. */
+struct TraceEvent {
+  const OperationNode *operation;
+  double start_time;
+  double duration;
+  int thread_index;
+};
+
+/* Events of one graph evaluation, recorded without synchronization by every thread. */
+using TraceEvents = threading::EnumerableThreadSpecific<Vector<TraceEvent>>;
+
+/* Whether evaluation traces are currently recorded. */
+bool deg_debug_trace_is_active();
+
+/* Small number identifying the calling thread in the trace. */
+int deg_debug_trace_thread_index();
+
+/* Append all events of an evaluation of the graph to the trace file. Has to be called while the
+ * operations of the events still exist. */
+void deg_debug_trace_write_evaluation(const Depsgraph *graph,
+                                      double start_time,
+                                      double end_time,
+                                      TraceEvents &events);
+
+}  // namespace blender::deg
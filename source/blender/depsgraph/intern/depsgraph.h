@@ -20,6 +20,8 @@
 
 #include "DNA_ID.h" /* for ID_Type and INDEX_ID_MAX */
 
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
 #include "BLI_threads.h" /* for SpinLock */
 
 #include "DEG_depsgraph.h"
@@ -95,6 +97,9 @@ struct Depsgraph {
 
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
+  /* IDs whose relations are to be updated in place, without rebuilding the whole graph.
+   * Only used when #need_update_relations is set, empty when the graph is to be fully rebuilt. */
+  VectorSet<ID *> ids_need_update_relations;
 
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
@@ -171,6 +176,10 @@ struct Depsgraph {
 
   light_linking::Cache light_linking_cache;
 
+  /* Per-thread arenas for temporary allocations of the evaluated operations (see
+   * #ScratchAllocator), reset after every evaluation. */
+  threading::EnumerableThreadSpecific<LinearAllocator<>> scratch_arenas;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Depsgraph");
 };
 
@@ -263,6 +263,7 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update_relations = true;
+  deg_graph->ids_need_update_relations.clear();
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
    * re-create flat array of bases in view layer.
@@ -282,6 +283,14 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (!deg_graph->ids_need_update_relations.is_empty()) {
+    deg::ViewLayerBuilderPipeline builder(graph);
+    if (builder.build_incremental(deg_graph->ids_need_update_relations)) {
+      return;
+    }
+    /* Tag the graph the same way as for a regular relations update. */
+    DEG_graph_tag_relations_update(graph);
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
@@ -292,3 +301,23 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_graph_id_tag_relations_update(Depsgraph *graph, ID *id)
+{
+  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  if (deg_graph->need_update_relations && deg_graph->ids_need_update_relations.is_empty()) {
+    /* The whole graph is to be rebuilt already. */
+    return;
+  }
+  deg_graph->need_update_relations = true;
+  deg_graph->ids_need_update_relations.add(id);
+}
+
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    DEG_graph_id_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph), id);
+  }
+}
@@ -10,6 +10,8 @@
 
 #include "MEM_guardedalloc.h"
 
+struct ID;
+
 namespace blender::deg {
 
 struct Node;
@@ -31,6 +33,9 @@ enum RelationFlag {
   RELATION_CHECK_BEFORE_ADD = (1 << 5),
   /* The relation does not participate in visibility checks. */
   RELATION_NO_VISIBILITY_CHANGE = (1 << 6),
+  /* The relation was requested by builders of different IDs, so it can not be re-derived for one
+   * of them alone. */
+  RELATION_FLAG_SHARED_OWNER = (1 << 7),
 };
 
 /* B depends on A (A -> B) */
@@ -48,6 +53,11 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* ID which was being built when the relation was added, null for relations which are not added
+   * on behalf of a specific ID. Used to update relations of an ID without rebuilding the whole
+   * graph. */
+  const ID *owner_id;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
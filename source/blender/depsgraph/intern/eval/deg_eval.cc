@@ -10,15 +10,22 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <memory>
+#include <queue>
+
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
+#include "BLI_scratch_allocator.hh"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
+#include "BKE_idtype.h"
 
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
@@ -33,6 +40,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_tag.h"
@@ -78,12 +86,61 @@ enum class EvaluationStage {
   SINGLE_THREADED_WORKAROUND,
 };
 
+/* Memory kept per thread in the scratch arenas between evaluations. */
+static constexpr int64_t max_retained_scratch_size = 64 * 1024 * 1024;
+
+/* Operations which are ready to be evaluated. The threaded evaluation pushes one task per ready
+ * operation, and each task evaluates the ready operation with the highest critical path cost.
+ * This way long chains of dependent operations are started before independent small ones. */
+struct ReadyOperationsQueue {
+  struct CompareCriticalPathCost {
+    bool operator()(const OperationNode *a, const OperationNode *b) const
+    {
+      return a->critical_path_cost < b->critical_path_cost;
+    }
+  };
+
+  SpinLock lock;
+  std::priority_queue<OperationNode *, std::vector<OperationNode *>, CompareCriticalPathCost>
+      operations;
+
+  ReadyOperationsQueue()
+  {
+    BLI_spin_init(&lock);
+  }
+
+  ~ReadyOperationsQueue()
+  {
+    BLI_spin_end(&lock);
+  }
+
+  void push(OperationNode *node)
+  {
+    BLI_spin_lock(&lock);
+    operations.push(node);
+    BLI_spin_unlock(&lock);
+  }
+
+  OperationNode *pop()
+  {
+    BLI_spin_lock(&lock);
+    BLI_assert(!operations.empty());
+    OperationNode *node = operations.top();
+    operations.pop();
+    BLI_spin_unlock(&lock);
+    return node;
+  }
+};
+
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+  ReadyOperationsQueue ready_operations;
+  /* Only allocated while an evaluation trace is recorded. */
+  TraceEvents *trace_events = nullptr;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -92,14 +149,28 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Attribute allocations to the type of the evaluated ID, see #MEM_use_memory_tags. */
+  const char *old_tag_scope = nullptr;
+  if (UNLIKELY(MEM_memory_tags_enabled())) {
+    old_tag_scope = MEM_tag_scope_set(
+        BKE_idtype_idcode_to_name(operation_node->owner->owner->id_type));
+  }
+  /* Temporary containers of the operation allocate from the arena of the current thread. */
+  ScratchArenaScope scratch_scope(state->graph->scratch_arenas.local());
+  /* Perform operation. The timing is always needed for the scheduling of the next evaluation. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double time = PIL_check_seconds_timer() - start_time;
+  deg_eval_stats_update_cost_estimate(operation_node, time);
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (UNLIKELY(state->trace_events)) {
+    state->trace_events->local().append(
+        {operation_node, start_time, time, deg_debug_trace_thread_index()});
+  }
+  if (UNLIKELY(MEM_memory_tags_enabled())) {
+    MEM_tag_scope_set(old_tag_scope);
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -109,18 +180,25 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
-void deg_task_run_func(TaskPool *pool, void *taskdata)
+void schedule_node_to_pool(DepsgraphEvalState *state, TaskPool *pool, OperationNode *node)
+{
+  state->ready_operations.push(node);
+  BLI_task_pool_push(pool, deg_task_run_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_func(TaskPool *pool, void * /*taskdata*/)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
+  /* Evaluate the most important ready node, which is not necessarily the one that caused this
+   * task to be pushed. */
+  OperationNode *operation_node = state->ready_operations.pop();
   evaluate_node(state, operation_node);
 
   /* Schedule children. */
   schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    schedule_node_to_pool(state, pool, node);
   });
 }
 
@@ -318,9 +396,8 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  schedule_graph(state,
+                 [&](OperationNode *node) { schedule_node_to_pool(state, task_pool, node); });
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -402,6 +479,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
 
+  const double start_time = PIL_check_seconds_timer();
+  std::unique_ptr<TraceEvents> trace_events;
+  if (UNLIKELY(deg_debug_trace_is_active())) {
+    trace_events = std::make_unique<TraceEvents>();
+    state.trace_events = trace_events.get();
+  }
+
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
 
@@ -456,10 +540,25 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     deg_eval_stats_aggregate(graph);
   }
 
+  /* Write the trace while the operations are guaranteed to exist. */
+  if (trace_events) {
+    deg_debug_trace_write_evaluation(
+        graph, start_time, PIL_check_seconds_timer(), *trace_events);
+  }
+
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
 
+  /* Prioritize operations for the next evaluation using the updated cost estimates. */
+  deg_eval_stats_update_critical_path(graph);
+
+  /* All scratch memory of the evaluation can be reused. Keep a limited amount of it, so that the
+   * next update does not have to allocate it again. */
+  for (LinearAllocator<> &arena : graph->scratch_arenas) {
+    arena.reset(max_retained_scratch_size);
+  }
+
 #ifdef WITH_PYTHON
   BPy_END_ALLOW_THREADS;
 #endif
@@ -783,9 +783,10 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
   BLI_assert(check_datablock_expanded(id_cow) == false);
   BLI_assert(id_cow->py_instance == nullptr);
 
-  /* Copy data from original ID to a copied version. */
-  /* TODO(sergey): Avoid doing full ID copy somehow, make Mesh to reference
-   * original geometry arrays for until those are modified. */
+  /* Copy data from original ID to a copied version.
+   *
+   * NOTE: Large arrays like geometry attributes and packed files are not duplicated, they are
+   * shared with the original through implicit sharing and only copied when they are modified. */
   /* TODO(sergey): We do some trickery with temp bmain and extra ID pointer
    * just to be able to use existing API. Ideally we need to replace this with
    * in-place copy from existing datablock to a prepared memory.
@@ -808,11 +809,6 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
       }
       break;
     }
-    case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
-      break;
-    }
     default:
       break;
   }
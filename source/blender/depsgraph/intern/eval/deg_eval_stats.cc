@@ -8,9 +8,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include "BLI_math_base.h"
+#include "BLI_stack.h"
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -39,4 +42,60 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_cost_estimate(OperationNode *op_node, const double time)
+{
+  /* Exponential moving average, follows changes of the scene quickly while smoothing out noise of
+   * individual evaluations. */
+  if (op_node->cost_estimate == 0.0f) {
+    op_node->cost_estimate = float(time);
+  }
+  else {
+    op_node->cost_estimate = 0.75f * op_node->cost_estimate + 0.25f * float(time);
+  }
+}
+
+void deg_eval_stats_update_critical_path(Depsgraph *graph)
+{
+  BLI_assert(!graph->is_evaluating);
+
+  /* Traverse the graph from the operations without children towards the roots, so that the cost
+   * of all children is known when a node is visited. */
+  BLI_Stack *stack = BLI_stack_new(sizeof(OperationNode *), "DEG critical path stack");
+
+  for (OperationNode *op_node : graph->operations) {
+    op_node->critical_path_cost = 0.0f;
+    op_node->num_links_pending = 0;
+    for (Relation *rel : op_node->outlinks) {
+      if ((rel->to->type == NodeType::OPERATION) && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+        ++op_node->num_links_pending;
+      }
+    }
+    if (op_node->num_links_pending == 0) {
+      BLI_stack_push(stack, &op_node);
+    }
+  }
+
+  while (!BLI_stack_is_empty(stack)) {
+    OperationNode *op_node;
+    BLI_stack_pop(stack, &op_node);
+
+    /* All children are done, the maximum of their costs is accumulated already. */
+    op_node->critical_path_cost += op_node->cost_estimate;
+
+    for (Relation *rel : op_node->inlinks) {
+      if ((rel->from->type != NodeType::OPERATION) || (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
+      OperationNode *op_from = reinterpret_cast<OperationNode *>(rel->from);
+      op_from->critical_path_cost = max_ff(op_from->critical_path_cost,
+                                           op_node->critical_path_cost);
+      BLI_assert(op_from->num_links_pending > 0);
+      if (--op_from->num_links_pending == 0) {
+        BLI_stack_push(stack, &op_from);
+      }
+    }
+  }
+  BLI_stack_free(stack);
+}
+
 }  // namespace blender::deg
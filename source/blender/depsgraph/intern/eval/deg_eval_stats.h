@@ -11,8 +11,16 @@
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Update the cost estimate of an operation after it has been evaluated. */
+void deg_eval_stats_update_cost_estimate(OperationNode *op_node, double time);
+
+/* Calculate the critical path cost of all operations from their cost estimates.
+ * Uses the pending links counter of the operations, so it can not run during evaluation. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace blender::deg
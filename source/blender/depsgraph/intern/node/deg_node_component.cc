@@ -279,6 +279,10 @@ OperationNode *ComponentNode::get_exit_operation()
 
 void ComponentNode::finalize_build(Depsgraph * /*graph*/)
 {
+  if (operations_map == nullptr) {
+    /* Not re-opened by an in-place update of the graph, nothing to do. */
+    return;
+  }
   operations.reserve(operations_map->size());
   for (OperationNode *op_node : operations_map->values()) {
     operations.append(op_node);
@@ -287,6 +291,19 @@ void ComponentNode::finalize_build(Depsgraph * /*graph*/)
   operations_map = nullptr;
 }
 
+void ComponentNode::reopen_build()
+{
+  if (operations_map != nullptr) {
+    return;
+  }
+  operations_map = new Map<ComponentNode::OperationIDKey, OperationNode *>();
+  for (OperationNode *op_node : operations) {
+    operations_map->add(OperationIDKey(op_node->opcode, op_node->name.c_str(), op_node->name_tag),
+                        op_node);
+  }
+  operations.clear();
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -109,6 +109,10 @@ struct ComponentNode : public Node {
   virtual OperationNode *get_exit_operation() override;
 
   void finalize_build(Depsgraph *graph);
+  /* Make operations of a finalized component available for lookup and modification by builders
+   * again, used when the graph is updated in place. Does nothing if the component is not
+   * finalized. */
+  void reopen_build();
 
   IDNode *owner;
 
@@ -118,6 +118,8 @@ const char *operationCodeAsString(OperationCode opcode)
       return "POSE_IK_SOLVER";
     case OperationCode::POSE_SPLINE_IK_SOLVER:
       return "POSE_SPLINE_IK_SOLVER";
+    case OperationCode::POSE_EVAL_BONES:
+      return "POSE_EVAL_BONES";
     /* Bone. */
     case OperationCode::BONE_LOCAL:
       return "BONE_LOCAL";
@@ -205,7 +207,10 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0) {}
+OperationNode::OperationNode()
+    : cost_estimate(0.0f), critical_path_cost(0.0f), name_tag(-1), flag(0)
+{
+}
 
 string OperationNode::identifier() const
 {
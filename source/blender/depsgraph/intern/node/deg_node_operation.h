@@ -116,6 +116,9 @@ enum class OperationCode {
   /* IK/Spline Solvers */
   POSE_IK_SOLVER,
   POSE_SPLINE_IK_SOLVER,
+  /* Transforms of all bones, used instead of the per-bone operations when the pose has no
+   * constraints (see #DepsgraphBuilder::check_pose_can_eval_batched). */
+  POSE_EVAL_BONES,
 
   /* Bone. ---------------------------------------------------------------- */
   /* Bone local transforms - entry point */
@@ -275,6 +278,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Evaluation time in seconds, averaged over the previous evaluations of the operation. */
+  float cost_estimate;
+  /* Estimated time it takes to evaluate this operation and the longest chain of operations which
+   * depend on it. Ready operations with the highest cost are scheduled first, so that long chains
+   * start as early as possible. See #deg_eval_stats_update_critical_path. */
+  float critical_path_cost;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -8,6 +8,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <atomic>
 #include <cstdlib>
 
 #include "BLI_dlrbTree.h"
@@ -22,6 +23,7 @@
 #include "BKE_anim_data.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
+#include "BKE_scene_frames.hh"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
@@ -64,10 +66,11 @@ static void motionpaths_calc_update_scene(Depsgraph *depsgraph)
   BKE_scene_graph_update_for_newframe(depsgraph);
 }
 
-Depsgraph *animviz_depsgraph_build(Main *bmain,
-                                   Scene *scene,
-                                   ViewLayer *view_layer,
-                                   ListBase *targets)
+/* Build a depsgraph with only the targets and their dependencies, without evaluating it. */
+static Depsgraph *motionpaths_depsgraph_build_no_update(Main *bmain,
+                                                        Scene *scene,
+                                                        ViewLayer *view_layer,
+                                                        ListBase *targets)
 {
   /* Allocate dependency graph. */
   Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
@@ -86,6 +89,16 @@ Depsgraph *animviz_depsgraph_build(Main *bmain,
   DEG_graph_build_from_ids(depsgraph, ids, num_ids);
   MEM_freeN(ids);
 
+  return depsgraph;
+}
+
+Depsgraph *animviz_depsgraph_build(Main *bmain,
+                                   Scene *scene,
+                                   ViewLayer *view_layer,
+                                   ListBase *targets)
+{
+  Depsgraph *depsgraph = motionpaths_depsgraph_build_no_update(bmain, scene, view_layer, targets);
+
   /* Update once so we can access pointers of evaluated animation data. */
   motionpaths_calc_update_scene(depsgraph);
   return depsgraph;
@@ -126,8 +139,45 @@ void animviz_get_object_motionpaths(Object *ob, ListBase *targets)
 
 /* ........ */
 
+/* Get the motion path of the evaluated copy of the target. */
+static bMotionPath *motionpath_evaluated_get(const MPathTarget *mpt,
+                                             Object *ob_eval,
+                                             bPoseChannel *pchan_eval)
+{
+  if (mpt->pchan) {
+    return (pchan_eval) ? pchan_eval->mpath : nullptr;
+  }
+  return ob_eval->mpath;
+}
+
+/* Incremental update on evaluated object if possible, for fast updating
+ * while dragging in transform. */
+static void motionpath_update_evaluated(const bMotionPath *mpath,
+                                        bMotionPath *mpath_eval,
+                                        const int sfra,
+                                        const int efra)
+{
+  if (mpath_eval == nullptr || mpath_eval->length != mpath->length) {
+    return;
+  }
+
+  const int update_sfra = max_ii(sfra, mpath->start_frame);
+  const int update_efra = min_ii(efra, mpath->end_frame - 1);
+  for (int cframe = update_sfra; cframe <= update_efra; cframe++) {
+    bMotionPathVert *mpv_eval = mpath_eval->points + (cframe - mpath_eval->start_frame);
+    *mpv_eval = mpath->points[cframe - mpath->start_frame];
+  }
+
+  GPU_VERTBUF_DISCARD_SAFE(mpath_eval->points_vbo);
+  GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_line);
+  GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_points);
+}
+
 /* perform baking for the targets on the current frame */
-static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
+static void motionpaths_calc_bake_targets(ListBase *targets,
+                                          Depsgraph *depsgraph,
+                                          int cframe,
+                                          const bool update_evaluated)
 {
   /* for each target, check if it can be baked on the current frame */
   LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
@@ -143,7 +193,9 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
     /* get the relevant cache vert to write to */
     bMotionPathVert *mpv = mpath->points + (cframe - mpath->start_frame);
 
-    Object *ob_eval = mpt->ob_eval;
+    /* Lookup evaluated object from the given depsgraph, as frames might be evaluated on other
+     * depsgraphs than the one of #MPathTarget.ob_eval. */
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, mpt->ob);
 
     /* Lookup evaluated pose channel, here because the depsgraph
      * evaluation can change them so they are not cached in mpt. */
@@ -180,24 +232,28 @@ static void motionpaths_calc_bake_targets(ListBase *targets, int cframe)
       mpv->flag &= ~MOTIONPATH_VERT_KEY;
     }
 
-    /* Incremental update on evaluated object if possible, for fast updating
-     * while dragging in transform. */
-    bMotionPath *mpath_eval = nullptr;
-    if (mpt->pchan) {
-      mpath_eval = (pchan_eval) ? pchan_eval->mpath : nullptr;
-    }
-    else {
-      mpath_eval = ob_eval->mpath;
+    if (update_evaluated) {
+      motionpath_update_evaluated(
+          mpath, motionpath_evaluated_get(mpt, ob_eval, pchan_eval), cframe, cframe);
     }
+  }
+}
 
-    if (mpath_eval && mpath_eval->length == mpath->length) {
-      bMotionPathVert *mpv_eval = mpath_eval->points + (cframe - mpath_eval->start_frame);
-      *mpv_eval = *mpv;
-
-      GPU_VERTBUF_DISCARD_SAFE(mpath_eval->points_vbo);
-      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_line);
-      GPU_BATCH_DISCARD_SAFE(mpath_eval->batch_points);
+/* Update the evaluated copies of the targets in the depsgraph after baking frames on other
+ * depsgraphs. */
+static void motionpaths_calc_update_evaluated(ListBase *targets,
+                                              Depsgraph *depsgraph,
+                                              const int sfra,
+                                              const int efra)
+{
+  LISTBASE_FOREACH (MPathTarget *, mpt, targets) {
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, mpt->ob);
+    bPoseChannel *pchan_eval = nullptr;
+    if (mpt->pchan) {
+      pchan_eval = BKE_pose_channel_find_name(ob_eval->pose, mpt->pchan->name);
     }
+    motionpath_update_evaluated(
+        mpt->mpath, motionpath_evaluated_get(mpt, ob_eval, pchan_eval), sfra, efra);
   }
 }
 
@@ -492,18 +548,32 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
-  for (scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
-    if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
-      /* For current frame, only update tagged. */
-      BKE_scene_graph_update_tagged(depsgraph, bmain);
-    }
-    else {
-      /* Update relevant data for new frame. */
-      motionpaths_calc_update_scene(depsgraph);
+  if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
+    /* For current frame, only update tagged. */
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+    motionpaths_calc_bake_targets(targets, depsgraph, cfra, true);
+  }
+  else {
+    /* Frames are evaluated in parallel on separate depsgraphs when possible, these only contain
+     * the targets. */
+    ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+    std::atomic<bool> used_other_depsgraphs = false;
+    blender::bke::scene_graph_evaluate_frames(
+        depsgraph,
+        blender::IndexRange(sfra, efra - sfra + 1),
+        [&]() {
+          return motionpaths_depsgraph_build_no_update(bmain, scene, view_layer, targets);
+        },
+        [&](Depsgraph *frame_depsgraph, const int frame) {
+          const bool is_own_depsgraph = frame_depsgraph == depsgraph;
+          if (!is_own_depsgraph) {
+            used_other_depsgraphs = true;
+          }
+          motionpaths_calc_bake_targets(targets, frame_depsgraph, frame, is_own_depsgraph);
+        });
+    if (used_other_depsgraphs) {
+      motionpaths_calc_update_evaluated(targets, depsgraph, sfra, efra);
     }
-
-    /* perform baking for targets */
-    motionpaths_calc_bake_targets(targets, scene->r.cfra);
   }
 
   /* reset original environment */
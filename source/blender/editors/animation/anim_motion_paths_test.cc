@@ -0,0 +1,145 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "tests/scene_test_base.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_vector.hh"
+
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_action.h"
+#include "BKE_anim_data.h"
+#include "BKE_anim_visualization.h"
+#include "BKE_callbacks.h"
+#include "BKE_fcurve.h"
+
+#include "DEG_depsgraph.h"
+
+#include "ED_anim_api.hh"
+
+namespace blender::editor::animation::tests {
+
+static void frame_change_handler_noop(Main * /*bmain*/,
+                                      PointerRNA ** /*pointers*/,
+                                      const int /*pointers_num*/,
+                                      void * /*arg*/)
+{
+}
+
+class MotionPathsTest : public SceneTestBase {
+ public:
+  static void SetUpTestCase()
+  {
+    SceneTestBase::SetUpTestCase();
+    BLI_task_scheduler_init();
+  }
+
+  static void TearDownTestCase()
+  {
+    BLI_task_scheduler_exit();
+    SceneTestBase::TearDownTestCase();
+  }
+
+ protected:
+  /* Animate a property with keys at the given frames, with the default Bezier interpolation. */
+  void add_fcurve(Object *object,
+                  const char *rna_path,
+                  const int array_index,
+                  const Span<float2> keys)
+  {
+    AnimData *adt = BKE_animdata_ensure_id(&object->id);
+    if (adt->action == nullptr) {
+      adt->action = BKE_action_add(bmain, "Action");
+    }
+    FCurve *fcu = BKE_fcurve_create();
+    fcu->rna_path = BLI_strdup(rna_path);
+    fcu->array_index = array_index;
+    fcu->totvert = int(keys.size());
+    fcu->bezt = static_cast<BezTriple *>(
+        MEM_callocN(sizeof(BezTriple) * fcu->totvert, "BezTriples"));
+    for (const int i : keys.index_range()) {
+      BezTriple &bezt = fcu->bezt[i];
+      copy_v2_v2(bezt.vec[1], keys[i]);
+      bezt.ipo = BEZT_IPO_BEZ;
+      bezt.h1 = bezt.h2 = HD_AUTO_ANIM;
+    }
+    BKE_fcurve_handles_recalc(fcu);
+    BLI_addtail(&adt->action->curves, fcu);
+  }
+
+  /* Calculate the motion path of the object like the operator does, and return its points. */
+  Vector<float3> calc_motion_path(Object *object)
+  {
+    object->avs.recalc |= ANIMVIZ_RECALC_PATHS;
+    ListBase targets = {nullptr, nullptr};
+    animviz_get_object_motionpaths(object, &targets);
+    Depsgraph *depsgraph = animviz_depsgraph_build(bmain, scene, view_layer, &targets);
+    animviz_calc_motionpaths(depsgraph, bmain, scene, &targets, ANIMVIZ_CALC_RANGE_FULL, true);
+    BLI_freelistN(&targets);
+    DEG_graph_free(depsgraph);
+
+    Vector<float3> points;
+    for (const int i : IndexRange(object->mpath->length)) {
+      points.append(float3(object->mpath->points[i].co));
+    }
+    return points;
+  }
+};
+
+TEST_F(MotionPathsTest, ParallelMatchesSequential)
+{
+  if (BLI_task_scheduler_num_threads() < 2) {
+    GTEST_SKIP() << "Frames are only evaluated in parallel with multiple threads";
+  }
+
+  /* A child of an animated object, which is animated itself. */
+  Object *parent = add_object(OB_EMPTY, "Parent");
+  Object *child = add_object(OB_EMPTY, "Child");
+  child->parent = parent;
+  child->loc[1] = 2.0f;
+  add_fcurve(parent, "location", 0, {{1.0f, 0.0f}, {30.0f, 5.0f}, {60.0f, -3.0f}});
+  add_fcurve(parent, "location", 2, {{1.0f, 1.0f}, {45.0f, 4.0f}});
+  add_fcurve(parent, "rotation_euler", 2, {{10.0f, 0.0f}, {50.0f, 3.0f}});
+  add_fcurve(child, "location", 0, {{1.0f, 0.0f}, {20.0f, 1.0f}, {40.0f, 0.0f}});
+
+  child->avs.path_type = MOTIONPATH_TYPE_RANGE;
+  child->avs.path_sf = 1;
+  child->avs.path_ef = 61;
+  ASSERT_NE(animviz_verify_motionpaths(nullptr, scene, child, nullptr), nullptr);
+  child->avs.path_bakeflag |= MOTIONPATH_BAKE_HAS_PATHS;
+
+  const int cfra = scene->r.cfra;
+  const Vector<float3> points_parallel = calc_motion_path(child);
+
+  /* A frame change handler may modify the scene, so frames are evaluated in order on a single
+   * depsgraph when one is registered. */
+  bCallbackFuncStore funcstore = {nullptr};
+  funcstore.func = frame_change_handler_noop;
+  BKE_callback_add(&funcstore, BKE_CB_EVT_FRAME_CHANGE_PRE);
+  const Vector<float3> points_sequential = calc_motion_path(child);
+  BKE_callback_remove(&funcstore, BKE_CB_EVT_FRAME_CHANGE_PRE);
+
+  EXPECT_EQ(scene->r.cfra, cfra);
+  ASSERT_EQ(points_parallel.size(), 60);
+  ASSERT_EQ(points_parallel.size(), points_sequential.size());
+  for (const int i : points_parallel.index_range()) {
+    EXPECT_FLOAT_EQ(points_parallel[i].x, points_sequential[i].x) << "frame " << i + 1;
+    EXPECT_FLOAT_EQ(points_parallel[i].y, points_sequential[i].y) << "frame " << i + 1;
+    EXPECT_FLOAT_EQ(points_parallel[i].z, points_sequential[i].z) << "frame " << i + 1;
+  }
+  /* The path is animated, not a single point. */
+  EXPECT_NE(points_parallel.first(), points_parallel.last());
+}
+
+}  // namespace blender::editor::animation::tests
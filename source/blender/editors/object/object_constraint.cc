@@ -2439,8 +2439,14 @@ static int constraint_add_exec(
     BKE_pose_update_constraint_flags(ob->pose);
   }
 
-  /* force depsgraph to get recalculated since new relationships added */
-  DEG_relations_tag_update(bmain);
+  /* Force depsgraph to get recalculated since new relationships added. A constraint of an object
+   * without new targets only affects the relations of the object itself. */
+  if (pchan == nullptr && !setTarget) {
+    DEG_id_relations_tag_update(bmain, &ob->id);
+  }
+  else {
+    DEG_relations_tag_update(bmain);
+  }
 
   if ((ob->type == OB_ARMATURE) && (pchan)) {
     BKE_pose_tag_recalc(bmain, ob->pose); /* sort pose channels */
@@ -642,6 +642,14 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe at the start of the segment found by the last evaluation, where the
+   * search starts for the next one. Only a hint for sequential evaluation, validated before use.
+   * Runtime data, cleared when writing and reading files.
+   */
+  int segment_hint;
+  char _pad1[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -1137,6 +1145,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, NLA evaluation channels kept between frames, see #animsys_calculate_nla. */
+  struct NlaEvalData *nla_eval_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
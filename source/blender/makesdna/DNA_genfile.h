@@ -107,6 +107,11 @@ int DNA_struct_find_nr(const struct SDNA *sdna, const char *str);
  * \param data: Struct data that is to be converted
  */
 void DNA_struct_switch_endian(const struct SDNA *sdna, int struct_nr, char *data);
+/**
+ * Whether the struct or any struct embedded in it has pointer members, which have to be remapped
+ * when the struct is read.
+ */
+bool DNA_struct_has_pointers(const struct SDNA *sdna, int struct_nr);
 /**
  * Constructs and returns an array of byte flags with one element for each struct in oldsdna,
  * indicating how it compares to newsdna.
@@ -8,8 +8,16 @@
 
 #pragma once
 
+#include "BLI_implicit_sharing.h"
+
 typedef struct PackedFile {
   int size;
   int seek;
-  void *data;
+  /** The file contents, never modified after the packed file is created. */
+  const void *data;
+  /**
+   * Run-time data that allows sharing `data` with copies of the packed file, e.g. in evaluated
+   * copies of data-blocks and undo steps.
+   */
+  const ImplicitSharingInfoHandle *sharing_info;
 } PackedFile;
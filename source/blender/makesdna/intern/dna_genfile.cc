@@ -162,6 +162,22 @@ static bool ispointer(const char *name)
   return (name[0] == '*' || (name[0] == '(' && name[1] == '*'));
 }
 
+bool DNA_struct_has_pointers(const SDNA *sdna, const int struct_nr)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  for (int a = 0; a < struct_info->members_len; a++) {
+    const SDNA_StructMember *member = &struct_info->members[a];
+    if (ispointer(sdna->names[member->name])) {
+      return true;
+    }
+    const int member_struct_nr = DNA_struct_find_nr(sdna, sdna->types[member->type]);
+    if (member_struct_nr >= 0 && DNA_struct_has_pointers(sdna, member_struct_nr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 int DNA_elem_size_nr(const SDNA *sdna, short type, short name)
 {
   const char *cp = sdna->names[name];
@@ -271,6 +271,18 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_trace_begin(ReportList *reports, const char *filepath)
+{
+  if (!DEG_debug_trace_begin(filepath)) {
+    BKE_reportf(reports, RPT_ERROR, "Unable to start a trace in file '%s'", filepath);
+  }
+}
+
+static void rna_Depsgraph_debug_trace_end()
+{
+  DEG_debug_trace_end();
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -719,6 +731,20 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_trace_begin", "rna_Depsgraph_debug_trace_begin");
+  RNA_def_function_ui_description(
+      func,
+      "Start recording the evaluation of all dependency graphs into a file in the Chrome trace "
+      "format, which can be opened with 'chrome://tracing' or Perfetto");
+  RNA_def_function_flag(func, FUNC_NO_SELF | FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filepath", nullptr, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+
+  func = RNA_def_function(srna, "debug_trace_end", "rna_Depsgraph_debug_trace_end");
+  RNA_def_function_ui_description(func, "Stop recording the evaluation trace");
+  RNA_def_function_flag(func, FUNC_NO_SELF);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
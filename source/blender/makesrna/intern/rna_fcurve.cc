@@ -2126,6 +2126,7 @@ static void rna_def_channeldriver(BlenderRNA *brna)
       "Use Self",
       "Include a 'self' variable in the name-space, "
       "so drivers can easily reference the data being modified (object, bone, etc...)");
+  RNA_def_property_update(prop, 0, "rna_ChannelDriver_update_expr");
 
   /* State Info (for Debugging) */
   prop = RNA_def_property(srna, "is_valid", PROP_BOOLEAN, PROP_NONE);
@@ -196,7 +196,13 @@ static void rna_Mesh_update_geom_and_params(Main * /*bmain*/, Scene * /*scene*/,
 
 static void rna_Mesh_update_data_edit_weight(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
-  BKE_mesh_batch_cache_dirty_tag(rna_mesh(ptr), BKE_MESH_BATCH_DIRTY_ALL);
+  /* Also used for the weights of lattice points. */
+  if (GS(ptr->owner_id->name) == ID_ME) {
+    Mesh *me = rna_mesh(ptr);
+    /* The weights are written in place, without #BKE_mesh_deform_verts_for_write. */
+    me->runtime->vertex_group_weights_cache.tag_dirty();
+    BKE_mesh_batch_cache_dirty_tag(me, BKE_MESH_BATCH_DIRTY_ALL);
+  }
 
   rna_Mesh_update_data_legacy_deg_tag_all(bmain, scene, ptr);
 }
@@ -35,6 +35,7 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "BLI_map.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
@@ -559,6 +560,91 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+enum {
+  MEMORY_TAGS_GROUP_NAME = 0,
+  MEMORY_TAGS_GROUP_PREFIX,
+  MEMORY_TAGS_GROUP_SCOPE,
+};
+
+PyDoc_STRVAR(bpy_app_memory_tags_doc,
+             ".. staticmethod:: memory_tags(group='PREFIX')\n"
+             "\n"
+             "   Return the memory usage attributed to allocation names or tag scopes, "
+             "only available when Blender was started with ``--debug-memory-tags``.\n"
+             "\n"
+             "   :arg group: How to group the allocations, "
+             "'NAME' for the full allocation name, 'PREFIX' for the first word of the name "
+             "or 'SCOPE' for the data-block type or subsystem that made the allocation.\n"
+             "   :type group: str\n"
+             "   :return: Dictionary mapping the group names to tuples of "
+             "(bytes in use, blocks in use, total allocations, total allocated bytes), "
+             "totals are accumulated since the tags were enabled.\n"
+             "   :rtype: dict\n");
+static PyObject *bpy_app_memory_tags(PyObject * /*self*/, PyObject *args, PyObject *kwds)
+{
+  const PyC_StringEnumItems group_items[] = {
+      {MEMORY_TAGS_GROUP_NAME, "NAME"},
+      {MEMORY_TAGS_GROUP_PREFIX, "PREFIX"},
+      {MEMORY_TAGS_GROUP_SCOPE, "SCOPE"},
+      {0, nullptr},
+  };
+  PyC_StringEnum group = {group_items, MEMORY_TAGS_GROUP_PREFIX};
+
+  static const char *_keywords[] = {"group", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `group` */
+      ":memory_tags",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseStringEnum, &group)) {
+    return nullptr;
+  }
+
+  struct GroupData {
+    int group;
+    blender::Map<std::string, MEM_TagStats> stats;
+  } data = {group.value_found};
+
+  MEM_memory_tags_foreach(
+      [](const MEM_TagStats *stats, void *user_data) {
+        GroupData &data = *static_cast<GroupData *>(user_data);
+        std::string key;
+        switch (data.group) {
+          case MEMORY_TAGS_GROUP_NAME:
+            key = stats->name;
+            break;
+          case MEMORY_TAGS_GROUP_PREFIX:
+            key = std::string(stats->name, MEM_memory_tag_prefix_len(stats->name));
+            break;
+          case MEMORY_TAGS_GROUP_SCOPE:
+            key = stats->scope ? stats->scope : "";
+            break;
+        }
+        MEM_TagStats &values = data.stats.lookup_or_add(key, {});
+        values.mem_in_use += stats->mem_in_use;
+        values.blocks_in_use += stats->blocks_in_use;
+        values.alloc_num += stats->alloc_num;
+        values.alloc_bytes += stats->alloc_bytes;
+      },
+      &data);
+
+  PyObject *result = PyDict_New();
+  for (const auto item : data.stats.items()) {
+    PyObject *value = PyTuple_New(4);
+    PyTuple_SET_ITEMS(value,
+                      PyLong_FromSize_t(item.value.mem_in_use),
+                      PyLong_FromSize_t(item.value.blocks_in_use),
+                      PyLong_FromSize_t(item.value.alloc_num),
+                      PyLong_FromSize_t(item.value.alloc_bytes));
+    PyDict_SetItemString(result, item.key.c_str(), value);
+    Py_DECREF(value);
+  }
+  return result;
+}
+
 #if (defined(__GNUC__) && !defined(__clang__))
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
@@ -573,6 +659,10 @@ static PyMethodDef bpy_app_methods[] = {
      (PyCFunction)bpy_app_help_text,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_help_text_doc},
+    {"memory_tags",
+     (PyCFunction)bpy_app_memory_tags,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_memory_tags_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
@@ -30,6 +30,7 @@ void bpy_app_generic_callback(Main *main,
                               PointerRNA **pointers,
                               const int pointers_num,
                               void *arg);
+static bool bpy_app_generic_callback_poll(void *arg);
 
 static PyTypeObject BlenderAppCbType;
 
@@ -275,6 +276,7 @@ PyObject *BPY_app_handlers_struct()
     for (pos = 0; pos < BKE_CB_EVT_TOT; pos++) {
       funcstore = &funcstore_array[pos];
       funcstore->func = bpy_app_generic_callback;
+      funcstore->poll = bpy_app_generic_callback_poll;
       funcstore->alloc = 0;
       funcstore->arg = POINTER_FROM_INT(pos);
       BKE_callback_add(funcstore, eCbEvent(pos));
@@ -348,6 +350,16 @@ static PyObject *choose_arguments(PyObject *func, PyObject *args_all, PyObject *
   return args_all;
 }
 
+static bool bpy_app_generic_callback_poll(void *arg)
+{
+  /* May be called from any thread, the list can be modified by scripts at the same time. */
+  const PyGILState_STATE gilstate = PyGILState_Ensure();
+  PyObject *cb_list = py_cb_array[POINTER_AS_INT(arg)];
+  const bool is_used = PyList_GET_SIZE(cb_list) > 0;
+  PyGILState_Release(gilstate);
+  return is_used;
+}
+
 /* the actual callback - not necessarily called from py */
 void bpy_app_generic_callback(Main * /*main*/,
                               PointerRNA **pointers,
@@ -121,6 +121,7 @@
 #include "COM_compositor.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
 #include "DRW_engine.h"
@@ -500,6 +501,12 @@ void WM_exit_ex(bContext *C, const bool do_python, const bool do_user_exit_actio
    * Saving #BLENDER_QUIT_FILE is also not likely to be desired either. */
   BLI_assert(G.background ? (do_user_exit_actions == false) : true);
 
+  /* Print while all data is still alive. */
+  if (MEM_memory_tags_enabled()) {
+    MEM_memory_tags_print();
+  }
+  DEG_debug_trace_end();
+
   /* first wrap up running stuff, we assume only the active WM is running */
   /* modal handlers are on window level freed, others too? */
   /* NOTE: same code copied in `wm_files.cc`. */
@@ -29,6 +29,7 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task_statistics.hh"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
@@ -649,6 +650,7 @@ static void print_help(bArgs *ba, bool all)
     BLI_args_print_arg_doc(ba, "--debug-cycles");
   }
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-memory-tags");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -659,6 +661,9 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uuid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-trace");
+  BLI_args_print_arg_doc(ba, "--debug-parallel-for");
+  BLI_args_print_arg_doc(ba, "--debug-parallel-for-adaptive");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
@@ -894,6 +899,28 @@ static int arg_handle_debug_exit_on_error(int /*argc*/, const char ** /*argv*/,
   return 0;
 }
 
+static const char arg_handle_debug_parallel_for_doc[] =
+    "\n\t"
+    "Record statistics about the work distribution of parallel loops for each call site,\n"
+    "\tprinted on exit.";
+static int arg_handle_debug_parallel_for(int /*argc*/, const char ** /*argv*/, void * /*data*/)
+{
+  blender::threading::statistics::enable(true);
+  return 0;
+}
+
+static const char arg_handle_debug_parallel_for_adaptive_doc[] =
+    "\n\t"
+    "Choose the grain size of parallel loops from their measured cost per item,\n"
+    "\tinstead of using the grain size of the call site.";
+static int arg_handle_debug_parallel_for_adaptive(int /*argc*/,
+                                                  const char ** /*argv*/,
+                                                  void * /*data*/)
+{
+  blender::threading::statistics::use_adaptive_grain_size(true);
+  return 0;
+}
+
 static const char arg_handle_background_mode_set_doc[] =
     "\n\t"
     "Run in background (often used for UI-less rendering).";
@@ -1178,6 +1205,35 @@ static int arg_handle_debug_mode_memory_set(int /*argc*/, const char ** /*argv*/
   return 0;
 }
 
+static const char arg_handle_debug_mode_memory_tags_set_doc[] =
+    "\n\t"
+    "Enable memory tags, which attribute memory usage to allocation names and data-block types.\n"
+    "\tThe usage is printed on exit and available from Python with 'bpy.app.memory_tags()'.";
+static int arg_handle_debug_mode_memory_tags_set(int /*argc*/,
+                                                 const char ** /*argv*/,
+                                                 void * /*data*/)
+{
+  MEM_use_memory_tags(true);
+  return 0;
+}
+
+static const char arg_handle_debug_depsgraph_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the evaluation of all dependency graphs into a file in the Chrome trace format,\n"
+    "\twhich can be opened with 'chrome://tracing' or Perfetto.";
+static int arg_handle_debug_depsgraph_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-depsgraph-trace";
+  if (argc > 1) {
+    if (!DEG_debug_trace_begin(argv[1])) {
+      fprintf(stderr, "\nError: unable to write to file '%s %s'.\n", arg_id, argv[1]);
+    }
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2421,6 +2477,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
     BLI_args_add(ba, nullptr, "--debug-cycles", CB(arg_handle_debug_mode_cycles), nullptr);
   }
   BLI_args_add(ba, nullptr, "--debug-memory", CB(arg_handle_debug_mode_memory_set), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--debug-memory-tags", CB(arg_handle_debug_mode_memory_tags_set), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-value", CB(arg_handle_debug_value_set), nullptr);
   BLI_args_add(ba,
@@ -2475,6 +2533,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uuid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uuid),
                (void *)G_DEBUG_DEPSGRAPH_UUID);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-trace",
+               CB(arg_handle_debug_depsgraph_trace_set),
+               nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",
@@ -2486,6 +2549,12 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                CB_EX(arg_handle_debug_mode_generic_set, gpu_disable_ssbo),
                (void *)G_DEBUG_GPU_FORCE_DISABLE_SSBO);
   BLI_args_add(ba, nullptr, "--debug-exit-on-error", CB(arg_handle_debug_exit_on_error), nullptr);
+  BLI_args_add(ba, nullptr, "--debug-parallel-for", CB(arg_handle_debug_parallel_for), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-parallel-for-adaptive",
+               CB(arg_handle_debug_parallel_for_adaptive),
+               nullptr);
 
   BLI_args_add(ba, nullptr, "--verbose", CB(arg_handle_verbosity_set), nullptr);
 
@@ -3,7 +3,7 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from .environment import TestEnvironment
-from .device import TestDevice, TestMachine
+from .device import CPU_KERNELS, TestDevice, TestMachine
 from .config import TestEntry, TestQueue, TestConfig
 from .test import Test, TestCollection
 from .graph import TestGraph
@@ -6,6 +6,9 @@ import platform
 import subprocess
 from typing import List
 
+# Instruction sets of the Cycles CPU kernels, from the most to the least recent.
+CPU_KERNELS = ['AVX512', 'AVX2', 'SSE41', 'SSE2']
+
 
 def get_cpu_name() -> str:
     # Get full CPU name.
@@ -56,7 +59,15 @@ class TestMachine:
     def __init__(self, env, need_gpus: bool):
         operating_system = platform.system()
 
-        self.devices = [TestDevice('CPU', 'CPU', get_cpu_name(), operating_system)]
+        cpu_name = get_cpu_name()
+        self.devices = [TestDevice('CPU', 'CPU', cpu_name, operating_system)]
+
+        # The CPU limited to the kernel of a specific instruction set, for comparing the kernel
+        # variants on the same machine. These are only used when listed in the configuration,
+        # for example `devices = ['CPU', 'CPU_AVX2']`.
+        for cpu_kernel in CPU_KERNELS:
+            self.devices.append(TestDevice('CPU', 'CPU_' + cpu_kernel,
+                                           cpu_name + ' (' + cpu_kernel + ')', operating_system))
         self.has_gpus = need_gpus
 
         if need_gpus and env.blender_executable:
@@ -11,12 +11,15 @@ def _run(filepath):
 
     # Load once to ensure it's cached by OS
     bpy.ops.wm.open_mainfile(filepath=filepath)
-    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
 
-    # Measure loading the second time
-    start_time = time.time()
-    bpy.ops.wm.open_mainfile(filepath=filepath)
-    elapsed_time = time.time() - start_time
+    # Measure loading a few more times, keeping the best time to reduce the noise
+    # from other processes, so that smaller differences in reading speed are visible.
+    elapsed_time = float('inf')
+    for _ in range(3):
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        start_time = time.time()
+        bpy.ops.wm.open_mainfile(filepath=filepath)
+        elapsed_time = min(elapsed_time, time.time() - start_time)
 
     result = {'time': elapsed_time}
     return result
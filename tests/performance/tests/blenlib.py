@@ -0,0 +1,59 @@
+# SPDX-FileCopyrightText: 2023 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import json
+import os
+import pathlib
+import tempfile
+
+
+class BlenlibBenchmarkTest(api.Test):
+    """
+    Micro-benchmarks from `source/blender/blenlib/tests/performance`. These are GTest executables
+    built with `WITH_GTESTS`, which write their results to the JSON file given in the
+    `BLENDER_BENCHMARK_JSON` environment variable. Every benchmark is reported as a separate output
+    so they each get their own chart.
+    """
+
+    def __init__(self, executable_name):
+        self.executable_name = executable_name
+
+    def name(self):
+        return self.executable_name
+
+    def category(self):
+        return "blenlib"
+
+    def _find_executable(self, env):
+        executable = self.executable_name + '_test'
+        if os.name == 'nt':
+            executable += '.exe'
+        search_dirs = [
+            pathlib.Path(env.blender_executable).parent / 'tests',
+            env.build_dir / 'bin' / 'tests',
+        ]
+        for search_dir in search_dirs:
+            filepath = search_dir / executable
+            if filepath.is_file():
+                return filepath
+        return None
+
+    def run(self, env, device_id):
+        executable = self._find_executable(env)
+        if not executable:
+            return {}
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            json_filepath = pathlib.Path(tmpdir) / 'benchmark.json'
+            env.call([executable], cwd=env.base_dir,
+                     environment={'BLENDER_BENCHMARK_JSON': str(json_filepath)})
+            with open(json_filepath) as json_file:
+                data = json.load(json_file)
+
+        return {benchmark['name']: benchmark['time'] for benchmark in data['benchmarks']}
+
+
+def generate(env):
+    return [BlenlibBenchmarkTest(name) for name in ('BLI_container_performance', 'BLI_math_performance')]
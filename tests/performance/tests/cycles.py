@@ -7,10 +7,16 @@ import api
 
 def _run(args):
     import bpy
+    import os
 
     device_type = args['device_type']
     device_index = args['device_index']
 
+    # Disable the instruction sets of all better kernels, debug flags are read from the
+    # environment when the render starts.
+    for instruction_set in args['disabled_cpu_kernels']:
+        os.environ['CYCLES_CPU_NO_' + instruction_set] = '1'
+
     scene = bpy.context.scene
     scene.render.engine = 'CYCLES'
     scene.render.filepath = args['render_filepath']
@@ -67,9 +73,17 @@ class CyclesTest(api.Test):
     def run(self, env, device_id):
         tokens = device_id.split('_')
         device_type = tokens[0]
-        device_index = int(tokens[1]) if len(tokens) > 1 else 0
+        device_index = 0
+        disabled_cpu_kernels = []
+        if device_type == 'CPU':
+            # CPU device limited to a specific kernel, like CPU_AVX2.
+            if len(tokens) > 1:
+                disabled_cpu_kernels = api.CPU_KERNELS[:api.CPU_KERNELS.index(tokens[1])]
+        elif len(tokens) > 1:
+            device_index = int(tokens[1])
         args = {'device_type': device_type,
                 'device_index': device_index,
+                'disabled_cpu_kernels': disabled_cpu_kernels,
                 'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
 
         _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '2', self.filepath])